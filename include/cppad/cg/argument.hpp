@@ -31,47 +31,53 @@ template<class Base>
 class Argument {
 private:
     OperationNode<Base>* operation_;
-    std::unique_ptr<Base> parameter_;
+    /**
+     * The constant value (stored inline to avoid heap allocations since
+     * arguments are created very often)
+     */
+    Base parameter_;
+    /**
+     * Whether or not this argument is a constant value
+     */
+    bool isParameter_;
 public:
 
     inline Argument() :
-        operation_(nullptr) {
+        operation_(nullptr),
+        parameter_(),
+        isParameter_(false) {
     }
 
     inline Argument(OperationNode<Base>& operation) :
-        operation_(&operation) {
+        operation_(&operation),
+        parameter_(),
+        isParameter_(false) {
     }
 
     inline Argument(const Base& parameter) :
         operation_(nullptr),
-        parameter_(new Base(parameter)) {
+        parameter_(parameter),
+        isParameter_(true) {
     }
 
-    inline Argument(const Argument& orig) :
-        operation_(orig.operation_),
-        parameter_(orig.parameter_ != nullptr ? new Base(*orig.parameter_) : nullptr) {
-    }
+    inline Argument(const Argument& orig) = default;
 
     inline Argument(Argument&& orig) :
             operation_(orig.operation_),
-            parameter_(std::move(orig.parameter_)) {
+            parameter_(std::move(orig.parameter_)),
+            isParameter_(orig.isParameter_) {
+        orig.isParameter_ = false;
     }
 
     inline Argument& operator=(const Argument& rhs) {
         if (&rhs == this) {
             return *this;
         }
-        if (rhs.operation_ != nullptr) {
-            operation_ = rhs.operation_;
-            parameter_.reset();
-        } else {
-            operation_ = nullptr;
-            if (parameter_ != nullptr) {
-                *parameter_ = *rhs.parameter_;
-            } else {
-                parameter_.reset(new Base(*rhs.parameter_)); // to replace with parameter_ = std::make_unique once c++14 is used
-            }
+        operation_ = rhs.operation_;
+        if (rhs.isParameter_) {
+            parameter_ = rhs.parameter_;
         }
+        isParameter_ = rhs.isParameter_;
         return *this;
     }
 
@@ -81,7 +87,11 @@ public:
         operation_ = rhs.operation_;
 
         // steal the parameter
-        parameter_ = std::move(rhs.parameter_);
+        if (rhs.isParameter_) {
+            parameter_ = std::move(rhs.parameter_);
+        }
+        isParameter_ = rhs.isParameter_;
+        rhs.isParameter_ = false;
 
         return *this;
     }
@@ -92,8 +102,13 @@ public:
         return operation_;
     }
 
+    /**
+     * @return a pointer to the constant value or null if this argument is
+     *         not a constant (the pointer is only valid while this
+     *         argument is not modified or moved)
+     */
     inline Base* getParameter() const {
-        return parameter_.get();
+        return isParameter_ ? const_cast<Base*>(&parameter_) : nullptr;
     }
 
 };
@@ -21,7 +21,7 @@ namespace cg {
 template<class Base>
 inline CG<Base>& CG<Base>::operator+=(const CG<Base> &right) {
     if (isParameter() && right.isParameter()) {
-        *value_ += *right.value_;
+        value_ += right.value_;
 
     } else {
         CodeHandler<Base>* handler;
@@ -45,12 +45,12 @@ inline CG<Base>& CG<Base>::operator+=(const CG<Base> &right) {
             handler = node_->getCodeHandler();
         }
 
-        std::unique_ptr<Base> value;
+        OperationNode<Base>* node = handler->makeNode(CGOpCode::Add,{argument(), right.argument()});
         if (isValueDefined() && right.isValueDefined()) {
-            value.reset(new Base(getValue() + right.getValue()));
+            makeVariable(*node, getValue() + right.getValue());
+        } else {
+            makeVariable(*node);
         }
-
-        makeVariable(*handler->makeNode(CGOpCode::Add,{argument(), right.argument()}), value);
     }
 
     return *this;
@@ -59,7 +59,7 @@ inline CG<Base>& CG<Base>::operator+=(const CG<Base> &right) {
 template<class Base>
 inline CG<Base>& CG<Base>::operator-=(const CG<Base> &right) {
     if (isParameter() && right.isParameter()) {
-        *value_ -= *right.value_;
+        value_ -= right.value_;
 
     } else {
         CodeHandler<Base>* handler;
@@ -78,12 +78,12 @@ inline CG<Base>& CG<Base>::operator-=(const CG<Base> &right) {
             handler = node_->getCodeHandler();
         }
 
-        std::unique_ptr<Base> value;
+        OperationNode<Base>* node = handler->makeNode(CGOpCode::Sub,{argument(), right.argument()});
         if (isValueDefined() && right.isValueDefined()) {
-            value.reset(new Base(getValue() - right.getValue()));
+            makeVariable(*node, getValue() - right.getValue());
+        } else {
+            makeVariable(*node);
         }
-
-        makeVariable(*handler->makeNode(CGOpCode::Sub,{argument(), right.argument()}), value);
     }
 
     return *this;
@@ -92,7 +92,7 @@ inline CG<Base>& CG<Base>::operator-=(const CG<Base> &right) {
 template<class Base>
 inline CG<Base>& CG<Base>::operator*=(const CG<Base> &right) {
     if (isParameter() && right.isParameter()) {
-        *value_ *= *right.value_;
+        value_ *= right.value_;
 
     } else {
         CodeHandler<Base>* handler;
@@ -121,12 +121,12 @@ inline CG<Base>& CG<Base>::operator*=(const CG<Base> &right) {
             handler = node_->getCodeHandler();
         }
 
-        std::unique_ptr<Base> value;
+        OperationNode<Base>* node = handler->makeNode(CGOpCode::Mul,{argument(), right.argument()});
         if (isValueDefined() && right.isValueDefined()) {
-            value.reset(new Base(getValue() * right.getValue()));
+            makeVariable(*node, getValue() * right.getValue());
+        } else {
+            makeVariable(*node);
         }
-
-        makeVariable(*handler->makeNode(CGOpCode::Mul,{argument(), right.argument()}), value);
     }
 
     return *this;
@@ -135,7 +135,7 @@ inline CG<Base>& CG<Base>::operator*=(const CG<Base> &right) {
 template<class Base>
 inline CG<Base>& CG<Base>::operator/=(const CG<Base> &right) {
     if (isParameter() && right.isParameter()) {
-        *value_ /= *right.value_;
+        value_ /= right.value_;
 
     } else {
         CodeHandler<Base>* handler;
@@ -158,12 +158,12 @@ inline CG<Base>& CG<Base>::operator/=(const CG<Base> &right) {
             handler = node_->getCodeHandler();
         }
 
-        std::unique_ptr<Base> value;
+        OperationNode<Base>* node = handler->makeNode(CGOpCode::Div,{argument(), right.argument()});
         if (isValueDefined() && right.isValueDefined()) {
-            value.reset(new Base(getValue() / right.getValue()));
+            makeVariable(*node, getValue() / right.getValue());
+        } else {
+            makeVariable(*node);
         }
-
-        makeVariable(*handler->makeNode(CGOpCode::Div,{argument(), right.argument()}), value);
     }
 
     return *this;
@@ -36,8 +36,15 @@ private:
     /**
      * A constant value which must be defined for parameters.
      * Its definition is optional for variables.
+     * It is stored inline (and not on the heap) since CG objects are
+     * created and copied very often by CppAD while taping and during the
+     * forward and reverse sweeps.
      */
-    std::unique_ptr<Base> value_;
+    Base value_;
+    /**
+     * Whether or not value_ is defined.
+     */
+    bool valueDefined_;
 
 public:
     /**
@@ -178,7 +185,7 @@ protected:
     inline void makeVariable(OperationNode<Base>& operation);
 
     inline void makeVariable(OperationNode<Base>& operation,
-                             std::unique_ptr<Base>& value);
+                             const Base& value);
 
     // creating an argument out of this node
     inline Argument<Base> argument() const;
@@ -893,6 +893,7 @@ protected:
     friend class CGAbstractAtomicFun<Base>;
     friend class BaseAbstractAtomicFun<Base>;
     friend class LoopModel<Base>;
+    friend class OperationGraphBinary<Base>;
 
 };
 
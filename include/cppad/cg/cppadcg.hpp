@@ -32,14 +32,17 @@ static_assert(false,
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cerrno>
 #include <fstream>
 #include <iomanip>
 #include <iosfwd>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <memory>
 #include <valarray>
 #include <vector>
@@ -55,7 +58,10 @@ static_assert(false,
 #include <cstring>
 #include <chrono>
 #include <thread>
+#include <atomic>
+#include <mutex>
 #include <functional>
+#include <random>
 
 // ---------------------------------------------------------------------------
 // operating system detection
@@ -185,6 +191,10 @@ static_assert(false,
 #include <cppad/cg/atomic_fun_bridge.hpp>
 #include <cppad/cg/model/atomic_generic_model.hpp>
 
+// ---------------------------------------------------------------------------
+// operation graph serialization
+#include <cppad/cg/operation_graph_binary.hpp>
+
 // ---------------------------------------------------------------------------
 // loop/pattern detection
 #include <cppad/cg/patterns/independent_node_sorter.hpp>
@@ -195,6 +205,7 @@ static_assert(false,
 #include <cppad/cg/patterns/equation_pattern.hpp>
 #include <cppad/cg/patterns/loop.hpp>
 #include <cppad/cg/patterns/dependent_pattern_matcher.hpp>
+#include <cppad/cg/patterns/related_dependent_finder.hpp>
 
 // ---------------------------------------------------------------------------
 // C source code generation
@@ -208,21 +219,32 @@ static_assert(false,
 #include <cppad/cg/lang/c/lang_c_default_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_default_hessian_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_default_reverse2_var_name_gen.hpp>
+#include <cppad/cg/lang/c/lang_c_default_param_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_custom_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_util.hpp>
 
+// ---------------------------------------------------------------------------
+// bytecode generation
+#include <cppad/cg/lang/bytecode/bytecode_program.hpp>
+#include <cppad/cg/lang/bytecode/language_bytecode.hpp>
+
 //
 #include <cppad/cg/model/threadpool/multi_threading_type.hpp>
 #include <cppad/cg/model/threadpool/thread_pool_schedule_strategy.hpp>
 #include <cppad/cg/model/external_function_wrapper.hpp>
 #include <cppad/cg/model/atomic_external_function_wrapper.hpp>
 #include <cppad/cg/model/generic_model_external_function_wrapper.hpp>
+#include <cppad/cg/model/array_view_atomic_fun.hpp>
+#include <cppad/cg/model/array_view_external_function_wrapper.hpp>
+#include <cppad/cg/model/sparsity_view.hpp>
 #include <cppad/cg/model/model_library_processor.hpp>
 #include <cppad/cg/model/model_library.hpp>
 #include <cppad/cg/model/generic_model.hpp>
 #include <cppad/cg/model/functor_generic_model.hpp>
 #include <cppad/cg/model/functor_model_library.hpp>
 #include <cppad/cg/model/save_files_model_library_processor.hpp>
+#include <cppad/cg/model/tiered_generic_model.hpp>
+#include <cppad/cg/model/reloadable_generic_model.hpp>
 
 // automated static library creation
 #include <cppad/cg/model/dynamic_lib/archiver.hpp>
@@ -248,6 +270,7 @@ static_assert(false,
 #include <cppad/cg/model/model_c_source_gen_for1.hpp>
 #include <cppad/cg/model/model_c_source_gen_rev1.hpp>
 #include <cppad/cg/model/model_c_source_gen_rev2.hpp>
+#include <cppad/cg/model/model_c_source_gen_for_taylor.hpp>
 #include <cppad/cg/model/model_c_source_gen_jac.hpp>
 #include <cppad/cg/model/model_c_source_gen_hes.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops.hpp>
@@ -261,6 +284,9 @@ static_assert(false,
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_hess_r2.hpp>
 #include <cppad/cg/model/patterns/hessian_with_loops_info.hpp>
 
+// bytecode interpreter
+#include <cppad/cg/model/bytecode/bytecode_generic_model.hpp>
+
 // automated dynamic library creation
 #include <cppad/cg/model/dynamic_lib/dynamiclib.hpp>
 #include <cppad/cg/model/dynamic_lib/dynamic_library_processor.hpp>
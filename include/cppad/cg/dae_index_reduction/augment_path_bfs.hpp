@@ -0,0 +1,169 @@
+#ifndef CPPAD_CG_AUGMENTPATHBFS_INCLUDED
+#define CPPAD_CG_AUGMENTPATHBFS_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/dae_index_reduction/augment_path.hpp>
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * An augment path algorithm based on breadth-first searches which can be
+ * used as an alternative to AugmentPathDepthLookahead.
+ *
+ * A single augmentation (augmentPath()) determines the shortest augmenting
+ * path starting at the equation node using an explicit queue (no
+ * recursion). Equations and variables are colored exactly as in
+ * AugmentPathDepthLookahead so that, when no path exists, the colored nodes
+ * are the ones which must be differentiated.
+ * Each call finds at most one augmenting path, so the worst case
+ * complexity is the same as for the depth-first search.
+ * Intermediate data is kept between calls in order to avoid reallocations.
+ */
+template<class Base>
+class AugmentPathBfs : public AugmentPath<Base> {
+protected:
+    using CGBase = CppAD::cg::CG<Base>;
+    using ADCG = CppAD::AD<CGBase>;
+protected:
+    // equations which have been reached (breadth-first search queue)
+    std::vector<Enode<Base>*> queue_;
+    // the variable used to reach each equation (indexed by equation index)
+    std::vector<Vnode<Base>*> reachedBy_;
+    // the equation from which each equation was reached (indexed by equation index)
+    std::vector<Enode<Base>*> parent_;
+public:
+
+    /**
+     * Searches for the shortest augmenting path starting at a single
+     * equation with a breadth-first search.
+     * Visited nodes are colored and unassigned derivatives are preferred
+     * over algebraic variables.
+     *
+     * @param i The equation node
+     * @return true if an augmented path was found
+     */
+    bool augmentPath(Enode<Base>& i) override {
+        std::ostream& out = this->logger_->log();
+        Verbosity verbosity = this->logger_->getVerbosity();
+
+        i.color(out, verbosity); // avoids visiting the same equation again
+
+        queue_.clear();
+        queue_.push_back(&i);
+        prepare(i);
+
+        for (size_t q = 0; q < queue_.size(); q++) {
+            Enode<Base>& e = *queue_[q];
+
+            Vnode<Base>* free = findUnassignedVariable(e);
+            if (free != nullptr) {
+                augment(i, e, *free);
+                return true;
+            }
+
+            for (Vnode<Base>* jj : e.variables()) {
+                if (jj->isColored() || !isCandidate(*jj))
+                    continue;
+
+                if (isColorVariables())
+                    jj->color(out, verbosity);
+
+                Enode<Base>* k = jj->assignmentEquation(); // all candidate variables are assigned to another equation
+                if (!k->isColored()) {
+                    k->color(out, verbosity);
+                    prepare(*k);
+                    reachedBy_[k->index()] = jj;
+                    parent_[k->index()] = &e;
+                    queue_.push_back(k);
+                }
+            }
+        }
+
+        return false;
+    }
+
+protected:
+
+    /**
+     * Whether or not a variable can be assigned to an equation.
+     */
+    virtual bool isCandidate(const Vnode<Base>& j) const {
+        return true;
+    }
+
+    /**
+     * Whether or not variables are colored when they are visited.
+     */
+    virtual bool isColorVariables() const {
+        return true;
+    }
+
+    /**
+     * Looks for an unassigned variable in an equation (derivatives are
+     * preferred over algebraic variables).
+     */
+    virtual Vnode<Base>* findUnassignedVariable(const Enode<Base>& e) const {
+        Vnode<Base>* algebraic = nullptr;
+        for (Vnode<Base>* jj : e.variables()) {
+            if (jj->assignmentEquation() == nullptr && isCandidate(*jj)) {
+                if (jj->antiDerivative() != nullptr) {
+                    return jj;
+                } else if (algebraic == nullptr) {
+                    algebraic = jj;
+                }
+            }
+        }
+        return algebraic;
+    }
+
+    inline void prepare(const Enode<Base>& e) {
+        if (reachedBy_.size() <= e.index()) {
+            reachedBy_.resize(e.index() + 1, nullptr);
+            parent_.resize(e.index() + 1, nullptr);
+        }
+    }
+
+    /**
+     * Flips the assignments along the path found by augmentPath()
+     */
+    inline void augment(Enode<Base>& root,
+                        Enode<Base>& last,
+                        Vnode<Base>& free) {
+        std::ostream& out = this->logger_->log();
+        Verbosity verbosity = this->logger_->getVerbosity();
+
+        Enode<Base>* e = &last;
+        Vnode<Base>* j = &free;
+        while (true) {
+            Vnode<Base>* previous = reachedBy_[e->index()];
+            Enode<Base>* parent = parent_[e->index()];
+
+            j->setAssignmentEquation(*e, out, verbosity);
+            if (e == &root)
+                break;
+
+            j = previous;
+            e = parent;
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
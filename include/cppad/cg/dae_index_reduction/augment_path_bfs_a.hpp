@@ -0,0 +1,47 @@
+#ifndef CPPAD_CG_AUGMENTPATHBFSA_INCLUDED
+#define CPPAD_CG_AUGMENTPATHBFSA_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/dae_index_reduction/augment_path_bfs.hpp>
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Similar algorithm as <code>AugmentPathBfs</code> which only
+ * considers the highest order derivatives and ignores algebraic variables
+ * (an alternative to <code>AugmentPathDepthLookaheadA</code>).
+ * Variables are not colored.
+ */
+template<class Base>
+class AugmentPathBfsA : public AugmentPathBfs<Base> {
+protected:
+
+    bool isCandidate(const Vnode<Base>& j) const override {
+        return j.derivative() == nullptr && // highest order derivative
+               j.antiDerivative() != nullptr; // not an algebraic variable
+    }
+
+    bool isColorVariables() const override {
+        return false;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -62,7 +62,7 @@ protected:
      * Jacobian sparsity pattern of the reduced system
      * (in the original variable order)
      */
-    std::vector<bool> jacSparsity_;
+    std::vector<std::set<size_t> > jacSparsity_;
     // the initial index of time derivatives
     size_t diffVarStart_;
     // the initial index of the differentiated equations
@@ -742,7 +742,7 @@ protected:
 
         vector<CGBase> res0 = graph.forward0(*reducedFun_, indep0);
 
-        vector<bool> jacSparsity = jacobianSparsity<vector<bool> >(*reducedFun_);
+        vector<std::set<size_t> > jacSparsity = jacobianSparsitySet<vector<std::set<size_t> > >(*reducedFun_);
 
         vector<Vnode<Base>*> diffVariables;
         vector<Vnode<Base>*> dummyVariables;
@@ -783,7 +783,7 @@ protected:
                     typename map<Vnode<Base>*, Vnode<Base>*>::const_iterator it;
                     it = eliminateOrig2New.find(jOrig);
                     if (it != eliminateOrig2New.end() &&
-                            jacSparsity[varInfo.size() * i + jOrig->tapeIndex()]) {
+                            jacSparsity[i].count(jOrig->tapeIndex()) > 0) {
                         Vnode<Base>* j = it->second;
 
                         CGBase& dep = res0[i]; // the equation residual
@@ -796,7 +796,7 @@ protected:
                 }
             }
 
-            map<size_t, Vnode<Base>*> tape2FreeVariables;
+            vector<Vnode<Base>*> tape2FreeVariables(varInfo.size(), nullptr);
             for (Vnode<Base>* j : variables) {
                 tape2FreeVariables[j->tapeIndex()] = j;
             }
@@ -819,7 +819,7 @@ protected:
                                     Enode<Base>& i = *j->equations()[0];
                                     if (i.assignmentVariable() == nullptr) {
                                         if (!assignVar2Equation(i, res0, *j, indep0, handler,
-                                                                jacSparsity, tape2FreeVariables,
+                                                                jacSparsity, tape2FreeVariables, variables,
                                                                 equations, varInfo)) {
                                             throw CGException("Failed to solve equation ", i.name(), " for variable ", j->name());
                                         }
@@ -839,7 +839,7 @@ protected:
                                 Enode<Base>& i = *j->equations()[0];
                                 if (i.assignmentVariable() == nullptr) {
                                     if (assignVar2Equation(i, res0, *j, indep0, handler,
-                                                           jacSparsity, tape2FreeVariables,
+                                                           jacSparsity, tape2FreeVariables, variables,
                                                            equations, varInfo))
                                         assigned++;
                                 }
@@ -856,7 +856,7 @@ protected:
                         if (i->assignmentVariable() == nullptr && i->variables().size() == 1) {
                             Vnode<Base>* j = i->variables()[0];
                             if (assignVar2Equation(*i, res0, *j, indep0, handler,
-                                                   jacSparsity, tape2FreeVariables,
+                                                   jacSparsity, tape2FreeVariables, variables,
                                                    equations, varInfo))
                                 assigned++;
                         }
@@ -875,7 +875,7 @@ protected:
                         for (Enode<Base>* i : j->equations()) {
                             if (i->assignmentVariable() == nullptr) {
                                 if (assignVar2Equation(*i, res0, *j, indep0, handler,
-                                                       jacSparsity, tape2FreeVariables,
+                                                       jacSparsity, tape2FreeVariables, variables,
                                                        equations, varInfo)) {
                                     assigned++;
                                     break;
@@ -961,16 +961,17 @@ protected:
     inline bool assignVar2Equation(Enode<Base>& i, std::vector<CGBase>& res0,
                                    Vnode<Base>& j, std::vector<CGBase>& indep0,
                                    CodeHandler<Base>& handler,
-                                   std::vector<bool>& jacSparsity,
-                                   const std::map<size_t, Vnode<Base>*>& tape2FreeVariables,
+                                   std::vector<std::set<size_t> >& jacSparsity,
+                                   const std::vector<Vnode<Base>*>& tape2FreeVariables,
+                                   const std::vector<Vnode<Base>*>& freeVariables,
                                    std::vector<Enode<Base>*>& equations,
                                    std::vector<DaeVarInfo>& varInfo) {
         using namespace std;
         using std::vector;
         using std::map;
 
-        std::vector<bool> localJacSparsity = jacSparsity;
-        const size_t n = varInfo.size();
+        // the original sparsity of the rows modified by the substitution
+        vector<std::pair<size_t, set<size_t> > > changedRows;
 
         /**
          * Implement the assignment in the model
@@ -1005,20 +1006,19 @@ protected:
          * substitution
          */
         vector<size_t> nnzs;
-        for (const auto& it : tape2FreeVariables) {
-            size_t tapeJ = it.first;
-            if (localJacSparsity[n * i.index() + tapeJ] && tapeJ != j.tapeIndex()) {
+        for (size_t tapeJ : jacSparsity[i.index()]) {
+            if (tape2FreeVariables[tapeJ] != nullptr && tapeJ != j.tapeIndex()) {
                 nnzs.push_back(tapeJ);
             }
         }
         set<Enode<Base>*> affected;
         for (size_t e = 0; e < equations.size(); ++e) {
-            if (equations[e] != &i && localJacSparsity[n * e + j.tapeIndex()]) {
-                localJacSparsity[n * e + j.tapeIndex()] = false; // eliminated by substitution
+            set<size_t>& row = jacSparsity[e];
+            if (equations[e] != &i && row.count(j.tapeIndex()) > 0) {
+                changedRows.emplace_back(e, row);
+                row.erase(j.tapeIndex()); // eliminated by substitution
                 affected.insert(equations[e]);
-                for (size_t p = 0; p < nnzs.size(); ++p) {
-                    localJacSparsity[n * e + nnzs[p]] = true;
-                }
+                row.insert(nnzs.begin(), nnzs.end());
             }
         }
 
@@ -1040,36 +1040,40 @@ protected:
             // redetermine solvability
             for (Enode<Base>* itAff : affected) {
                 Enode<Base>& a = *itAff;
-                for (const auto& it : tape2FreeVariables) {
-                    size_t jj = it.first;
-                    if (localJacSparsity[n * a.index() + jj]) {
-                        if (handler.isSolvable(*res0[a.index()].getOperationNode(), *indep0[jj].getOperationNode())) {
-                            solvable[jj].insert(&a);
-                        }
+                for (size_t jj : jacSparsity[a.index()]) {
+                    if (tape2FreeVariables[jj] != nullptr &&
+                            handler.isSolvable(*res0[a.index()].getOperationNode(), *indep0[jj].getOperationNode())) {
+                        solvable[jj].insert(&a);
                     }
                 }
             }
 
             // check if any variable stops being solvable
-            bool ok = true;
-            for (const auto& it : tape2FreeVariables) {
-                Vnode<Base>* v = it.second;
+            Vnode<Base>* unsolvable = nullptr;
+            for (Vnode<Base>* v : freeVariables) {
                 if (v == &j)
                     continue;
 
                 if (v->assignmentEquation() != nullptr) {
                     if (affected.count(v->assignmentEquation()) > 0 &&
                             solvable[v->tapeIndex()].count(v->assignmentEquation()) == 0) {
-                        ok = false;
+                        unsolvable = v;
                         break;
                     }
                 } else if (solvable[v->tapeIndex()].size() == 0) {
-                    ok = false;
+                    unsolvable = v;
                     break;
                 }
             }
 
-            if (!ok) {
+            if (unsolvable != nullptr) {
+                if (this->verbosity_ >= Verbosity::High)
+                    log() << "      Undoing the assignment of " << j.name() << " to " << i.name()
+                          << " (" << unsolvable->name() << " would not be solvable)\n";
+
+                for (auto& r : changedRows) {
+                    jacSparsity[r.first].swap(r.second);
+                }
                 handler.undoSubstituteIndependent(*indep.getOperationNode());
                 if (indepName.size() > 0) {
                     indep.getOperationNode()->setName(indepName);
@@ -1082,14 +1086,14 @@ protected:
              */
             for (Enode<Base>* itAff : affected) {
                 Enode<Base>& a = *itAff;
-                for (const auto& it : tape2FreeVariables) {
-                    size_t v = it.first;
-                    if (localJacSparsity[n * a.index() + v]) {
+                for (size_t v : jacSparsity[a.index()]) {
+                    Vnode<Base>* jj = tape2FreeVariables[v];
+                    if (jj != nullptr) {
                         if (solvable[v].count(&a) > 0) {
-                            a.addVariable(it.second);
+                            a.addVariable(jj);
                         } else {
                             // not solvable anymore
-                            a.deleteNode(it.second);
+                            a.deleteNode(jj);
                         }
                     }
                 }
@@ -1108,8 +1112,6 @@ protected:
         j.setAssignmentEquation(i, log(), this->verbosity_);
         j.deleteNode(log(), this->verbosity_);
 
-        jacSparsity = localJacSparsity;
-
         return true;
     }
 
@@ -1320,17 +1322,19 @@ protected:
         auto& vnodes = graph.variables();
         auto& enodes = graph.equations();
 
-        jacSparsity_ = jacobianReverseSparsity<vector<bool>, CGBase>(*reducedFun_); // in the original variable order
+        jacSparsity_ = jacobianReverseSparsitySet<vector<std::set<size_t> >, CGBase>(*reducedFun_); // in the original variable order
 
-        vector<size_t> row, col;
-        row.reserve((vnodes.size() - diffVarStart_) * (m - diffEqStart_));
-        col.reserve(row.capacity());
+        // the (differential) variables in the Jacobian for each tape index
+        vector<Vnode<Base>*> tape2Var(n, nullptr);
+        for (size_t j = diffVarStart_; j < vnodes.size(); j++) {
+            CPPADCG_ASSERT_UNKNOWN(vnodes[j]->antiDerivative() != nullptr);
+            tape2Var[vnodes[j]->tapeIndex()] = vnodes[j];
+        }
 
+        vector<size_t> row, col;
         for (size_t i = diffEqStart_; i < m; i++) {
-            for (size_t j = diffVarStart_; j < vnodes.size(); j++) {
-                CPPADCG_ASSERT_UNKNOWN(vnodes[j]->antiDerivative() != nullptr);
-                size_t t = vnodes[j]->tapeIndex();
-                if (jacSparsity_[i * n + t]) {
+            for (size_t t : jacSparsity_[i]) {
+                if (tape2Var[t] != nullptr) {
                     row.push_back(i);
                     col.push_back(t);
                 }
@@ -1347,30 +1351,27 @@ protected:
         reducedFun_->SparseJacobianReverse(indep, jacSparsity_,
                                            row, col, jac, work);
 
-        // resize and zero matrix
-        jacobian_.resize(m - diffEqStart_, vnodes.size() - diffVarStart_);
-
-        map<size_t, Vnode<Base>*> origIndex2var;
-        for (size_t j = diffVarStart_; j< vnodes.size(); j++) {
-            Vnode<Base>* jj = vnodes[j];
-            origIndex2var[jj->tapeIndex()] = jj;
-        }
-
         // normalize values
+        std::vector<Eigen::Triplet<Base> > elements;
+        elements.reserve(jac.size());
         for (size_t e = 0; e < jac.size(); e++) {
+            Vnode<Base>* var = tape2Var[col[e]];
             Enode<Base>* eqOrig = enodes[row[e]]->originalEquation();
-            Vnode<Base>* vOrig = origIndex2var[col[e]]->originalVariable(graph.getOrigTimeDependentCount());
+            Vnode<Base>* vOrig = var->originalVariable(graph.getOrigTimeDependentCount());
 
             // normalized jacobian value
             Base normVal = jac[e].getValue() * normVar_[vOrig->tapeIndex()]
                     / normEq_[eqOrig->index()];
 
             size_t i = row[e]; // same order
-            size_t j = origIndex2var[col[e]]->index(); // different order than in model/tape
+            size_t j = var->index(); // different order than in model/tape
 
-            jacobian_.coeffRef(i - diffEqStart_, j - diffVarStart_) = normVal;
+            elements.emplace_back(i - diffEqStart_, j - diffVarStart_, normVal);
         }
 
+        jacobian_.resize(m - diffEqStart_, vnodes.size() - diffVarStart_);
+        jacobian_.setFromTriplets(elements.begin(), elements.end());
+
         jacobian_.makeCompressed();
 
         if (this->verbosity_ >= Verbosity::High) {
@@ -1596,18 +1597,18 @@ protected:
     }
 
     inline static void printGraphSparsity(std::ostream& out,
-                                          const std::vector<bool>& jacSparsity,
-                                          const std::map<size_t, Vnode<Base>*>& tape2FreeVariables,
-                                          const std::vector<Enode<Base>*>& equations,
-                                          const size_t n) {
+                                          const std::vector<std::set<size_t> >& jacSparsity,
+                                          const std::vector<Vnode<Base>*>& tape2FreeVariables,
+                                          const std::vector<Enode<Base>*>& equations) {
         for (size_t e = 0; e < equations.size(); ++e) {
             Enode<Base>* eq = equations[e];
             size_t count = 0;
-            for (const auto& it : tape2FreeVariables) {
-                if (jacSparsity[n * eq->index() + it.first]) {
+            for (size_t j : jacSparsity[eq->index()]) {
+                Vnode<Base>* v = tape2FreeVariables[j];
+                if (v != nullptr) {
                     if (count == 0)
                         out << "# Equation " << e << ": \t";
-                    out << " " << it.second->name();
+                    out << " " << v->name();
                     count++;
                 }
             }
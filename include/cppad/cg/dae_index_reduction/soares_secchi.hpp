@@ -83,10 +83,22 @@ public:
         return *augmentPath_;
     }
 
-    void setAugmentPath(AugmentPath<Base>& a) const {
+    void setAugmentPath(AugmentPath<Base>& a) {
         augmentPath_ = &a;
     }
 
+    /**
+     * Provides the algorithm used to assign equations to the highest order
+     * derivatives only (before any equation is marked for differentiation)
+     */
+    AugmentPath<Base>& getAugmentPathA() const {
+        return *augmentPathA_;
+    }
+
+    void setAugmentPathA(AugmentPath<Base>& a) {
+        augmentPathA_ = &a;
+    }
+
     /**
      * Defines whether or not original names saved by using
      * CppAD::PrintFor(0, "", val, name)
@@ -71,6 +71,9 @@ class BidirGraph;
 template<class Base>
 class ScopePathElement;
 
+template<class Base>
+class OperationGraphBinary;
+
 /***************************************************************************
  * Nodes
  **************************************************************************/
@@ -134,6 +137,12 @@ class LangCDefaultVariableNameGenerator;
 template<class Base>
 class LangCCustomVariableNameGenerator;
 
+template<class Base>
+class LanguageBytecode;
+
+template<class Base>
+class BytecodeProgram;
+
 /***************************************************************************
  * Models
  **************************************************************************/
@@ -146,6 +155,18 @@ class ModelLibraryProcessor;
 template<class Base>
 class FunctorGenericModel;
 
+template<class Base>
+class BytecodeGenericModel;
+
+template<class Base>
+class LlvmIrGenericModel;
+
+template<class Base>
+class TieredGenericModel;
+
+template<class Base>
+class ReloadableGenericModel;
+
 /***************************************************************************
  * Dynamic model compilation
  **************************************************************************/
@@ -37,9 +37,13 @@ class EvaluatorBase;
  * pattern (CRTP). Therefore the default behaviour can be overridden without
  * the use of virtual methods.
  *
- * This class should not be instantiated directly.
+ * The operations required by each dependent are visited without recursion
+ * (see isTopologicalEvaluation()) so that there are no stack limit issues
+ * for deep operation graphs.
+ * The results are saved in flat arrays indexed by the handler position of
+ * the nodes which are reused by the following evaluations.
  *
- * @todo implement nonrecursive algorithm (so that there will never be any stack limit issues)
+ * This class should not be instantiated directly.
  */
 template<class ScalarIn, class ScalarOut, class ActiveOut, class FinalEvaluatorType>
 class EvaluatorBase {
@@ -49,9 +53,39 @@ protected:
 protected:
     CodeHandler<ScalarIn>& handler_;
     const ActiveOut* indep_;
-    CodeHandlerVector<ScalarIn, std::unique_ptr<ActiveOut>> evals_;
-    std::map<size_t, std::vector<ActiveOut>* > evalsArrays_;
-    std::map<size_t, std::vector<ActiveOut>* > evalsSparseArrays_;
+    /**
+     * the results of the evaluated nodes (in the order they were evaluated)
+     */
+    std::vector<ActiveOut> evals_;
+    /**
+     * the position in evals_ plus one of the result of each node (indexed
+     * by the handler position; zero if the node was not evaluated)
+     */
+    std::vector<size_t> evalsIndex_;
+    /**
+     * the values of the evaluated array creation operations
+     * (a deque so that references remain valid when new arrays are added)
+     */
+    std::deque<std::vector<ActiveOut> > evalsArrays_;
+    /**
+     * the number of arrays in evalsArrays_ used by the current evaluation
+     */
+    size_t evalsArraysUsed_;
+    /**
+     * the position in evalsArrays_ plus one of the array of each array
+     * creation node (indexed by the handler position)
+     */
+    std::vector<size_t> evalsArraysIndex_;
+    /**
+     * the nodes being visited and the index of their next argument to visit
+     * (used by the topological evaluation)
+     */
+    std::vector<std::pair<OperationNode<ScalarIn>*, size_t> > visitStack_;
+    /**
+     * whether or not each node was already visited (indexed by the handler
+     * position)
+     */
+    std::vector<bool> visited_;
     bool underEval_;
     size_t depth_;
     SourceCodePath path_;
@@ -63,14 +97,12 @@ public:
     inline EvaluatorBase(CodeHandler<ScalarIn>& handler) :
         handler_(handler),
         indep_(nullptr),
-        evals_(handler),
+        evalsArraysUsed_(0),
         underEval_(false),
         depth_(0) { // not really required (but it avoids warnings)
     }
 
-    inline virtual ~EvaluatorBase() {
-        clear();
-    }
+    inline virtual ~EvaluatorBase() = default;
 
     /**
      * @return true if this Evaluator is currently being used.
@@ -152,8 +184,14 @@ public:
 
         underEval_ = true;
 
-        clear(); // clean-up from any previous call that might have failed
-        evals_.adjustSize();
+        FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
+
+        thisOps.clear(); // clean-up from any previous call that might have failed
+
+        size_t nNodes = handler_.getManagedNodesCount();
+        evals_.reserve(nNodes); // the saved results are never moved
+        evalsIndex_.resize(nNodes, 0);
+        evalsArraysIndex_.resize(nNodes, 0);
 
         depth_ = 0;
         path_.clear();
@@ -162,16 +200,22 @@ public:
             path_.reserve(30);
         }
 
-        FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
-
         try {
             thisOps.prepareNewEvaluation();
 
             indep_ = indepNew;
             thisOps.analyzeOutIndeps(indep_, indepSize);
 
+            bool topological = thisOps.isTopologicalEvaluation();
+            if (topological) {
+                visited_.assign(nNodes, false);
+            }
+
             for (size_t i = 0; i < depSize; i++) {
                 CPPADCG_ASSERT_UNKNOWN(depth_ == 0);
+                if (topological && depOld[i].getOperationNode() != nullptr) {
+                    evalTopologicalOrder(*depOld[i].getOperationNode());
+                }
                 depNew[i] = evalCG(depOld[i]);
             }
 
@@ -192,20 +236,28 @@ protected:
     }
 
     /**
-     * clean-up
+     * Whether or not the operations required by each dependent are
+     * evaluated before the dependent itself following a topological order
+     * determined without recursion.
+     * Otherwise the operations are evaluated recursively starting from the
+     * dependents, which is required by evaluators which depend on the
+     * path from the dependent to each operation (path_).
+     *
+     * @note can be hidden by the FinalEvaluatorType (CRTP)
+     */
+    inline bool isTopologicalEvaluation() const {
+        return true;
+    }
+
+    /**
+     * clean-up (keeps the allocated memory for the next evaluation)
      */
     inline void clear() {
         evals_.clear();
+        std::fill(evalsIndex_.begin(), evalsIndex_.end(), 0);
 
-        for (const auto& p : evalsArrays_) {
-            delete p.second;
-        }
-        evalsArrays_.clear();
-
-        for (const auto& p : evalsSparseArrays_) {
-            delete p.second;
-        }
-        evalsSparseArrays_.clear();
+        evalsArraysUsed_ = 0;
+        std::fill(evalsArraysIndex_.begin(), evalsArraysIndex_.end(), 0);
     }
 
     inline void analyzeOutIndeps(const ActiveOut* indep,
@@ -213,6 +265,51 @@ protected:
         // empty
     }
 
+    /**
+     * Evaluates all the operations required by a node (and the node
+     * itself) in a post-order traversal of the operation graph using an
+     * explicit stack.
+     * Array creation and atomic operations are only visited, their
+     * evaluation is requested by the operations which use them.
+     *
+     * @param root the node to evaluate
+     */
+    inline void evalTopologicalOrder(OperationNode<ScalarIn>& root) {
+        if (visited_[root.getHandlerPosition()])
+            return;
+
+        visited_[root.getHandlerPosition()] = true;
+        visitStack_.clear();
+        visitStack_.emplace_back(&root, 0);
+
+        while (!visitStack_.empty()) {
+            OperationNode<ScalarIn>* node = visitStack_.back().first;
+            size_t& argIndex = visitStack_.back().second;
+            const std::vector<Argument<ScalarIn> >& args = node->getArguments();
+
+            if (argIndex < args.size()) {
+                OperationNode<ScalarIn>* arg = args[argIndex].getOperation();
+                argIndex++;
+                if (arg != nullptr && !visited_[arg->getHandlerPosition()]) {
+                    visited_[arg->getHandlerPosition()] = true;
+                    visitStack_.emplace_back(arg, 0); // argIndex is no longer valid
+                }
+                continue;
+            }
+
+            visitStack_.pop_back();
+
+            CGOpCode op = node->getOperationType();
+            if (op != CGOpCode::ArrayCreation &&
+                op != CGOpCode::SparseArrayCreation &&
+                op != CGOpCode::AtomicForward &&
+                op != CGOpCode::AtomicReverse &&
+                getEvaluation(*node) == nullptr) {
+                evalOperations(*node);
+            }
+        }
+    }
+
     inline ActiveOut evalCG(const CG<ScalarIn>& dep) {
         if (dep.isParameter()) {
             // parameter
@@ -239,12 +336,13 @@ protected:
         }
     }
 
-    inline const ActiveOut& evalOperations(OperationNode<ScalarIn>& node) {
+    inline ActiveOut evalOperations(OperationNode<ScalarIn>& node) {
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < handler_.getManagedNodesCount(), "this node is not managed by the code handler")
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        const ActiveOut* previous = getEvaluation(node);
+        if (previous != nullptr) {
+            return *previous;
         }
 
         // first evaluation of this node
@@ -264,68 +362,97 @@ protected:
         return *resultPtr;
     }
 
+    /**
+     * Provides the result of a previously evaluated node.
+     *
+     * @return the result or null if the node was not evaluated yet
+     */
+    inline ActiveOut* getEvaluation(const OperationNode<ScalarIn>& node) {
+        size_t p = node.getHandlerPosition();
+        if (p < evalsIndex_.size() && evalsIndex_[p] != 0) {
+            return &evals_[evalsIndex_[p] - 1];
+        }
+        return nullptr;
+    }
+
     inline ActiveOut* saveEvaluation(const OperationNode<ScalarIn>& node,
                                      ActiveOut&& result) {
-        std::unique_ptr<ActiveOut>& resultPtr = evals_[node];
-        CPPADCG_ASSERT_UNKNOWN(resultPtr == nullptr); // not supposed to override existing result
-        resultPtr.reset(new ActiveOut(std::move(result)));
+        size_t p = node.getHandlerPosition();
+        if (p >= evalsIndex_.size()) {
+            evalsIndex_.resize(p + 1, 0);
+        }
+        CPPADCG_ASSERT_UNKNOWN(evalsIndex_[p] == 0); // not supposed to override existing result
+
+        evals_.push_back(std::move(result));
+        evalsIndex_[p] = evals_.size();
 
-        ActiveOut* resultPtr2 = resultPtr.get(); // do not use a reference (just in case evals_ is resized)
+        ActiveOut* resultPtr = &evals_.back();
 
         FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
-        thisOps.processActiveOut(node, *resultPtr2);
+        thisOps.processActiveOut(node, *resultPtr);
 
-        return resultPtr2;
+        return resultPtr;
     }
 
-    inline std::vector<ActiveOut>& evalArrayCreationOperation(const OperationNode<ScalarIn>& node) {
-
-        CPPADCG_ASSERT_KNOWN(node.getOperationType() == CGOpCode::ArrayCreation, "Invalid array creation operation");
-        CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < handler_.getManagedNodesCount(), "this node is not managed by the code handler")
-
-        // check if this node was previously determined
-        auto it = evalsArrays_.find(node.getHandlerPosition());
-        if (it != evalsArrays_.end()) {
-            return *it->second;
+    /**
+     * Provides the values of a previously evaluated array creation
+     * operation.
+     *
+     * @return the values or null if the array was not evaluated yet
+     */
+    inline std::vector<ActiveOut>* getEvaluatedArray(const OperationNode<ScalarIn>& node) {
+        size_t p = node.getHandlerPosition();
+        if (p < evalsArraysIndex_.size() && evalsArraysIndex_[p] != 0) {
+            return &evalsArrays_[evalsArraysIndex_[p] - 1];
         }
+        return nullptr;
+    }
 
-        const std::vector<Argument<ScalarIn> >& args = node.getArguments();
-        auto* resultArray = new std::vector<ActiveOut>(args.size());
+    inline std::vector<ActiveOut>& evalArrayCreationOperation(const OperationNode<ScalarIn>& node) {
+        CPPADCG_ASSERT_KNOWN(node.getOperationType() == CGOpCode::ArrayCreation, "Invalid array creation operation");
 
-        // save it for reuse
-        evalsArrays_[node.getHandlerPosition()] = resultArray;
+        return evalArray(node);
+    }
 
-        // define its elements
-        for (size_t a = 0; a < args.size(); a++) {
-            (*resultArray)[a] = evalArg(args, a);
-        }
+    inline std::vector<ActiveOut>& evalSparseArrayCreationOperation(const OperationNode<ScalarIn>& node) {
+        CPPADCG_ASSERT_KNOWN(node.getOperationType() == CGOpCode::SparseArrayCreation, "Invalid array creation operation");
 
-        return *resultArray;
+        return evalArray(node);
     }
 
-    inline std::vector<ActiveOut>& evalSparseArrayCreationOperation(const OperationNode<ScalarIn>& node) {
+private:
 
-        CPPADCG_ASSERT_KNOWN(node.getOperationType() == CGOpCode::SparseArrayCreation, "Invalid array creation operation");
+    inline std::vector<ActiveOut>& evalArray(const OperationNode<ScalarIn>& node) {
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < handler_.getManagedNodesCount(), "this node is not managed by the code handler")
 
         // check if this node was previously determined
-        auto it = evalsSparseArrays_.find(node.getHandlerPosition());
-        if (it != evalsSparseArrays_.end()) {
-            return *it->second;
+        std::vector<ActiveOut>* previous = getEvaluatedArray(node);
+        if (previous != nullptr) {
+            return *previous;
         }
 
         const std::vector<Argument<ScalarIn> >& args = node.getArguments();
-        auto* resultArray = new std::vector<ActiveOut>(args.size());
+
+        // reuse an array from a previous evaluation
+        if (evalsArraysUsed_ == evalsArrays_.size()) {
+            evalsArrays_.emplace_back();
+        }
+        std::vector<ActiveOut>& resultArray = evalsArrays_[evalsArraysUsed_];
+        resultArray.resize(args.size());
 
         // save it for reuse
-        evalsSparseArrays_[node.getHandlerPosition()] = resultArray;
+        size_t p = node.getHandlerPosition();
+        if (p >= evalsArraysIndex_.size()) {
+            evalsArraysIndex_.resize(p + 1, 0);
+        }
+        evalsArraysIndex_[p] = ++evalsArraysUsed_;
 
         // define its elements
         for (size_t a = 0; a < args.size(); a++) {
-            (*resultArray)[a] = evalArg(args, a);
+            resultArray[a] = evalArg(args, a);
         }
 
-        return *resultArray;
+        return resultArray;
     }
 
 };
@@ -54,7 +54,6 @@ protected:
      * during the evaluation.
      */
     bool printOutPriOperations_;
-    using EvaluatorBase<ScalarIn, ScalarOut, CG<ScalarOut>, FinalEvaluatorType>::evals_;
 public:
 
     inline EvaluatorCG(CodeHandler<ScalarIn>& handler) :
@@ -155,8 +154,8 @@ protected:
                              "Invalid operation type")
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return; // *evals_[node];
+        if (this->getEvaluation(node) != nullptr) {
+            return;
         }
 
         const std::vector<size_t>& info = node.getInfo();
@@ -228,8 +227,9 @@ protected:
      */
     inline ActiveOut evalArrayElement(const NodeIn& node) {
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        const ActiveOut* previous = this->getEvaluation(node);
+        if (previous != nullptr) {
+            return *previous;
         }
 
         const std::vector<ArgIn>& args = node.getArguments();
@@ -245,7 +245,7 @@ protected:
         auto& thisOps = static_cast<FinalEvaluatorType&>(*this);
         const NodeIn& atomicNode = *args[1].getOperation();
         thisOps.evalAtomicOperation(atomicNode); // atomic operation
-        ArgOut atomicArg = *evals_[atomicNode]->getOperationNode();
+        ArgOut atomicArg = *this->getEvaluation(atomicNode)->getOperationNode();
 
         ActiveOut out(*outHandler_->makeNode(CGOpCode::ArrayElement, {index}, {arrayArg, atomicArg}));
 
@@ -271,16 +271,9 @@ protected:
                                std::vector<ScalarOut>& values,
                                bool& valuesDefined,
                                bool& allParameters) {
-        const std::vector<ActiveOut>* arrayActiveOut;
-        ActiveOut result;
+        ActiveOut result = makeArray(node);
 
-        if (node.getOperationType() == CGOpCode::ArrayCreation) {
-            result = makeDenseArray(node);
-            arrayActiveOut = this->evalsArrays_[node.getHandlerPosition()];
-        } else {
-            result = makeSparseArray(node);
-            arrayActiveOut = this->evalsSparseArrays_[node.getHandlerPosition()];
-        }
+        const std::vector<ActiveOut>* arrayActiveOut = this->getEvaluatedArray(node);
 
         processArray(*arrayActiveOut, values, valuesDefined, allParameters);
 
@@ -292,8 +285,9 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < this->handler_.getManagedNodesCount(), "this node is not managed by the code handler")
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        const ActiveOut* previous = this->getEvaluation(node);
+        if (previous != nullptr) {
+            return *previous;
         }
 
         if (outHandler_ == nullptr) {
@@ -312,8 +306,9 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < this->handler_.getManagedNodesCount(), "this node is not managed by the code handler")
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        const ActiveOut* previous = this->getEvaluation(node);
+        if (previous != nullptr) {
+            return *previous;
         }
 
         if (outHandler_ == nullptr) {
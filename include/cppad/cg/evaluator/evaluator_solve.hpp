@@ -133,6 +133,17 @@ public:
 
 protected:
 
+    /**
+     * The operations are evaluated recursively since only some of the
+     * nodes are cloned depending on the path from the dependents.
+     *
+     * @note overrides the default isTopologicalEvaluation() even though this
+     *       method is not virtual (hides a method in EvaluatorBase)
+     */
+    inline bool isTopologicalEvaluation() const {
+        return false;
+    }
+
     /**
      * @note overrides the default evalOperation() even though this method
      *        is not virtual (hides a method in EvaluatorOperations)
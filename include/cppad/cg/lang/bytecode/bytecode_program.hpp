@@ -0,0 +1,299 @@
+#ifndef CPPAD_CG_BYTECODE_PROGRAM_INCLUDED
+#define CPPAD_CG_BYTECODE_PROGRAM_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Instructions of the register based bytecode.
+ *
+ * Each instruction is stored in the instruction stream as the operation
+ * code followed by its operands (all register indexes, unless stated
+ * otherwise):
+ *  - unary operations:        op, result, x
+ *  - binary operations:       op, result, x, y
+ *  - conditional expressions: op, result, left, right, trueCase, falseCase
+ *  - print:                   op, x, text index
+ */
+enum class BytecodeOp : std::uint32_t {
+    Copy, // r = x
+    Abs,
+    Acos,
+    Acosh,
+    Asin,
+    Asinh,
+    Atan,
+    Atanh,
+    Cosh,
+    Cos,
+    Erf,
+    Erfc,
+    Exp,
+    Expm1,
+    Log,
+    Log1p,
+    Sign,
+    Sinh,
+    Sin,
+    Sqrt,
+    Tanh,
+    Tan,
+    UnMinus,
+    Add, // r = x + y
+    Sub,
+    Mul,
+    Div,
+    Pow,
+    CondLt, // r = left < right ? trueCase : falseCase
+    CondLe,
+    CondEq,
+    CondGe,
+    CondGt,
+    CondNe,
+    Print // print x
+};
+
+/**
+ * Provides the number of elements used by an instruction in the
+ * instruction stream (including the operation code).
+ */
+inline size_t bytecodeInstructionSize(BytecodeOp op) {
+    if (op <= BytecodeOp::UnMinus) {
+        return 3;
+    } else if (op <= BytecodeOp::Pow) {
+        return 4;
+    } else if (op <= BytecodeOp::CondNe) {
+        return 6;
+    } else {
+        return 3; // print
+    }
+}
+
+/**
+ * A compact register based program which evaluates a model without the
+ * need of a compiler.
+ *
+ * Register 0 is not used, registers 1 to n hold the independent variables
+ * (in the same order as they were created in the CodeHandler), followed by
+ * the dependent and temporary variables and, at the end, the constants.
+ * Programs are created by LanguageBytecode and are immutable afterwards,
+ * therefore they can be shared by several threads as long as each thread
+ * uses its own registers.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class BytecodeProgram {
+    friend class LanguageBytecode<Base>;
+protected:
+    /// number of independent variables
+    size_t _nIndependent;
+    /// total number of registers (including the constants)
+    size_t _nRegisters;
+    /// the index of the register with the first constant
+    size_t _constantStart;
+    /// constant values (placed in the last registers)
+    std::vector<Base> _constants;
+    /// instruction stream
+    std::vector<std::uint32_t> _code;
+    /// number of instructions in the instruction stream
+    size_t _nInstructions;
+    /// the register with the value of each dependent variable
+    std::vector<std::uint32_t> _dependents;
+    /// text to be printed before and after the values in print instructions
+    std::vector<std::pair<std::string, std::string> > _printText;
+public:
+
+    inline BytecodeProgram() :
+            _nIndependent(0),
+            _nRegisters(1),
+            _constantStart(1),
+            _nInstructions(0) {
+    }
+
+    inline size_t getIndependentCount() const {
+        return _nIndependent;
+    }
+
+    inline size_t getDependentCount() const {
+        return _dependents.size();
+    }
+
+    inline size_t getRegisterCount() const {
+        return _nRegisters;
+    }
+
+    inline size_t getInstructionCount() const {
+        return _nInstructions;
+    }
+
+    inline const std::vector<std::uint32_t>& getInstructions() const {
+        return _code;
+    }
+
+    inline const std::vector<Base>& getConstants() const {
+        return _constants;
+    }
+
+    /**
+     * Prepares the registers for the evaluation of this program.
+     * It only needs to be called once for each register vector since the
+     * constants are never overwritten.
+     *
+     * @param reg the registers
+     */
+    inline void initializeRegisters(std::vector<Base>& reg) const {
+        reg.resize(_nRegisters);
+        std::copy(_constants.begin(), _constants.end(), reg.begin() + _constantStart);
+    }
+
+    /**
+     * Copies independent variable values into the registers.
+     *
+     * @param reg the registers (already initialized)
+     * @param offset the index of the first independent variable to set
+     * @param x the independent variable values
+     */
+    inline void setIndependents(std::vector<Base>& reg,
+                                size_t offset,
+                                ArrayView<const Base> x) const {
+        CPPADCG_ASSERT_KNOWN(offset + x.size() <= _nIndependent, "Invalid independent array size")
+        CPPADCG_ASSERT_UNKNOWN(reg.size() == _nRegisters)
+        std::copy(x.begin(), x.end(), reg.begin() + 1 + offset);
+    }
+
+    /**
+     * Executes all instructions.
+     *
+     * @param reg the registers with the independent variable values
+     */
+    inline void execute(std::vector<Base>& reg) const {
+        CPPADCG_ASSERT_UNKNOWN(reg.size() == _nRegisters)
+        execute(reg.data());
+    }
+
+    /**
+     * Copies the dependent variable values from the registers.
+     *
+     * @param reg the registers after the execution of this program
+     * @param dep the dependent variable values
+     */
+    inline void getDependents(const std::vector<Base>& reg,
+                              ArrayView<Base> dep) const {
+        CPPADCG_ASSERT_KNOWN(dep.size() == _dependents.size(), "Invalid dependent array size")
+        for (size_t i = 0; i < _dependents.size(); i++) {
+            dep[i] = reg[_dependents[i]];
+        }
+    }
+
+    /**
+     * Evaluates the program for a single array of independent variables.
+     *
+     * @param reg the registers (already initialized)
+     * @param x the independent variable values
+     * @param dep the dependent variable values
+     */
+    inline void evaluate(std::vector<Base>& reg,
+                         ArrayView<const Base> x,
+                         ArrayView<Base> dep) const {
+        CPPADCG_ASSERT_KNOWN(x.size() == _nIndependent, "Invalid independent array size")
+        setIndependents(reg, 0, x);
+        execute(reg);
+        getDependents(reg, dep);
+    }
+
+protected:
+
+    inline void execute(Base* r) const {
+        const std::uint32_t* pc = _code.data();
+        const std::uint32_t* end = pc + _code.size();
+
+#define CPPAD_CG_BYTECODE_UNARY(OpName, Expr) \
+            case BytecodeOp::OpName: \
+                r[pc[1]] = Expr; \
+                pc += 3; \
+                break;
+#define CPPAD_CG_BYTECODE_BINARY(OpName, Expr) \
+            case BytecodeOp::OpName: \
+                r[pc[1]] = Expr; \
+                pc += 4; \
+                break;
+#define CPPAD_CG_BYTECODE_COND(OpName, Comp) \
+            case BytecodeOp::OpName: \
+                r[pc[1]] = (r[pc[2]] Comp r[pc[3]]) ? r[pc[4]] : r[pc[5]]; \
+                pc += 6; \
+                break;
+
+        while (pc != end) {
+            switch (static_cast<BytecodeOp>(*pc)) {
+                CPPAD_CG_BYTECODE_UNARY(Copy, r[pc[2]])
+                CPPAD_CG_BYTECODE_UNARY(Abs, CppAD::abs(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Acos, CppAD::acos(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Acosh, CppAD::acosh(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Asin, CppAD::asin(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Asinh, CppAD::asinh(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Atan, CppAD::atan(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Atanh, CppAD::atanh(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Cosh, CppAD::cosh(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Cos, CppAD::cos(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Erf, CppAD::erf(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Erfc, CppAD::erfc(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Exp, CppAD::exp(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Expm1, CppAD::expm1(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Log, CppAD::log(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Log1p, CppAD::log1p(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Sign, CppAD::sign(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Sinh, CppAD::sinh(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Sin, CppAD::sin(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Sqrt, CppAD::sqrt(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Tanh, CppAD::tanh(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(Tan, CppAD::tan(r[pc[2]]))
+                CPPAD_CG_BYTECODE_UNARY(UnMinus, -r[pc[2]])
+                CPPAD_CG_BYTECODE_BINARY(Add, r[pc[2]] + r[pc[3]])
+                CPPAD_CG_BYTECODE_BINARY(Sub, r[pc[2]] - r[pc[3]])
+                CPPAD_CG_BYTECODE_BINARY(Mul, r[pc[2]] * r[pc[3]])
+                CPPAD_CG_BYTECODE_BINARY(Div, r[pc[2]] / r[pc[3]])
+                CPPAD_CG_BYTECODE_BINARY(Pow, CppAD::pow(r[pc[2]], r[pc[3]]))
+                CPPAD_CG_BYTECODE_COND(CondLt, <)
+                CPPAD_CG_BYTECODE_COND(CondLe, <=)
+                CPPAD_CG_BYTECODE_COND(CondEq, ==)
+                CPPAD_CG_BYTECODE_COND(CondGe, >=)
+                CPPAD_CG_BYTECODE_COND(CondGt, >)
+                CPPAD_CG_BYTECODE_COND(CondNe, !=)
+                case BytecodeOp::Print: {
+                    const auto& text = _printText[pc[2]];
+                    std::cout << text.first << r[pc[1]] << text.second;
+                    pc += 3;
+                    break;
+                }
+                default:
+                    CPPADCG_ASSERT_UNKNOWN(false)
+                    return;
+            }
+        }
+
+#undef CPPAD_CG_BYTECODE_UNARY
+#undef CPPAD_CG_BYTECODE_BINARY
+#undef CPPAD_CG_BYTECODE_COND
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
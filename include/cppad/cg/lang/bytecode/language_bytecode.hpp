@@ -0,0 +1,342 @@
+#ifndef CPPAD_CG_LANGUAGE_BYTECODE_INCLUDED
+#define CPPAD_CG_LANGUAGE_BYTECODE_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Creates a register based bytecode program (BytecodeProgram) which can be
+ * evaluated without a compiler.
+ *
+ * The instructions follow the same variable order used to generate
+ * C source code by the CodeHandler, where each operation is assigned to a
+ * register (the variable ID). Temporary variable IDs are recycled by the
+ * CodeHandler and, consequently, so are the registers.
+ *
+ * Only scalar operations are supported (no atomic functions, loops, or
+ * conditional blocks).
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LanguageBytecode : public Language<Base> {
+    static_assert(std::is_trivially_copyable<Base>::value,
+                  "LanguageBytecode requires a trivially copyable Base type");
+public:
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+    /**
+     * The binary representation of a constant (values such as -0.0 and
+     * 0.0 or NaN cannot be merged by comparing their values)
+     */
+    using ConstantBits = std::array<unsigned char, sizeof(Base)>;
+protected:
+    // information from the code handler
+    std::unique_ptr<LanguageGenerationData<Base> > _info;
+    // the generated program
+    BytecodeProgram<Base> _program;
+    // the number of registers used by variables
+    size_t _nVarRegisters;
+    // maps constant values (through their bits) to their index in the constant pool
+    std::map<ConstantBits, size_t> _constantIndex;
+public:
+
+    inline LanguageBytecode() :
+            _nVarRegisters(1) {
+    }
+
+    inline virtual ~LanguageBytecode() = default;
+
+    /**
+     * Provides the last generated program.
+     */
+    inline BytecodeProgram<Base>& getProgram() {
+        return _program;
+    }
+
+    inline const BytecodeProgram<Base>& getProgram() const {
+        return _program;
+    }
+
+protected:
+
+    void generateSourceCode(std::ostream& out,
+                            std::unique_ptr<LanguageGenerationData<Base> > info) override {
+        _info = std::move(info);
+        _program = BytecodeProgram<Base>();
+        _constantIndex.clear();
+
+        const std::vector<Node*>& variableOrder = _info->variableOrder;
+        const ArrayView<CG<Base> >& dependent = _info->dependent;
+
+        /**
+         * determine the number of registers used by variables
+         */
+        size_t maxId = _info->independent.size();
+        for (size_t i = 0; i < dependent.size(); i++) {
+            const Node* node = dependent[i].getOperationNode();
+            if (node != nullptr && isRegister(*node)) {
+                maxId = std::max(maxId, getVariableID(*node));
+            }
+        }
+        for (const Node* node : variableOrder) {
+            if (isRegister(*node)) {
+                maxId = std::max(maxId, getVariableID(*node));
+            }
+        }
+        _nVarRegisters = maxId + 1;
+
+        CPPADCG_ASSERT_KNOWN(_nVarRegisters < (std::numeric_limits<std::uint32_t>::max)(),
+                             "Too many variables for a bytecode program")
+
+        /**
+         * instructions
+         */
+        std::vector<std::uint32_t>& code = _program._code;
+        code.reserve(4 * variableOrder.size());
+
+        for (const Node* node : variableOrder) {
+            pushInstruction(*node, code);
+        }
+
+        /**
+         * dependents
+         */
+        _program._dependents.resize(dependent.size());
+        for (size_t i = 0; i < dependent.size(); i++) {
+            const Node* node = dependent[i].getOperationNode();
+            if (node == nullptr) {
+                _program._dependents[i] = constantRegister(dependent[i].getValue());
+            } else if (isRegister(*node)) {
+                _program._dependents[i] = std::uint32_t(getVariableID(*node));
+            } else {
+                _program._dependents[i] = argumentRegister(dependent[i].argument());
+            }
+        }
+
+        _program._nIndependent = _info->independent.size();
+        _program._constantStart = _nVarRegisters;
+        _program._nRegisters = _nVarRegisters + _program._constants.size();
+
+        _info.reset();
+        _constantIndex.clear();
+    }
+
+    bool createsNewVariable(const Node& var,
+                            size_t totalUseCount,
+                            size_t opCount) const override {
+        // each operation writes its result into a register
+        return true;
+    }
+
+    bool requiresVariableArgument(enum CGOpCode op, size_t argIndex) const override {
+        return false;
+    }
+
+    bool requiresVariableDependencies() const override {
+        return false;
+    }
+
+    inline size_t getVariableID(const Node& node) const {
+        return _info->varId[node];
+    }
+
+    /**
+     * Whether or not the result of the operation is saved in its own register
+     */
+    inline bool isRegister(const Node& node) const {
+        size_t id = getVariableID(node);
+        return id > 0 && id != (std::numeric_limits<size_t>::max)();
+    }
+
+    inline std::uint32_t argumentRegister(const Arg& arg) {
+        const Node* node = arg.getOperation();
+        if (node == nullptr) {
+            return constantRegister(*arg.getParameter());
+        }
+
+        // aliases and print operations pass through the value of their argument
+        while (node->getOperationType() == CGOpCode::Alias ||
+               node->getOperationType() == CGOpCode::Pri) {
+            const Arg& a = node->getArguments()[0];
+            if (a.getOperation() == nullptr) {
+                return constantRegister(*a.getParameter());
+            }
+            node = a.getOperation();
+        }
+
+        CPPADCG_ASSERT_KNOWN(isRegister(*node), "Invalid operation argument in bytecode generation")
+        return std::uint32_t(getVariableID(*node));
+    }
+
+    inline std::uint32_t constantRegister(const Base& value) {
+        std::vector<Base>& constants = _program._constants;
+
+        ConstantBits bits;
+        std::memcpy(bits.data(), &value, sizeof(Base));
+
+        auto it = _constantIndex.find(bits);
+        if (it != _constantIndex.end()) {
+            return std::uint32_t(_nVarRegisters + it->second);
+        }
+
+        size_t index = constants.size();
+        constants.push_back(value);
+        _constantIndex[bits] = index;
+        return std::uint32_t(_nVarRegisters + index);
+    }
+
+    inline void pushInstruction(const Node& node,
+                                std::vector<std::uint32_t>& code) {
+        const std::vector<Arg>& args = node.getArguments();
+        CGOpCode op = node.getOperationType();
+
+        BytecodeOp bop;
+        switch (op) {
+            case CGOpCode::Assign:
+            case CGOpCode::Alias: // only added to the evaluation order when it is a dependent variable
+                bop = BytecodeOp::Copy;
+                break;
+            case CGOpCode::Abs:
+                bop = BytecodeOp::Abs;
+                break;
+            case CGOpCode::Acos:
+                bop = BytecodeOp::Acos;
+                break;
+            case CGOpCode::Acosh:
+                bop = BytecodeOp::Acosh;
+                break;
+            case CGOpCode::Asin:
+                bop = BytecodeOp::Asin;
+                break;
+            case CGOpCode::Asinh:
+                bop = BytecodeOp::Asinh;
+                break;
+            case CGOpCode::Atan:
+                bop = BytecodeOp::Atan;
+                break;
+            case CGOpCode::Atanh:
+                bop = BytecodeOp::Atanh;
+                break;
+            case CGOpCode::Cosh:
+                bop = BytecodeOp::Cosh;
+                break;
+            case CGOpCode::Cos:
+                bop = BytecodeOp::Cos;
+                break;
+            case CGOpCode::Erf:
+                bop = BytecodeOp::Erf;
+                break;
+            case CGOpCode::Erfc:
+                bop = BytecodeOp::Erfc;
+                break;
+            case CGOpCode::Exp:
+                bop = BytecodeOp::Exp;
+                break;
+            case CGOpCode::Expm1:
+                bop = BytecodeOp::Expm1;
+                break;
+            case CGOpCode::Log:
+                bop = BytecodeOp::Log;
+                break;
+            case CGOpCode::Log1p:
+                bop = BytecodeOp::Log1p;
+                break;
+            case CGOpCode::Sign:
+                bop = BytecodeOp::Sign;
+                break;
+            case CGOpCode::Sinh:
+                bop = BytecodeOp::Sinh;
+                break;
+            case CGOpCode::Sin:
+                bop = BytecodeOp::Sin;
+                break;
+            case CGOpCode::Sqrt:
+                bop = BytecodeOp::Sqrt;
+                break;
+            case CGOpCode::Tanh:
+                bop = BytecodeOp::Tanh;
+                break;
+            case CGOpCode::Tan:
+                bop = BytecodeOp::Tan;
+                break;
+            case CGOpCode::UnMinus:
+                bop = BytecodeOp::UnMinus;
+                break;
+            case CGOpCode::Add:
+                bop = BytecodeOp::Add;
+                break;
+            case CGOpCode::Sub:
+                bop = BytecodeOp::Sub;
+                break;
+            case CGOpCode::Mul:
+                bop = BytecodeOp::Mul;
+                break;
+            case CGOpCode::Div:
+                bop = BytecodeOp::Div;
+                break;
+            case CGOpCode::Pow:
+                bop = BytecodeOp::Pow;
+                break;
+            case CGOpCode::ComLt:
+                bop = BytecodeOp::CondLt;
+                break;
+            case CGOpCode::ComLe:
+                bop = BytecodeOp::CondLe;
+                break;
+            case CGOpCode::ComEq:
+                bop = BytecodeOp::CondEq;
+                break;
+            case CGOpCode::ComGe:
+                bop = BytecodeOp::CondGe;
+                break;
+            case CGOpCode::ComGt:
+                bop = BytecodeOp::CondGt;
+                break;
+            case CGOpCode::ComNe:
+                bop = BytecodeOp::CondNe;
+                break;
+            case CGOpCode::Pri: {
+                auto& pnode = static_cast<const PrintOperationNode<Base>&> (node);
+                code.push_back(std::uint32_t(BytecodeOp::Print));
+                code.push_back(argumentRegister(args[0]));
+                code.push_back(std::uint32_t(_program._printText.size()));
+                _program._printText.emplace_back(pnode.getBeforeString(), pnode.getAfterString());
+                _program._nInstructions++;
+                return;
+            }
+            default:
+                throw CGException("Operation '", op, "' is not supported by the bytecode generator");
+        }
+
+        size_t nArgs = bytecodeInstructionSize(bop) - 2;
+        CPPADCG_ASSERT_KNOWN(args.size() == nArgs, "Invalid number of arguments for bytecode instruction")
+
+        code.push_back(std::uint32_t(bop));
+        code.push_back(std::uint32_t(getVariableID(node)));
+        for (const Arg& a : args) {
+            code.push_back(argumentRegister(a));
+        }
+        _program._nInstructions++;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
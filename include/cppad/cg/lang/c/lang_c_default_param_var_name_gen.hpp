@@ -0,0 +1,57 @@
+#ifndef CPPAD_CG_LANG_C_DEFAULT_PARAM_VAR_NAME_GEN_INCLUDED
+#define CPPAD_CG_LANG_C_DEFAULT_PARAM_VAR_NAME_GEN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Creates variables names for the source code of models with dynamic
+ * parameters.
+ * The independent variables are considered to have been registered first as
+ * variables in the code generation handler and then the dynamic parameters,
+ * which are placed in an additional independent array.
+ * This object owns the wrapped variable name generator.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LangCDefaultParameterVarNameGenerator : public LangCDefaultHessianVarNameGenerator<Base> {
+protected:
+    std::unique_ptr<VariableNameGenerator<Base> > _ownedNameGen;
+public:
+
+    /**
+     * @param nameGen the variable name generator for the independent
+     *                variables
+     * @param n the number of independent variables
+     * @param paramName the array name of the dynamic parameters
+     */
+    LangCDefaultParameterVarNameGenerator(std::unique_ptr<VariableNameGenerator<Base> > nameGen,
+                                          size_t n,
+                                          const std::string& paramName = "p") :
+        LangCDefaultHessianVarNameGenerator<Base>(nameGen.get(), paramName, n),
+        _ownedNameGen(std::move(nameGen)) {
+    }
+
+    inline virtual ~LangCDefaultParameterVarNameGenerator() = default;
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
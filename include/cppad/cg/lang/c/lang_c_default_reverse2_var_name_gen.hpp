@@ -214,6 +214,12 @@ public:
                                   size_t id1,
                                   const OperationNode<Base>& indep2,
                                   size_t id2) override {
+        if (indep1.getOperationType() == CGOpCode::Inv && id1 < _minLevel1ID &&
+            indep2.getOperationType() == CGOpCode::Inv && id2 < _minLevel1ID) {
+            // the wrapped generator might use several arrays (e.g. for dynamic parameters)
+            return _nameGen->isInSameIndependentArray(indep1, id1, indep2, id2);
+        }
+
         size_t l1;
         if (indep1.getOperationType() == CGOpCode::Inv) {
             l1 = id1 < _minLevel1ID ? 0 : (id1 < _minLevel2ID ? 1 : 2);
@@ -90,60 +90,35 @@ public:
     }
 
     inline std::string generateDependent(size_t index) override {
-        _ss.clear();
-        _ss.str("");
-
-        _ss << _depName << "[" << index << "]";
-
-        return _ss.str();
+        return _depName + "[" + std::to_string(index) + "]";
     }
 
     inline std::string generateIndependent(const OperationNode<Base>& independent,
                                            size_t id) override {
-        _ss.clear();
-        _ss.str("");
-
-        _ss << _indepName << "[" << (id - 1) << "]";
-
-        return _ss.str();
+        return _indepName + "[" + std::to_string(id - 1) + "]";
     }
 
     inline std::string generateTemporary(const OperationNode<Base>& variable,
                                          size_t id) override {
-        _ss.clear();
-        _ss.str("");
-
         if (this->_temporary[0].array) {
-            _ss << _tmpName << "[" << (id - this->_minTemporaryID) << "]";
+            return _tmpName + "[" + std::to_string(id - this->_minTemporaryID) + "]";
         } else {
-            _ss << _tmpName << id;
+            return _tmpName + std::to_string(id);
         }
-
-        return _ss.str();
     }
 
     std::string generateTemporaryArray(const OperationNode<Base>& variable,
                                        size_t id) override {
-        _ss.clear();
-        _ss.str("");
-
         CPPADCG_ASSERT_UNKNOWN(variable.getOperationType() == CGOpCode::ArrayCreation)
 
-        _ss << "&" << _tmpArrayName << "[" << (id - 1) << "]";
-
-        return _ss.str();
+        return "&" + _tmpArrayName + "[" + std::to_string(id - 1) + "]";
     }
 
     std::string generateTemporarySparseArray(const OperationNode<Base>& variable,
                                              size_t id) override {
-        _ss.clear();
-        _ss.str("");
-
         CPPADCG_ASSERT_UNKNOWN(variable.getOperationType() == CGOpCode::SparseArrayCreation)
 
-        _ss << "&" << _tmpSparseArrayName << "[" << (id - 1) << "]";
-
-        return _ss.str();
+        return "&" + _tmpSparseArrayName + "[" + std::to_string(id - 1) + "]";
     }
 
     std::string generateIndexedDependent(const OperationNode<Base>& var,
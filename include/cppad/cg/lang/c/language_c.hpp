@@ -38,6 +38,8 @@ public:
 public:
     static const std::string U_INDEX_TYPE;
     static const std::string ATOMICFUN_STRUCT_DEFINITION;
+    static const std::string DIRECT_ATOMIC_FORWARD;
+    static const std::string DIRECT_ATOMIC_REVERSE;
 protected:
     static const std::string _C_COMP_OP_LT;
     static const std::string _C_COMP_OP_LE;
@@ -47,6 +49,7 @@ protected:
     static const std::string _C_COMP_OP_NE;
     static const std::string _C_STATIC_INDEX_ARRAY;
     static const std::string _C_SPARSE_INDEX_ARRAY;
+    static const std::string _C_PARAMETER_POOL;
     static const std::string _ATOMIC_TX;
     static const std::string _ATOMIC_TY;
     static const std::string _ATOMIC_PX;
@@ -110,11 +113,27 @@ protected:
     std::vector<const LoopStartOperationNode<Base>*> _currentLoops;
     // the maximum precision used to print values
     size_t _parameterPrecision;
+    // atomic functions called directly (without the atomic function callbacks)
+    std::set<std::string> _directAtomicFunctions;
+    // whether or not to use '#pragma omp simd' in loops with independent iterations
+    bool _loopSimd;
+    // whether or not to use '#pragma omp parallel for' in loops with independent iterations
+    bool _loopParallelFor;
+    // whether or not constants are saved in a static array instead of being printed in each expression
+    bool _parameterPool;
+    // whether or not the operations are performed in single precision (float)
+    bool _singlePrecision;
 private:
     std::vector<std::string> funcArgDcl_;
     std::vector<std::string> localFuncArgDcl_;
     std::string localFuncArgs_;
     std::string auxArrayName_;
+    // whether or not the temporary variable array can be copied for each thread in a parallel loop
+    bool loopTmpFirstPrivate_;
+    // the values in the static array of constants (hexadecimal literals)
+    std::vector<std::string> parameterPoolValues_;
+    // the position of each constant in the static array of constants
+    std::unordered_map<std::string, size_t> parameterPoolIndex_;
 
 public:
 
@@ -142,7 +161,12 @@ public:
         _maxAssignmentsPerFunction(0),
         _maxOperationsPerAssignment((std::numeric_limits<size_t>::max)()),
         _sources(nullptr),
-        _parameterPrecision(std::numeric_limits<Base>::digits10) {
+        _parameterPrecision(std::numeric_limits<Base>::digits10),
+        _loopSimd(false),
+        _loopParallelFor(false),
+        _parameterPool(false),
+        _singlePrecision(false),
+        loopTmpFirstPrivate_(false) {
     }
 
     inline virtual ~LanguageC() = default;
@@ -274,6 +298,162 @@ public:
         _maxOperationsPerAssignment = maxOperationsPerAssignment;
     }
 
+    /**
+     * Provides the names of the atomic functions which are called directly
+     * through the C functions <name>_atomic_forward and
+     * <name>_atomic_reverse instead of the callbacks in the LangCAtomicFun
+     * structure.
+     *
+     * @return the names of the atomic functions called directly
+     */
+    inline const std::set<std::string>& getDirectAtomicFunctions() const {
+        return _directAtomicFunctions;
+    }
+
+    /**
+     * Defines the names of the atomic functions which are called directly
+     * through the C functions <name>_atomic_forward and
+     * <name>_atomic_reverse instead of the callbacks in the LangCAtomicFun
+     * structure.
+     * These C functions must be provided elsewhere (e.g. for models in the
+     * same library by ModelLibraryCSourceGen), they have the same arguments
+     * as the callbacks except that the first argument is the LangCAtomicFun
+     * structure.
+     *
+     * @param names the names of the atomic functions to call directly
+     */
+    inline void setDirectAtomicFunctions(const std::set<std::string>& names) {
+        _directAtomicFunctions = names;
+    }
+
+    /**
+     * Whether or not loops whose iterations were proven to be independent
+     * are marked with the OpenMP SIMD directive.
+     *
+     * @return true if '#pragma omp simd' can be used in loops
+     */
+    inline bool isLoopSimd() const {
+        return _loopSimd;
+    }
+
+    /**
+     * Defines whether or not loops whose iterations were proven to be
+     * independent are marked with the OpenMP SIMD directive.
+     * Only loops which do not assign temporary variables are vectorized
+     * since the temporary variables are shared by all iterations.
+     * The directive is ignored if the source code is not compiled with
+     * OpenMP support (e.g. -fopenmp or -fopenmp-simd).
+     *
+     * @param simd true if '#pragma omp simd' can be used in loops
+     */
+    inline void setLoopSimd(bool simd) {
+        _loopSimd = simd;
+    }
+
+    /**
+     * Whether or not loops whose iterations were proven to be independent
+     * are executed by multiple threads with OpenMP.
+     *
+     * @return true if '#pragma omp parallel for' can be used in loops
+     */
+    inline bool isLoopParallelFor() const {
+        return _loopParallelFor;
+    }
+
+    /**
+     * Defines whether or not loops whose iterations were proven to be
+     * independent are executed by multiple threads with OpenMP.
+     * Each thread uses its own copy of the temporary variable array and,
+     * therefore, loops with temporary variables are only parallelized if
+     * the temporary variables are saved in an array and if the function is
+     * not split into several local functions.
+     * The source code must be compiled and linked with OpenMP support
+     * (e.g. -fopenmp).
+     *
+     * @param parallel true if '#pragma omp parallel for' can be used in loops
+     */
+    inline void setLoopParallelFor(bool parallel) {
+        _loopParallelFor = parallel;
+    }
+
+    /**
+     * Whether or not the constants used in the expressions are saved in a
+     * static array instead of being printed where they are used.
+     *
+     * @return true if the constants are saved in a static array
+     */
+    inline bool isParameterPool() const {
+        return _parameterPool;
+    }
+
+    /**
+     * Defines whether or not the constants used in the expressions are
+     * saved in a static array instead of being printed where they are used.
+     * Each distinct value is saved only once using the hexadecimal floating
+     * point format (C99) which is shorter to parse and does not lose any
+     * digits.
+     * Integer values and values which are not finite are still printed
+     * where they are used.
+     * The array is declared by generateTemporaryVariableDeclaration() and,
+     * therefore, this method must be called after the source code is
+     * generated when no function is created by this object.
+     *
+     * @param pool true if the constants are saved in a static array
+     */
+    inline void setParameterPool(bool pool) {
+        _parameterPool = pool;
+    }
+
+    /**
+     * Whether or not the operations are performed in single precision.
+     *
+     * @return true if the operations are performed with float values
+     */
+    inline bool isSinglePrecision() const {
+        return _singlePrecision;
+    }
+
+    /**
+     * Defines whether or not the operations are performed in single
+     * precision (float) while the function arguments keep the Base type.
+     * The independent variables are converted to float where they are used,
+     * the temporary variables are saved as float, the constants are
+     * printed as float literals, and the float versions of the math
+     * functions are used (C99).
+     * The dependent variables are converted back to the Base type when
+     * they are assigned.
+     * This is only meaningful when Base is double.
+     *
+     * @param singlePrecision true if the operations are performed with
+     *                        float values
+     */
+    inline void setSinglePrecision(bool singlePrecision) {
+        _singlePrecision = singlePrecision;
+    }
+
+    /**
+     * Provides the data type of the temporary variables.
+     */
+    inline const std::string& getTemporaryTypeName() const {
+        static const std::string floatType = "float"; // NOLINT(cert-err58-cpp)
+        return _singlePrecision ? floatType : _baseTypeName;
+    }
+
+    /**
+     * Prints the declarations of the C functions used to call an atomic
+     * function directly.
+     *
+     * @param out the output stream
+     * @param atomicName the atomic function name
+     */
+    static inline void printDirectAtomicFunctionDeclarations(std::ostream& out,
+                                                             const std::string& atomicName) {
+        out << "int " << atomicName << "_" << DIRECT_ATOMIC_FORWARD << "(struct LangCAtomicFun atomicFun, "
+                "int atomicIndex, int q, int p, const Array tx[], Array* ty);\n"
+               "int " << atomicName << "_" << DIRECT_ATOMIC_REVERSE << "(struct LangCAtomicFun atomicFun, "
+               "int atomicIndex, int p, const Array tx[], Array* px, const Array py[]);\n";
+    }
+
     inline std::string generateTemporaryVariableDeclaration(bool isWrapperFunction,
                                                             bool zeroArrayDependents,
                                                             const std::vector<int>& atomicMaxForward,
@@ -318,13 +498,16 @@ public:
                              "There must be two temporary variables")
 
         _ss << _spaces << "// auxiliary variables\n";
+        if (!isWrapperFunction) {
+            printParameterPoolDeclaration(_ss);
+        }
         /**
          * temporary variables
          */
         if (tmpArg[0].array) {
             size_t size = _nameGen->getMaxTemporaryVariableID() + 1 - _nameGen->getMinTemporaryVariableID();
             if (size > 0 || isWrapperFunction) {
-                _ss << _spaces << _baseTypeName << " " << tmpArg[0].name << "[" << size << "];\n";
+                _ss << _spaces << getTemporaryTypeName() << " " << tmpArg[0].name << "[" << size << "];\n";
             }
         } else if (_temporary.size() > 0) {
             for (const auto& p : _temporary) {
@@ -336,7 +519,7 @@ public:
 
             Node* var1 = _temporary.begin()->second;
             const std::string& varName1 = *var1->getName();
-            _ss << _spaces << _baseTypeName << " " << varName1;
+            _ss << _spaces << getTemporaryTypeName() << " " << varName1;
 
             typename std::map<size_t, Node*>::const_iterator it = _temporary.begin();
             for (it++; it != _temporary.end(); ++it) {
@@ -676,6 +859,8 @@ protected:
         localFuncArgs_ = "";
         auxArrayName_ = "";
         _currentLoops.clear();
+        parameterPoolValues_.clear();
+        parameterPoolIndex_.clear();
         _atomicFuncArrays.clear();
         _streamStack.clear();
         _dependentIDs.clear();
@@ -741,7 +926,11 @@ protected:
 
             localFuncArgDcl_.reserve(funcArgDcl_.size() + 4);
             localFuncArgDcl_ = funcArgDcl_;
-            localFuncArgDcl_.push_back(argumentDeclaration(tmpArg[0]));
+            if (_singlePrecision) {
+                localFuncArgDcl_.push_back(argumentDeclaration(tmpArg[0], getTemporaryTypeName()));
+            } else {
+                localFuncArgDcl_.push_back(argumentDeclaration(tmpArg[0]));
+            }
             localFuncArgDcl_.push_back(argumentDeclaration(tmpArg[1]));
             localFuncArgDcl_.push_back(argumentDeclaration(tmpArg[2]));
             localFuncArgDcl_.push_back(U_INDEX_TYPE + "* " + _C_SPARSE_INDEX_ARRAY);
@@ -755,6 +944,9 @@ protected:
 
         auxArrayName_ = tmpArg[1].name + "p";
 
+        // local functions receive the temporary array as a pointer which cannot be copied for each thread
+        loopTmpFirstPrivate_ = tmpArg[0].array && !(multiFunction && variableOrder.size() > _maxAssignmentsPerFunction);
+
         /**
          * Determine the dependent variables that result from the same operations
          */
@@ -865,6 +1057,7 @@ protected:
                                  "The temporary variables must be saved in an array in order to generate multiple functions")
 
             _code << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+            printDirectAtomicFunctionDeclarations(_code);
             // forward declarations
             std::string localFuncArgDcl2 = implode(localFuncArgDcl_, ", ");
             for (auto & localFuncName : localFuncNames) {
@@ -930,6 +1123,7 @@ protected:
                 _ss << "#include <math.h>\n"
                         "#include <stdio.h>\n\n"
                     << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+                printDirectAtomicFunctionDeclarations(_ss);
                 printFunctionDeclaration(_ss, "void", _functionName, funcArgDcl_);
                 _ss << " {\n";
                 _nameGen->customFunctionVariableDeclarations(_ss);
@@ -1037,8 +1231,31 @@ protected:
         _streamStack << ";\n";
     }
 
+    inline void printDirectAtomicFunctionDeclarations(std::ostream& out) const {
+        if (_directAtomicFunctions.empty())
+            return;
+
+        for (const std::string& name : _directAtomicFunctions) {
+            printDirectAtomicFunctionDeclarations(out, name);
+        }
+        out << "\n";
+    }
+
     virtual std::string argumentDeclaration(const FuncArgument& funcArg) const {
-        std::string dcl = _baseTypeName;
+        return argumentDeclaration(funcArg, _baseTypeName);
+    }
+
+    /**
+     * Creates the declaration of a function argument with a different
+     * type from the base type (e.g. the temporary array in single
+     * precision).
+     *
+     * @param funcArg the function argument
+     * @param typeName the type of the argument (or of its elements)
+     */
+    virtual std::string argumentDeclaration(const FuncArgument& funcArg,
+                                            const std::string& typeName) const {
+        std::string dcl = typeName;
         if (funcArg.array) {
             dcl += "*";
         }
@@ -1054,11 +1271,13 @@ protected:
         _ss << "#include <math.h>\n"
                 "#include <stdio.h>\n\n"
                 << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+        printDirectAtomicFunctionDeclarations(_ss);
         printFunctionDeclaration(_ss, "void", funcName, localFuncArgDcl_);
         _ss << " {\n";
         _nameGen->customFunctionVariableDeclarations(_ss);
         _ss << generateIndependentVariableDeclaration() << "\n";
         _ss << generateDependentVariableDeclaration() << "\n";
+        printParameterPoolDeclaration(_ss);
         size_t arraySize = _nameGen->getMaxTemporaryArrayVariableID();
         size_t sArraySize = _nameGen->getMaxTemporarySparseArrayVariableID();
         if (arraySize > 0 || sArraySize > 0) {
@@ -1086,6 +1305,8 @@ protected:
 
         _code.str("");
         _ss.str("");
+        parameterPoolValues_.clear();
+        parameterPoolIndex_.clear();
     }
 
     bool createsNewVariable(const Node& var,
@@ -1252,6 +1473,9 @@ protected:
     virtual unsigned pushExpression(Node& op) {
         if (getVariableID(op) > 0) {
             // use variable name
+            if (_singlePrecision && op.getOperationType() == CGOpCode::Inv) {
+                _streamStack << "(float) ";
+            }
             _streamStack << createVariableName(op);
             return 1;
         } else {
@@ -1506,6 +1730,10 @@ protected:
                 throw CGException("Unknown function name for operation code '", op.getOperationType(), "'.");
         }
 
+        if (_singlePrecision) {
+            _streamStack << "f"; // C99 float version
+        }
+
         _streamStack << "(";
         push(op.getArguments()[0]);
         _streamStack << ")";
@@ -1514,7 +1742,11 @@ protected:
     virtual void pushPowFunction(Node& op) {
         CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 2, "Invalid number of arguments for pow() function")
 
-        _streamStack <<powFuncName() << "(";
+        _streamStack << powFuncName();
+        if (_singlePrecision) {
+            _streamStack << "f"; // C99 float version
+        }
+        _streamStack << "(";
         push(op.getArguments()[0]);
         _streamStack << ", ";
         push(op.getArguments()[1]);
@@ -1818,11 +2050,18 @@ protected:
         printArrayStructInit(_ATOMIC_TY, *ty[p]); // also does indentation
         _ss.str("");
 
-        _streamStack << _indentation << "atomicFun.forward(atomicFun.libModel, "
-                     << atomicIndex << ", " << q << ", " << p << ", "
-                     << _ATOMIC_TX << ", &" << _ATOMIC_TY << "); // "
-                     << _info->atomicFunctionId2Name.at(id)
-                     << "\n";
+        const std::string& name = _info->atomicFunctionId2Name.at(id);
+        if (_directAtomicFunctions.find(name) != _directAtomicFunctions.end()) {
+            _streamStack << _indentation << name << "_" << DIRECT_ATOMIC_FORWARD << "(" << _atomicArgName << ", "
+                         << atomicIndex << ", " << q << ", " << p << ", "
+                         << _ATOMIC_TX << ", &" << _ATOMIC_TY << ");\n";
+        } else {
+            _streamStack << _indentation << "atomicFun.forward(atomicFun.libModel, "
+                         << atomicIndex << ", " << q << ", " << p << ", "
+                         << _ATOMIC_TX << ", &" << _ATOMIC_TY << "); // "
+                         << name
+                         << "\n";
+        }
 
         /**
          * the values of ty are now changed
@@ -1866,11 +2105,18 @@ protected:
         printArrayStructInit(_ATOMIC_PX, *px[0]); // also does indentation
         _ss.str("");
 
-        _streamStack << _indentation << "atomicFun.reverse(atomicFun.libModel, "
-                     << atomicIndex << ", " << p << ", "
-                     << _ATOMIC_TX << ", &" << _ATOMIC_PX << ", " << _ATOMIC_PY << "); // "
-                     << _info->atomicFunctionId2Name.at(id)
-                     << "\n";
+        const std::string& name = _info->atomicFunctionId2Name.at(id);
+        if (_directAtomicFunctions.find(name) != _directAtomicFunctions.end()) {
+            _streamStack << _indentation << name << "_" << DIRECT_ATOMIC_REVERSE << "(" << _atomicArgName << ", "
+                         << atomicIndex << ", " << p << ", "
+                         << _ATOMIC_TX << ", &" << _ATOMIC_PX << ", " << _ATOMIC_PY << ");\n";
+        } else {
+            _streamStack << _indentation << "atomicFun.reverse(atomicFun.libModel, "
+                         << atomicIndex << ", " << p << ", "
+                         << _ATOMIC_TX << ", &" << _ATOMIC_PX << ", " << _ATOMIC_PY << "); // "
+                         << name
+                         << "\n";
+        }
 
         /**
          * the values of px are now changed
@@ -1917,6 +2163,10 @@ protected:
             iterationCount = oss.str();
         }
 
+        if (_loopSimd || _loopParallelFor) {
+            pushLoopDirectives(lnode);
+        }
+
         _streamStack << _spaces << "for("
                      << jj << " = 0; "
                      << jj << " < " << iterationCount << "; "
@@ -1924,6 +2174,37 @@ protected:
         _indentation += _spaces;
     }
 
+    /**
+     * Prints OpenMP directives for a loop if its iterations are
+     * independent.
+     *
+     * @param lnode the loop start node
+     */
+    virtual void pushLoopDirectives(const LoopStartOperationNode<Base>& lnode);
+
+    /**
+     * Determines whether or not the iterations of a loop can be executed in
+     * any order or concurrently.
+     * The iterations are considered independent if each dependent element
+     * is assigned by a single iteration and there are no temporary
+     * variables which carry values across iterations (Tmp), no nested
+     * loops, no atomic functions, and no temporary arrays.
+     *
+     * @param lnode the loop start node
+     * @param privateIndexes the names of the indexes assigned inside the
+     *                       loop which must be private to each iteration
+     * @param hasTemporaries whether or not temporary variables are assigned
+     *                       inside the loop
+     * @return true if the iterations are independent
+     */
+    virtual bool isLoopIterationIndependent(const LoopStartOperationNode<Base>& lnode,
+                                            std::vector<std::string>& privateIndexes,
+                                            bool& hasTemporaries);
+
+    static inline bool evaluate1DIndexPattern(const IndexPattern& ip,
+                                              size_t x,
+                                              long& y);
+
     virtual void pushLoopEnd(Node& node) {
         CPPADCG_ASSERT_KNOWN(node.getOperationType() == CGOpCode::LoopEnd, "Invalid node type")
 
@@ -2085,25 +2366,176 @@ protected:
     }
 
     virtual void pushParameter(const Base& value) {
-        writeParameter(value, _streamStack);
+        if (_parameterPool) {
+            char buffer[64];
+            bool pooled = _singlePrecision ?
+                          formatPooledParameter(static_cast<float>(value), buffer, sizeof(buffer)) :
+                          formatPooledParameter(value, buffer, sizeof(buffer));
+            if (pooled) {
+                auto it = parameterPoolIndex_.emplace(buffer, parameterPoolValues_.size());
+                if (it.second) {
+                    parameterPoolValues_.emplace_back(buffer);
+                }
+                _streamStack << _C_PARAMETER_POOL << "[" << it.first->second << "]";
+                return;
+            }
+        }
+
+        if (_singlePrecision) {
+            size_t precision = std::min<size_t>(_parameterPrecision, std::numeric_limits<float>::max_digits10);
+            writeParameter(value, _streamStack, precision, true);
+        } else {
+            writeParameter(value, _streamStack);
+        }
+    }
+
+    /**
+     * Prints the declaration of the static array with the constants used
+     * in the current function (if any).
+     */
+    virtual void printParameterPoolDeclaration(std::ostream& out) const {
+        if (parameterPoolValues_.empty())
+            return;
+
+        out << _spaces << "static const " << getTemporaryTypeName() << " " << _C_PARAMETER_POOL
+            << "[" << parameterPoolValues_.size() << "] = {";
+        for (size_t i = 0; i < parameterPoolValues_.size(); ++i) {
+            if (i > 0) out << ",";
+            if (i % 4 == 0) out << "\n" << _spaces << _spaces;
+            else out << " ";
+            out << parameterPoolValues_[i];
+        }
+        out << "\n" << _spaces << "};\n";
     }
 
     template<class Output>
     void writeParameter(const Base& value, Output& output) {
+        writeParameter(value, output, _parameterPrecision, false);
+    }
+
+    /**
+     * @param value the value to print
+     * @param output the destination
+     * @param precision the number of significant digits
+     * @param floatLiteral whether or not to add the float suffix ('f') to
+     *                     values with a decimal point or an exponent
+     */
+    template<class Output>
+    void writeParameter(const Base& value,
+                        Output& output,
+                        size_t precision,
+                        bool floatLiteral) {
         // make sure all digits of floating point values are printed
-        std::ostringstream os;
-        os << std::setprecision(_parameterPrecision) << value;
+        char buffer[128];
+        const char* number = buffer;
+        std::string str;
+        if (!formatParameter(value, precision, buffer, sizeof(buffer))) {
+            std::ostringstream os;
+            os << std::setprecision(precision) << value;
+            str = os.str();
+            number = str.c_str();
+        }
 
-        std::string number = os.str();
         output << number;
 
+        bool decimal = std::strpbrk(number, ".e") != nullptr;
         if (std::abs(value) > Base(0) && value != Base(1) && value != Base(-1)) {
-            if (number.find('.') == std::string::npos && number.find('e') == std::string::npos) {
+            if (!decimal) {
                 // also make sure there is always a '.' after the number in
                 // order to avoid integer overflows
                 output << '.';
+                decimal = true;
             }
         }
+
+        if (floatLiteral && decimal) {
+            output << 'f';
+        }
+    }
+
+    /**
+     * Prints a floating point value into a character buffer with the same
+     * format used by an output stream (std::setprecision) but without
+     * creating a new stream for each value.
+     *
+     * @param value the value to print
+     * @param precision the number of significant digits
+     * @param buffer the destination
+     * @param size the size of the buffer
+     * @return false if the value could not be printed into the buffer
+     *         (e.g. a Base type which is not a floating point type)
+     */
+    template<class T>
+    static inline bool formatParameter(const T& value,
+                                       size_t precision,
+                                       char* buffer,
+                                       size_t size) {
+        return false;
+    }
+
+    static inline bool formatParameter(float value,
+                                       size_t precision,
+                                       char* buffer,
+                                       size_t size) {
+        return formatParameter(double(value), precision, buffer, size);
+    }
+
+    static inline bool formatParameter(double value,
+                                       size_t precision,
+                                       char* buffer,
+                                       size_t size) {
+        int n = std::snprintf(buffer, size, "%.*g", int(precision), value);
+        return n >= 0 && size_t(n) < size;
+    }
+
+    static inline bool formatParameter(long double value,
+                                       size_t precision,
+                                       char* buffer,
+                                       size_t size) {
+        int n = std::snprintf(buffer, size, "%.*Lg", int(precision), value);
+        return n >= 0 && size_t(n) < size;
+    }
+
+    /**
+     * Prints a value which should be saved in the static array of constants
+     * using the hexadecimal floating point format.
+     *
+     * @param value the value to print
+     * @param buffer the destination
+     * @param size the size of the buffer
+     * @return false if the value should be printed where it is used
+     *         (integers, values which are not finite, and Base types which
+     *         are not floating point types)
+     */
+    template<class T>
+    inline bool formatPooledParameter(const T& value,
+                                      char* buffer,
+                                      size_t size) const {
+        return false;
+    }
+
+    inline bool formatPooledParameter(float value,
+                                      char* buffer,
+                                      size_t size) const {
+        return formatPooledParameter(double(value), buffer, size);
+    }
+
+    inline bool formatPooledParameter(double value,
+                                      char* buffer,
+                                      size_t size) const {
+        if (!std::isfinite(value) || value == std::trunc(value))
+            return false;
+        int n = std::snprintf(buffer, size, "%a", value);
+        return n >= 0 && size_t(n) < size;
+    }
+
+    inline bool formatPooledParameter(long double value,
+                                      char* buffer,
+                                      size_t size) const {
+        if (!std::isfinite(value) || value == std::trunc(value))
+            return false;
+        int n = std::snprintf(buffer, size, "%La", value);
+        return n >= 0 && size_t(n) < size;
     }
 
     virtual const std::string& getComparison(enum CGOpCode op) const {
@@ -2219,6 +2651,9 @@ const std::string LanguageC<Base>::_C_STATIC_INDEX_ARRAY = "index"; // NOLINT(ce
 template<class Base>
 const std::string LanguageC<Base>::_C_SPARSE_INDEX_ARRAY = "idx"; // NOLINT(cert-err58-cpp)
 
+template<class Base>
+const std::string LanguageC<Base>::_C_PARAMETER_POOL = "cst"; // NOLINT(cert-err58-cpp)
+
 template<class Base>
 const std::string LanguageC<Base>::_ATOMIC_TX = "atx"; // NOLINT(cert-err58-cpp)
 
@@ -2231,8 +2666,16 @@ const std::string LanguageC<Base>::_ATOMIC_PX = "apx"; // NOLINT(cert-err58-cpp)
 template<class Base>
 const std::string LanguageC<Base>::_ATOMIC_PY = "apy"; // NOLINT(cert-err58-cpp)
 
+template<class Base>
+const std::string LanguageC<Base>::DIRECT_ATOMIC_FORWARD = "atomic_forward"; // NOLINT(cert-err58-cpp)
+
+template<class Base>
+const std::string LanguageC<Base>::DIRECT_ATOMIC_REVERSE = "atomic_reverse"; // NOLINT(cert-err58-cpp)
+
 template<class Base>
 const std::string LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION = // NOLINT(cert-err58-cpp)
+"#ifndef CPPADCG_ATOMICFUN_STRUCT_DEFINED\n"
+"#define CPPADCG_ATOMICFUN_STRUCT_DEFINED\n"
 "typedef struct Array {\n"
 "    void* data;\n"
 "    " + U_INDEX_TYPE + " size;\n"
@@ -2255,7 +2698,8 @@ const std::string LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION = // NOLINT(cert-
 "                   const Array tx[],\n"
 "                   Array* px,\n"
 "                   const Array py[]);\n"
-"};";
+"};\n"
+"#endif";
 
 } // END cg namespace
 } // END CppAD namespace
@@ -172,6 +172,163 @@ inline size_t LanguageC<Base>::printLoopIndexedDepsUsingLoop(const std::vector<O
     return i - 1;
 }
 
+template<class Base>
+void LanguageC<Base>::pushLoopDirectives(const LoopStartOperationNode<Base>& lnode) {
+    std::vector<std::string> privateIndexes;
+    bool hasTemporaries;
+    if (!isLoopIterationIndependent(lnode, privateIndexes, hasTemporaries))
+        return;
+
+    // temporary variables are shared by all the SIMD lanes
+    bool simd = _loopSimd && !hasTemporaries;
+    bool parallel = _loopParallelFor && (!hasTemporaries || loopTmpFirstPrivate_);
+
+    if (!simd && !parallel)
+        return;
+
+    _streamStack << "#pragma omp";
+    if (parallel)
+        _streamStack << " parallel for";
+    if (simd)
+        _streamStack << " simd";
+    if (parallel && hasTemporaries)
+        _streamStack << " firstprivate(" << _nameGen->getTemporary()[0].name << ")";
+    if (!privateIndexes.empty()) {
+        _streamStack << " private(";
+        for (size_t i = 0; i < privateIndexes.size(); ++i) {
+            if (i > 0) _streamStack << ", ";
+            _streamStack << privateIndexes[i];
+        }
+        _streamStack << ")";
+    }
+    _streamStack << "\n";
+}
+
+template<class Base>
+bool LanguageC<Base>::isLoopIterationIndependent(const LoopStartOperationNode<Base>& lnode,
+                                                  std::vector<std::string>& privateIndexes,
+                                                  bool& hasTemporaries) {
+    privateIndexes.clear();
+    hasTemporaries = false;
+
+    if (lnode.getIterationCountNode() != nullptr)
+        return false; // the number of iterations is only known at runtime
+
+    const size_t iterationCount = lnode.getIterationCount();
+    if (iterationCount < 2)
+        return false;
+
+    const std::vector<Node*>& variableOrder = _info->variableOrder;
+    auto it = std::find(variableOrder.begin(), variableOrder.end(), &lnode);
+    if (it == variableOrder.end())
+        return false;
+
+    const OperationNode<Base>* loopIndex = &lnode.getIndex();
+
+    // the iteration which assigns each dependent element
+    std::map<long, size_t> assigned;
+
+    for (++it; it != variableOrder.end(); ++it) {
+        const Node& node = **it;
+
+        switch (node.getOperationType()) {
+            case CGOpCode::LoopEnd:
+                return &static_cast<const LoopEndOperationNode<Base>&> (node).getLoopStart() == &lnode;
+
+            case CGOpCode::LoopIndexedDep:
+            {
+                const std::vector<Argument<Base> >& args = node.getArguments();
+                if (args.size() != 2)
+                    return false; // not a 1D index pattern
+
+                const OperationNode<Base>* value = args[0].getOperation();
+                if (value != nullptr && value->getOperationType() == CGOpCode::ArrayElement)
+                    return false;
+
+                const OperationNode<Base>* index = args[1].getOperation();
+                if (index == nullptr || index->getOperationType() != CGOpCode::Index ||
+                    &static_cast<const IndexOperationNode<Base>*> (index)->getIndex() != loopIndex)
+                    return false; // not defined directly by the loop index
+
+                const IndexPattern* ip = _info->loopDependentIndexPatterns[node.getInfo()[0]];
+                for (size_t x = 0; x < iterationCount; ++x) {
+                    long y;
+                    if (!evaluate1DIndexPattern(*ip, x, y))
+                        return false;
+
+                    auto itAssign = assigned.emplace(y, x);
+                    if (!itAssign.second && itAssign.first->second != x)
+                        return false; // the same element is assigned by different iterations
+                }
+                break;
+            }
+            case CGOpCode::IndexAssign:
+            {
+                const std::string& name = *static_cast<const IndexAssignOperationNode<Base>&> (node).getIndex().getName();
+                if (std::find(privateIndexes.begin(), privateIndexes.end(), name) == privateIndexes.end())
+                    privateIndexes.push_back(name);
+                break;
+            }
+            case CGOpCode::IndexCondExpr:
+            case CGOpCode::StartIf:
+            case CGOpCode::ElseIf:
+            case CGOpCode::Else:
+            case CGOpCode::EndIf:
+                break;
+
+            case CGOpCode::LoopStart:
+            case CGOpCode::Tmp:
+            case CGOpCode::TmpDcl:
+            case CGOpCode::LoopIndexedTmp:
+            case CGOpCode::AtomicForward:
+            case CGOpCode::AtomicReverse:
+            case CGOpCode::ArrayCreation:
+            case CGOpCode::SparseArrayCreation:
+            case CGOpCode::ArrayElement:
+            case CGOpCode::DependentRefRhs:
+            case CGOpCode::DependentMultiAssign:
+                return false;
+
+            default:
+                hasTemporaries = true;
+        }
+    }
+
+    return false;
+}
+
+template<class Base>
+inline bool LanguageC<Base>::evaluate1DIndexPattern(const IndexPattern& ip,
+                                                    size_t x,
+                                                    long& y) {
+    switch (ip.getType()) {
+        case IndexPatternType::Linear:
+            y = static_cast<const LinearIndexPattern&> (ip).evaluate(long(x));
+            return true;
+
+        case IndexPatternType::Sectioned:
+        {
+            const std::map<size_t, IndexPattern*>& sections = static_cast<const SectionedIndexPattern&> (ip).getLinearSections();
+            auto its = sections.upper_bound(x);
+            if (its == sections.begin())
+                return false;
+            --its;
+            return evaluate1DIndexPattern(*its->second, x, y);
+        }
+        case IndexPatternType::Random1D:
+        {
+            const std::map<size_t, size_t>& values = static_cast<const Random1DIndexPattern&> (ip).getValues();
+            auto itv = values.find(x);
+            if (itv == values.end())
+                return false;
+            y = long(itv->second);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
 
 } // END cg namespace
 } // END CppAD namespace
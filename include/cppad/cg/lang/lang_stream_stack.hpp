@@ -96,8 +96,8 @@ public:
         return *node;
     }
 
-    friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, std::string text) {
-        if (lss._it == lss._cache.before_begin()) {
+    friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, std::string&& text) {
+        if (lss.isDirect()) {
             lss._out << text;
         } else {
             lss._it = lss._cache.emplace_after(lss._it, std::move(text));
@@ -105,32 +105,55 @@ public:
         return lss;
     }
 
+    friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, const std::string& text) {
+        if (lss.isDirect()) {
+            lss._out << text;
+        } else {
+            lss._it = lss._cache.emplace_after(lss._it, text);
+        }
+        return lss;
+    }
+
+    friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, const char* text) {
+        if (lss.isDirect()) {
+            lss._out << text;
+        } else {
+            lss._it = lss._cache.emplace_after(lss._it, std::string(text));
+        }
+        return lss;
+    }
+
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, int i) {
-        return (lss << std::to_string(i));
+        return lss.write(i);
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, long int i) {
-        return (lss << std::to_string(i));
+        return lss.write(i);
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, long long int i) {
-        return (lss << std::to_string(i));
+        return lss.write(i);
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, unsigned int i) {
-        return (lss << std::to_string(i));
+        return lss.write(i);
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, long unsigned int i) {
-        return (lss << std::to_string(i));
+        return lss.write(i);
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, long long unsigned int i) {
-        return (lss << std::to_string(i));
+        return lss.write(i);
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, char text) {
-        return (lss << std::string(1, text));
+        if (lss.isDirect()) {
+            lss._out << text;
+        } else {
+            lss._it = lss._cache.emplace_after(lss._it, std::string(1, text));
+        }
+        return lss;
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, OperationNode<Base>& node) {
@@ -138,6 +161,26 @@ public:
 
         return lss;
     }
+
+private:
+
+    /**
+     * Whether or not text can be sent directly to the output stream
+     * (there are no pending operation nodes before the insertion point).
+     */
+    inline bool isDirect() const {
+        return _it == _cache.before_begin();
+    }
+
+    template<class T>
+    inline LangStreamStack<Base>& write(T i) {
+        if (isDirect()) {
+            _out << i;
+        } else {
+            _it = _cache.emplace_after(_it, std::to_string(i));
+        }
+        return *this;
+    }
 };
 
 } // END cg namespace
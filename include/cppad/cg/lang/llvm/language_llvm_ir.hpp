@@ -0,0 +1,400 @@
+#ifndef CPPAD_CG_LANGUAGE_LLVM_IR_INCLUDED
+#define CPPAD_CG_LANGUAGE_LLVM_IR_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Floating point types which can be used in LLVM IR generated by
+ * LanguageLlvmIr.
+ */
+template<class Base>
+class LlvmIrBaseType;
+
+template<>
+class LlvmIrBaseType<double> {
+public:
+    static inline llvm::Type* get(llvm::LLVMContext& context) {
+        return llvm::Type::getDoubleTy(context);
+    }
+
+    /**
+     * The suffix of the C math library functions for this type
+     */
+    static inline const char* getMathSuffix() {
+        return "";
+    }
+};
+
+template<>
+class LlvmIrBaseType<float> {
+public:
+    static inline llvm::Type* get(llvm::LLVMContext& context) {
+        return llvm::Type::getFloatTy(context);
+    }
+
+    static inline const char* getMathSuffix() {
+        return "f";
+    }
+};
+
+/**
+ * Creates LLVM IR directly from the operation graph of a CodeHandler
+ * using an IRBuilder (no C source code is generated and parsed by Clang).
+ *
+ * Each call to CodeHandler::generateCode() adds a new function to the
+ * module with the signature:
+ * @code
+ * void name(const Base* x, const Base* w, Base* y)
+ * @endcode
+ * where the first independent variables are read from @c x and the
+ * remaining ones from @c w (e.g. the multipliers of a Hessian).
+ * The dependent variables are saved in @c y.
+ *
+ * The same operations used by the bytecode generator are supported
+ * (no atomic functions, loops, or conditional blocks).
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LanguageLlvmIr : public Language<Base> {
+public:
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+    /**
+     * The name of the function used to print values (Pri operations)
+     * which must be mapped to LanguageLlvmIr::print() by the execution
+     * engine.
+     */
+    static const std::string PRINT_FUNCTION;
+protected:
+    llvm::Module& _module;
+    llvm::LLVMContext& _context;
+    // the name of the next function
+    std::string _functionName;
+    // the number of independent variables read from the first argument
+    size_t _nX;
+    // the last generated function
+    llvm::Function* _function;
+    // information from the code handler
+    std::unique_ptr<LanguageGenerationData<Base> > _info;
+    std::unique_ptr<llvm::IRBuilder<> > _builder;
+    // the values of the evaluated operations
+    std::map<const Node*, llvm::Value*> _values;
+public:
+
+    /**
+     * @param module the module where functions are created
+     * @param functionName the name of the next generated function
+     * @param nX the number of independent variables read from the first
+     *           function argument
+     */
+    inline LanguageLlvmIr(llvm::Module& module,
+                          std::string functionName,
+                          size_t nX) :
+            _module(module),
+            _context(module.getContext()),
+            _functionName(std::move(functionName)),
+            _nX(nX),
+            _function(nullptr) {
+    }
+
+    inline virtual ~LanguageLlvmIr() = default;
+
+    inline void setFunctionName(const std::string& functionName,
+                                size_t nX) {
+        _functionName = functionName;
+        _nX = nX;
+    }
+
+    inline const std::string& getFunctionName() const {
+        return _functionName;
+    }
+
+    /**
+     * Provides the last generated function.
+     */
+    inline llvm::Function* getFunction() const {
+        return _function;
+    }
+
+    /**
+     * Used by the generated code to print values.
+     */
+    static void print(const char* before,
+                      Base value,
+                      const char* after) {
+        std::cerr << before << value << after;
+    }
+
+protected:
+
+    void generateSourceCode(std::ostream& out,
+                            std::unique_ptr<LanguageGenerationData<Base> > info) override {
+        _info = std::move(info);
+        _values.clear();
+
+        CPPADCG_ASSERT_KNOWN(_module.getFunction(_functionName) == nullptr,
+                             "The LLVM module already contains a function with the same name")
+
+        llvm::Type* baseType = LlvmIrBaseType<Base>::get(_context);
+        llvm::Type* basePtrType = baseType->getPointerTo();
+
+        llvm::FunctionType* funcType = llvm::FunctionType::get(llvm::Type::getVoidTy(_context),
+                                                   {basePtrType, basePtrType, basePtrType},
+                                                   false);
+        _function = llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, _functionName, &_module);
+        _function->setDoesNotThrow();
+        for (unsigned a = 0; a < 3; a++) {
+            _function->addParamAttr(a, llvm::Attribute::NoAlias);
+            _function->addParamAttr(a, llvm::Attribute::NoCapture);
+        }
+        _function->addParamAttr(0, llvm::Attribute::ReadOnly);
+        _function->addParamAttr(1, llvm::Attribute::ReadOnly);
+
+        auto itArg = _function->arg_begin();
+        llvm::Argument* x = &*itArg++;
+        llvm::Argument* w = &*itArg++;
+        llvm::Argument* y = &*itArg;
+        x->setName("x");
+        w->setName("w");
+        y->setName("y");
+
+        llvm::BasicBlock* entry = llvm::BasicBlock::Create(_context, "entry", _function);
+        _builder.reset(new llvm::IRBuilder<>(entry));
+
+        /**
+         * independent variables (unused loads are removed by the optimizer)
+         */
+        const std::vector<Node*>& independent = _info->independent;
+        for (size_t j = 0; j < independent.size(); j++) {
+            llvm::Value* ptr;
+            if (j < _nX) {
+                ptr = _builder->CreateConstInBoundsGEP1_64(x, j);
+            } else {
+                ptr = _builder->CreateConstInBoundsGEP1_64(w, j - _nX);
+            }
+            _values[independent[j]] = _builder->CreateLoad(ptr);
+        }
+
+        /**
+         * operations
+         */
+        for (const Node* node : _info->variableOrder) {
+            _values[node] = createOperation(*node);
+        }
+
+        /**
+         * dependents
+         */
+        const ArrayView<CG<Base> >& dependent = _info->dependent;
+        for (size_t i = 0; i < dependent.size(); i++) {
+            llvm::Value* v;
+            if (dependent[i].getOperationNode() == nullptr) {
+                v = constant(dependent[i].getValue());
+            } else {
+                v = argumentValue(dependent[i].argument());
+            }
+            _builder->CreateStore(v, _builder->CreateConstInBoundsGEP1_64(y, i));
+        }
+
+        _builder->CreateRetVoid();
+
+        _builder.reset();
+        _values.clear();
+        _info.reset();
+    }
+
+    bool createsNewVariable(const Node& var,
+                            size_t totalUseCount,
+                            size_t opCount) const override {
+        // each operation is an SSA value
+        return true;
+    }
+
+    bool requiresVariableArgument(enum CGOpCode op, size_t argIndex) const override {
+        return false;
+    }
+
+    bool requiresVariableDependencies() const override {
+        return false;
+    }
+
+    inline llvm::Value* constant(const Base& value) {
+        return llvm::ConstantFP::get(LlvmIrBaseType<Base>::get(_context), double(value));
+    }
+
+    inline llvm::Value* argumentValue(const Arg& arg) {
+        const Node* node = arg.getOperation();
+        if (node == nullptr) {
+            return constant(*arg.getParameter());
+        }
+
+        auto it = _values.find(node);
+        if (it != _values.end()) {
+            return it->second;
+        }
+
+        // aliases pass through the value of their argument
+        CPPADCG_ASSERT_KNOWN(node->getOperationType() == CGOpCode::Alias ||
+                             node->getOperationType() == CGOpCode::Pri,
+                             "Invalid operation argument in LLVM IR generation")
+        return argumentValue(node->getArguments()[0]);
+    }
+
+    inline llvm::Value* createOperation(const Node& node) {
+        const std::vector<Arg>& args = node.getArguments();
+        CGOpCode op = node.getOperationType();
+
+        std::vector<llvm::Value*> a(args.size());
+        for (size_t i = 0; i < args.size(); i++) {
+            a[i] = argumentValue(args[i]);
+        }
+
+        switch (op) {
+            case CGOpCode::Assign:
+            case CGOpCode::Alias: // only added to the evaluation order when it is a dependent variable
+                return a[0];
+            case CGOpCode::Abs:
+                return callIntrinsic(llvm::Intrinsic::fabs, a);
+            case CGOpCode::Acos:
+                return callMath("acos", a);
+            case CGOpCode::Acosh:
+                return callMath("acosh", a);
+            case CGOpCode::Asin:
+                return callMath("asin", a);
+            case CGOpCode::Asinh:
+                return callMath("asinh", a);
+            case CGOpCode::Atan:
+                return callMath("atan", a);
+            case CGOpCode::Atanh:
+                return callMath("atanh", a);
+            case CGOpCode::Cosh:
+                return callMath("cosh", a);
+            case CGOpCode::Cos:
+                return callIntrinsic(llvm::Intrinsic::cos, a);
+            case CGOpCode::Erf:
+                return callMath("erf", a);
+            case CGOpCode::Erfc:
+                return callMath("erfc", a);
+            case CGOpCode::Exp:
+                return callIntrinsic(llvm::Intrinsic::exp, a);
+            case CGOpCode::Expm1:
+                return callMath("expm1", a);
+            case CGOpCode::Log:
+                return callIntrinsic(llvm::Intrinsic::log, a);
+            case CGOpCode::Log1p:
+                return callMath("log1p", a);
+            case CGOpCode::Sign: {
+                // same as CppAD::sign()
+                llvm::Value* positive = _builder->CreateFCmpOGT(a[0], constant(Base(0)));
+                llvm::Value* zero = _builder->CreateFCmpOEQ(a[0], constant(Base(0)));
+                llvm::Value* notPositive = _builder->CreateSelect(zero, constant(Base(0)), constant(Base(-1)));
+                return _builder->CreateSelect(positive, constant(Base(1)), notPositive);
+            }
+            case CGOpCode::Sinh:
+                return callMath("sinh", a);
+            case CGOpCode::Sin:
+                return callIntrinsic(llvm::Intrinsic::sin, a);
+            case CGOpCode::Sqrt:
+                return callIntrinsic(llvm::Intrinsic::sqrt, a);
+            case CGOpCode::Tanh:
+                return callMath("tanh", a);
+            case CGOpCode::Tan:
+                return callMath("tan", a);
+            case CGOpCode::UnMinus:
+                return _builder->CreateFNeg(a[0]);
+            case CGOpCode::Add:
+                return _builder->CreateFAdd(a[0], a[1]);
+            case CGOpCode::Sub:
+                return _builder->CreateFSub(a[0], a[1]);
+            case CGOpCode::Mul:
+                return _builder->CreateFMul(a[0], a[1]);
+            case CGOpCode::Div:
+                return _builder->CreateFDiv(a[0], a[1]);
+            case CGOpCode::Pow:
+                return callIntrinsic(llvm::Intrinsic::pow, a);
+            case CGOpCode::ComLt:
+                return _builder->CreateSelect(_builder->CreateFCmpOLT(a[0], a[1]), a[2], a[3]);
+            case CGOpCode::ComLe:
+                return _builder->CreateSelect(_builder->CreateFCmpOLE(a[0], a[1]), a[2], a[3]);
+            case CGOpCode::ComEq:
+                return _builder->CreateSelect(_builder->CreateFCmpOEQ(a[0], a[1]), a[2], a[3]);
+            case CGOpCode::ComGe:
+                return _builder->CreateSelect(_builder->CreateFCmpOGE(a[0], a[1]), a[2], a[3]);
+            case CGOpCode::ComGt:
+                return _builder->CreateSelect(_builder->CreateFCmpOGT(a[0], a[1]), a[2], a[3]);
+            case CGOpCode::ComNe:
+                return _builder->CreateSelect(_builder->CreateFCmpUNE(a[0], a[1]), a[2], a[3]);
+            case CGOpCode::Pri: {
+                auto& pnode = static_cast<const PrintOperationNode<Base>&> (node);
+                llvm::Function* printFunc = getPrintFunction();
+                _builder->CreateCall(printFunc->getFunctionType(), printFunc,
+                                     {_builder->CreateGlobalStringPtr(pnode.getBeforeString()),
+                                      a[0],
+                                      _builder->CreateGlobalStringPtr(pnode.getAfterString())});
+                return a[0];
+            }
+            default:
+                throw CGException("Operation '", op, "' is not supported by the LLVM IR generator");
+        }
+    }
+
+    inline llvm::Value* callIntrinsic(llvm::Intrinsic::ID id,
+                                      const std::vector<llvm::Value*>& args) {
+        llvm::Function* func = llvm::Intrinsic::getDeclaration(&_module, id, {LlvmIrBaseType<Base>::get(_context)});
+        return _builder->CreateCall(func->getFunctionType(), func, args);
+    }
+
+    /**
+     * Calls a function from the C math library.
+     */
+    inline llvm::Value* callMath(const std::string& name,
+                                 const std::vector<llvm::Value*>& args) {
+        std::string fullName = name + LlvmIrBaseType<Base>::getMathSuffix();
+        llvm::Function* func = _module.getFunction(fullName);
+        if (func == nullptr) {
+            llvm::Type* baseType = LlvmIrBaseType<Base>::get(_context);
+            std::vector<llvm::Type*> argTypes(args.size(), baseType);
+            llvm::FunctionType* funcType = llvm::FunctionType::get(baseType, argTypes, false);
+            func = llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, fullName, &_module);
+            func->setDoesNotThrow();
+        }
+        return _builder->CreateCall(func->getFunctionType(), func, args);
+    }
+
+    inline llvm::Function* getPrintFunction() {
+        llvm::Function* func = _module.getFunction(PRINT_FUNCTION);
+        if (func == nullptr) {
+            llvm::Type* charPtrType = llvm::Type::getInt8PtrTy(_context);
+            llvm::FunctionType* funcType = llvm::FunctionType::get(llvm::Type::getVoidTy(_context),
+                                                       {charPtrType, LlvmIrBaseType<Base>::get(_context), charPtrType},
+                                                       false);
+            func = llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, PRINT_FUNCTION, &_module);
+        }
+        return func;
+    }
+
+};
+
+template<class Base>
+const std::string LanguageLlvmIr<Base>::PRINT_FUNCTION = "cppadcg_llvm_ir_print";
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
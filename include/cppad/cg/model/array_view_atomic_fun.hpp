@@ -0,0 +1,105 @@
+#ifndef CPPAD_CG_ARRAY_VIEW_ATOMIC_FUN_INCLUDED
+#define CPPAD_CG_ARRAY_VIEW_ATOMIC_FUN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * An atomic function which can be called by compiled models without
+ * copying values into CppAD::vector objects (as done for atomic_base).
+ * The arrays point directly to the memory used by the compiled model and
+ * sparse arrays are provided as non-zero values and their indexes.
+ *
+ * The methods have the same meaning as the equivalent methods in
+ * GenericModel.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class ArrayViewAtomicFun {
+public:
+
+    /**
+     * The name of the atomic function (must be the same name used when
+     * the model was taped).
+     */
+    virtual const std::string& getName() const = 0;
+
+    /**
+     * Zero order forward mode.
+     *
+     * @param x independent variables
+     * @param y dependent variables
+     * @return true if the evaluation succeeded
+     */
+    virtual bool ForwardZero(ArrayView<const Base> x,
+                             ArrayView<Base> y) = 0;
+
+    /**
+     * First order forward mode with a sparse direction.
+     *
+     * @param x independent variables
+     * @param tx1Nnz the number of non-zeros of the direction
+     * @param idx the indexes of the non-zeros of the direction
+     * @param tx1 the non-zero values of the direction
+     * @param ty1 the first order Taylor coefficients of the dependents
+     *            (all elements must be defined)
+     * @return true if the evaluation succeeded
+     */
+    virtual bool ForwardOne(ArrayView<const Base> x,
+                            size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                            ArrayView<Base> ty1) = 0;
+
+    /**
+     * First order reverse mode with sparse dependent partials.
+     *
+     * @param x independent variables
+     * @param px the partials of the independents
+     *           (all elements must be defined)
+     * @param pyNnz the number of non-zeros of the dependent partials
+     * @param idx the indexes of the non-zeros of the dependent partials
+     * @param py the non-zero values of the dependent partials
+     * @return true if the evaluation succeeded
+     */
+    virtual bool ReverseOne(ArrayView<const Base> x,
+                            ArrayView<Base> px,
+                            size_t pyNnz, const size_t idx[], const Base py[]) = 0;
+
+    /**
+     * Second order reverse mode with a sparse direction.
+     *
+     * @param x independent variables
+     * @param tx1Nnz the number of non-zeros of the direction
+     * @param idx the indexes of the non-zeros of the direction
+     * @param tx1 the non-zero values of the direction
+     * @param px2 second order partials of the independents
+     *            (all elements must be defined)
+     * @param py2 second order partials of the dependents
+     * @return true if the evaluation succeeded
+     */
+    virtual bool ReverseTwo(ArrayView<const Base> x,
+                            size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                            ArrayView<Base> px2,
+                            ArrayView<const Base> py2) = 0;
+
+    inline virtual ~ArrayViewAtomicFun() = default;
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
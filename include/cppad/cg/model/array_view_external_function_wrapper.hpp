@@ -0,0 +1,98 @@
+#ifndef CPPAD_CG_ARRAY_VIEW_EXTERNAL_FUNCTION_WRAPPER_INCLUDED
+#define CPPAD_CG_ARRAY_VIEW_EXTERNAL_FUNCTION_WRAPPER_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Allows compiled models to call an ArrayViewAtomicFun without copying
+ * the array values.
+ */
+template<class Base>
+class ArrayViewExternalFunctionWrapper : public ExternalFunctionWrapper<Base> {
+private:
+    ArrayViewAtomicFun<Base>* atomic_;
+public:
+
+    inline ArrayViewExternalFunctionWrapper(ArrayViewAtomicFun<Base>& atomic) :
+        atomic_(&atomic) {
+    }
+
+    inline virtual ~ArrayViewExternalFunctionWrapper() = default;
+
+    bool forward(FunctorGenericModel<Base>& libModel,
+                 int q,
+                 int p,
+                 const Array tx[],
+                 Array& ty) override {
+        CPPADCG_ASSERT_KNOWN(!tx[0].sparse, "independent array must be dense")
+        ArrayView<const Base> x(static_cast<const Base*> (tx[0].data), tx[0].size);
+
+        CPPADCG_ASSERT_KNOWN(!ty.sparse, "dependent array must be dense")
+        ArrayView<Base> y(static_cast<Base*> (ty.data), ty.size);
+
+        if (p == 0) {
+            return atomic_->ForwardZero(x, y);
+
+        } else if (p == 1) {
+            size_t tx1Nnz;
+            const size_t* idx = this->nonZeroIndexes(tx[1], tx1Nnz);
+            const Base* tx1 = static_cast<const Base*> (tx[1].data);
+
+            return atomic_->ForwardOne(x, tx1Nnz, idx, tx1, y);
+        }
+
+        return false;
+    }
+
+    bool reverse(FunctorGenericModel<Base>& libModel,
+                 int p,
+                 const Array tx[],
+                 Array& px,
+                 const Array py[]) override {
+        CPPADCG_ASSERT_KNOWN(!tx[0].sparse, "independent array must be dense")
+        ArrayView<const Base> x(static_cast<const Base*> (tx[0].data), tx[0].size);
+
+        CPPADCG_ASSERT_KNOWN(!px.sparse, "independent partials array must be dense")
+        ArrayView<Base> pxb(static_cast<Base*> (px.data), px.size);
+
+        if (p == 0) {
+            size_t pyNnz;
+            const size_t* idx = this->nonZeroIndexes(py[0], pyNnz);
+            const Base* pyb = static_cast<const Base*> (py[0].data);
+
+            return atomic_->ReverseOne(x, pxb, pyNnz, idx, pyb);
+
+        } else if (p == 1) {
+            size_t tx1Nnz;
+            const size_t* idx = this->nonZeroIndexes(tx[1], tx1Nnz);
+            const Base* tx1 = static_cast<const Base*> (tx[1].data);
+            CPPADCG_ASSERT_KNOWN(!py[1].sparse, "dependent partials array must be dense")
+            ArrayView<const Base> py2(static_cast<const Base*> (py[1].data), py[1].size);
+
+            return atomic_->ReverseTwo(x, tx1Nnz, idx, tx1, pxb, py2);
+        }
+
+        return false;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
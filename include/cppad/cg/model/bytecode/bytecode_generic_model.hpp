@@ -0,0 +1,587 @@
+#ifndef CPPAD_CG_BYTECODE_GENERIC_MODEL_INCLUDED
+#define CPPAD_CG_BYTECODE_GENERIC_MODEL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A model evaluated by a bytecode interpreter which does not require a
+ * compiler.
+ * The operation graphs are the same ones used by ModelCSourceGen to
+ * generate C source code, however, only the zero order forward mode,
+ * the sparse Jacobian, and the sparse Hessian are available.
+ * Models with atomic functions or loops are not supported.
+ *
+ * This class is not thread-safe and it should not be used simultaneously in
+ * different threads.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class BytecodeGenericModel : public GenericModel<Base> {
+public:
+    using CGBase = CG<Base>;
+protected:
+    /// the model name
+    const std::string _name;
+    size_t _m;
+    size_t _n;
+    // the programs (null if not available)
+    std::unique_ptr<BytecodeProgram<Base> > _zero;
+    std::unique_ptr<BytecodeProgram<Base> > _sparseJacobian;
+    std::unique_ptr<BytecodeProgram<Base> > _sparseHessian;
+    // registers used by each program
+    std::vector<Base> _zeroReg;
+    std::vector<Base> _jacReg;
+    std::vector<Base> _hessReg;
+    // sparsity
+    bool _jacSparsityAvailable;
+    std::vector<size_t> _jacRows;
+    std::vector<size_t> _jacCols;
+    bool _hessSparsityAvailable;
+    std::vector<size_t> _hessRows;
+    std::vector<size_t> _hessCols;
+    std::vector<std::vector<size_t> > _eqHessRows;
+    std::vector<std::vector<size_t> > _eqHessCols;
+    // no atomic functions are used
+    std::vector<std::string> _atomicNames;
+    // auxiliary
+    std::vector<Base> _compressed;
+public:
+
+    /**
+     * Creates the bytecode programs for the functions requested in the
+     * source generator (zero order forward mode, sparse Jacobian, and
+     * sparse Hessian).
+     *
+     * @param modelSourceGen the source generator for the model
+     */
+    explicit BytecodeGenericModel(ModelCSourceGen<Base>& modelSourceGen) :
+            _name(modelSourceGen.getName()),
+            _m(modelSourceGen._fun.Range()),
+            _n(modelSourceGen._fun.Domain()),
+            _jacSparsityAvailable(false),
+            _hessSparsityAvailable(false) {
+
+        // loops are only created during source generation (they must not have been requested)
+        CPPADCG_ASSERT_KNOWN(modelSourceGen._relatedDepCandidates.empty() && modelSourceGen._loopTapes.empty(),
+                             "Models with loops are not supported by the bytecode interpreter")
+
+        if (modelSourceGen.isCreateForwardZero()) {
+            CodeHandler<Base> handler;
+            std::vector<CGBase> dep = modelSourceGen.prepareForward0(handler);
+            _zero = createProgram(modelSourceGen, handler, dep, "model (zero-order forward)");
+            _zero->initializeRegisters(_zeroReg);
+        }
+
+        if (modelSourceGen.isCreateSparseJacobian()) {
+            modelSourceGen.determineJacobianSparsity();
+
+            CodeHandler<Base> handler;
+            std::vector<CGBase> jac = modelSourceGen.prepareSparseJacobian(handler, modelSourceGen.isSparseJacobianForwardMode());
+            _sparseJacobian = createProgram(modelSourceGen, handler, jac, "sparse Jacobian");
+            _sparseJacobian->initializeRegisters(_jacReg);
+
+            _jacSparsityAvailable = true;
+            _jacRows = modelSourceGen._jacSparsity.rows;
+            _jacCols = modelSourceGen._jacSparsity.cols;
+        }
+
+        if (modelSourceGen.isCreateSparseHessian()) {
+            modelSourceGen.determineHessianSparsity();
+
+            CodeHandler<Base> handler;
+            std::vector<CGBase> hess = modelSourceGen.prepareSparseHessianDirectly(handler);
+            _sparseHessian = createProgram(modelSourceGen, handler, hess, "sparse Hessian");
+            _sparseHessian->initializeRegisters(_hessReg);
+
+            _hessSparsityAvailable = true;
+            _hessRows = modelSourceGen._hessSparsity.rows;
+            _hessCols = modelSourceGen._hessSparsity.cols;
+
+            const auto& hessSparsities = modelSourceGen._hessSparsities;
+            _eqHessRows.resize(hessSparsities.size());
+            _eqHessCols.resize(hessSparsities.size());
+            for (size_t i = 0; i < hessSparsities.size(); i++) {
+                _eqHessRows[i] = hessSparsities[i].rows;
+                _eqHessCols[i] = hessSparsities[i].cols;
+            }
+        }
+    }
+
+    BytecodeGenericModel(const BytecodeGenericModel&) = delete;
+    BytecodeGenericModel& operator=(const BytecodeGenericModel&) = delete;
+
+    virtual ~BytecodeGenericModel() = default;
+
+    const std::string& getName() const override {
+        return _name;
+    }
+
+    const std::vector<std::string>& getAtomicFunctionNames() override {
+        return _atomicNames;
+    }
+
+    bool addAtomicFunction(atomic_base<Base>& atomic) override {
+        return false;
+    }
+
+    bool addAtomicFunction(ArrayViewAtomicFun<Base>& atomic) override {
+        return false;
+    }
+
+    bool addExternalModel(GenericModel<Base>& atomic) override {
+        return false;
+    }
+
+    /// number of independent variables
+
+    size_t Domain() const override {
+        return _n;
+    }
+
+    /// number of dependent variables
+
+    size_t Range() const override {
+        return _m;
+    }
+
+    // Jacobian sparsity
+    bool isJacobianSparsityAvailable() override {
+        return _jacSparsityAvailable;
+    }
+
+    std::vector<bool> JacobianSparsityBool() override {
+        CPPADCG_ASSERT_KNOWN(_jacSparsityAvailable, "No Jacobian sparsity available in the bytecode model")
+
+        std::vector<bool> s;
+        loadSparsity(s, _m, _n, _jacRows, _jacCols);
+        return s;
+    }
+
+    std::vector<std::set<size_t> > JacobianSparsitySet() override {
+        CPPADCG_ASSERT_KNOWN(_jacSparsityAvailable, "No Jacobian sparsity available in the bytecode model")
+
+        std::vector<std::set<size_t> > s;
+        loadSparsity(s, _m, _n, _jacRows, _jacCols);
+        return s;
+    }
+
+    void JacobianSparsity(std::vector<size_t>& equations,
+                          std::vector<size_t>& variables) override {
+        CPPADCG_ASSERT_KNOWN(_jacSparsityAvailable, "No Jacobian sparsity available in the bytecode model")
+
+        equations = _jacRows;
+        variables = _jacCols;
+    }
+
+    // Hessian sparsity
+    bool isHessianSparsityAvailable() override {
+        return _hessSparsityAvailable;
+    }
+
+    std::vector<bool> HessianSparsityBool() override {
+        CPPADCG_ASSERT_KNOWN(_hessSparsityAvailable, "No Hessian sparsity available in the bytecode model")
+
+        std::vector<bool> s;
+        loadSparsity(s, _n, _n, _hessRows, _hessCols);
+        return s;
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet() override {
+        CPPADCG_ASSERT_KNOWN(_hessSparsityAvailable, "No Hessian sparsity available in the bytecode model")
+
+        std::vector<std::set<size_t> > s;
+        loadSparsity(s, _n, _n, _hessRows, _hessCols);
+        return s;
+    }
+
+    void HessianSparsity(std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        CPPADCG_ASSERT_KNOWN(_hessSparsityAvailable, "No Hessian sparsity available in the bytecode model")
+
+        rows = _hessRows;
+        cols = _hessCols;
+    }
+
+    bool isEquationHessianSparsityAvailable() override {
+        return !_eqHessRows.empty();
+    }
+
+    std::vector<bool> HessianSparsityBool(size_t i) override {
+        CPPADCG_ASSERT_KNOWN(i < _eqHessRows.size(), "No equation Hessian sparsity available in the bytecode model")
+
+        std::vector<bool> s;
+        loadSparsity(s, _n, _n, _eqHessRows[i], _eqHessCols[i]);
+        return s;
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet(size_t i) override {
+        CPPADCG_ASSERT_KNOWN(i < _eqHessRows.size(), "No equation Hessian sparsity available in the bytecode model")
+
+        std::vector<std::set<size_t> > s;
+        loadSparsity(s, _n, _n, _eqHessRows[i], _eqHessCols[i]);
+        return s;
+    }
+
+    void HessianSparsity(size_t i,
+                         std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        CPPADCG_ASSERT_KNOWN(i < _eqHessRows.size(), "No equation Hessian sparsity available in the bytecode model")
+
+        rows = _eqHessRows[i];
+        cols = _eqHessCols[i];
+    }
+
+    /**
+     * Zero order forward mode
+     */
+    bool isForwardZeroAvailable() override {
+        return _zero != nullptr;
+    }
+
+    using GenericModel<Base>::ForwardZero;
+
+    void ForwardZero(ArrayView<const Base> x,
+                     ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(_zero != nullptr, "No zero order forward program available in the bytecode model")
+        CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+
+        _zero->evaluate(_zeroReg, x, dep);
+    }
+
+    void ForwardZero(const std::vector<const Base*>& x,
+                     ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == 1, "The number of independent variable arrays is invalid")
+
+        ForwardZero(ArrayView<const Base>(x[0], _n), dep);
+    }
+
+    void ForwardZero(const CppAD::vector<bool>& vx,
+                     CppAD::vector<bool>& vy,
+                     ArrayView<const Base> tx,
+                     ArrayView<Base> ty) override {
+        ForwardZero(tx, ty);
+
+        if (vx.size() > 0) {
+            CPPADCG_ASSERT_KNOWN(_jacSparsityAvailable, "No Jacobian sparsity available in the bytecode model")
+            CPPADCG_ASSERT_KNOWN(vx.size() >= _n, "Invalid vx size")
+            CPPADCG_ASSERT_KNOWN(vy.size() >= _m, "Invalid vy size")
+            for (size_t e = 0; e < _jacRows.size(); e++) {
+                if (vx[_jacCols[e]]) {
+                    vy[_jacRows[e]] = true;
+                }
+            }
+        }
+    }
+
+    /**
+     * Dense Jacobian and Hessian (not available)
+     */
+    bool isJacobianAvailable() override {
+        return false;
+    }
+
+    void Jacobian(ArrayView<const Base> x,
+                  ArrayView<Base> jac) override {
+        throw CGException("Dense Jacobian not available in the bytecode model");
+    }
+
+    bool isHessianAvailable() override {
+        return false;
+    }
+
+    void Hessian(ArrayView<const Base> x,
+                 ArrayView<const Base> w,
+                 ArrayView<Base> hess) override {
+        throw CGException("Dense Hessian not available in the bytecode model");
+    }
+
+    /**
+     * Directional derivatives (not available)
+     */
+    bool isForwardOneAvailable() override {
+        return false;
+    }
+
+    void ForwardOne(ArrayView<const Base> tx,
+                    ArrayView<Base> ty) override {
+        throw CGException("First-order forward mode not available in the bytecode model");
+    }
+
+    bool isSparseForwardOneAvailable() override {
+        return false;
+    }
+
+    void ForwardOne(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> ty1) override {
+        throw CGException("First-order forward mode not available in the bytecode model");
+    }
+
+    bool isReverseOneAvailable() override {
+        return false;
+    }
+
+    void ReverseOne(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        throw CGException("First-order reverse mode not available in the bytecode model");
+    }
+
+    bool isSparseReverseOneAvailable() override {
+        return false;
+    }
+
+    void ReverseOne(ArrayView<const Base> x,
+                    ArrayView<Base> px,
+                    size_t pyNnz, const size_t idx[], const Base py[]) override {
+        throw CGException("First-order reverse mode not available in the bytecode model");
+    }
+
+    bool isReverseTwoAvailable() override {
+        return false;
+    }
+
+    void ReverseTwo(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        throw CGException("Second-order reverse mode not available in the bytecode model");
+    }
+
+    bool isSparseReverseTwoAvailable() override {
+        return false;
+    }
+
+    void ReverseTwo(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> px2,
+                    ArrayView<const Base> py2) override {
+        throw CGException("Second-order reverse mode not available in the bytecode model");
+    }
+
+    /**
+     * Sparse Jacobian
+     */
+    bool isSparseJacobianAvailable() override {
+        return _sparseJacobian != nullptr;
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac) override {
+        CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse Jacobian program available in the bytecode model")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian size")
+
+        _compressed.resize(_jacRows.size());
+        _sparseJacobian->evaluate(_jacReg, x, _compressed);
+
+        createDenseFromSparse(_compressed, _n, _jacRows, _jacCols, jac);
+    }
+
+    void SparseJacobian(const std::vector<Base>& x,
+                        std::vector<Base>& jac,
+                        std::vector<size_t>& row,
+                        std::vector<size_t>& col) override {
+        CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse Jacobian program available in the bytecode model")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+
+        jac.resize(_jacRows.size());
+        _sparseJacobian->evaluate(_jacReg, x, jac);
+
+        row = _jacRows;
+        col = _jacCols;
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse Jacobian program available in the bytecode model")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(jac.size() == _jacRows.size(), "Invalid number of non-zero elements in Jacobian")
+
+        _sparseJacobian->evaluate(_jacReg, x, jac);
+
+        *row = _jacRows.data();
+        *col = _jacCols.data();
+    }
+
+    void SparseJacobian(const std::vector<const Base*>& x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == 1, "The number of independent variable arrays is invalid")
+
+        SparseJacobian(ArrayView<const Base>(x[0], _n), jac, row, col);
+    }
+
+    /**
+     * Sparse Hessian
+     */
+    bool isSparseHessianAvailable() override {
+        return _sparseHessian != nullptr;
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess) override {
+        CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian program available in the bytecode model")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
+        CPPADCG_ASSERT_KNOWN(hess.size() == _n * _n, "Invalid Hessian size")
+
+        _compressed.resize(_hessRows.size());
+        evaluateHessian(x, w, _compressed);
+
+        createDenseFromSparse(_compressed, _n, _hessRows, _hessCols, hess);
+    }
+
+    void SparseHessian(const std::vector<Base>& x,
+                       const std::vector<Base>& w,
+                       std::vector<Base>& hess,
+                       std::vector<size_t>& row,
+                       std::vector<size_t>& col) override {
+        CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian program available in the bytecode model")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
+
+        hess.resize(_hessRows.size());
+        evaluateHessian(x, w, hess);
+
+        row = _hessRows;
+        col = _hessCols;
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian program available in the bytecode model")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
+        CPPADCG_ASSERT_KNOWN(hess.size() == _hessRows.size(), "Invalid number of non-zero elements in Hessian")
+
+        evaluateHessian(x, w, hess);
+
+        *row = _hessRows.data();
+        *col = _hessCols.data();
+    }
+
+    void SparseHessian(const std::vector<const Base*>& x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == 1, "The number of independent variable arrays is invalid")
+
+        SparseHessian(ArrayView<const Base>(x[0], _n), w, hess, row, col);
+    }
+
+    /**
+     * Provides the bytecode program for the zero order forward mode
+     * (null if not available).
+     */
+    inline const BytecodeProgram<Base>* getForwardZeroProgram() const {
+        return _zero.get();
+    }
+
+    /**
+     * Provides the bytecode program for the sparse Jacobian
+     * (null if not available).
+     */
+    inline const BytecodeProgram<Base>* getSparseJacobianProgram() const {
+        return _sparseJacobian.get();
+    }
+
+    /**
+     * Provides the bytecode program for the sparse Hessian
+     * (null if not available).
+     */
+    inline const BytecodeProgram<Base>* getSparseHessianProgram() const {
+        return _sparseHessian.get();
+    }
+
+protected:
+
+    static std::unique_ptr<BytecodeProgram<Base> > createProgram(ModelCSourceGen<Base>& modelSourceGen,
+                                                                 CodeHandler<Base>& handler,
+                                                                 std::vector<CGBase>& dep,
+                                                                 const std::string& jobName) {
+        LanguageBytecode<Base> langBytecode;
+        LangCDefaultVariableNameGenerator<Base> nameGen;
+
+        std::ostringstream code;
+        handler.generateCode(code, langBytecode, dep, nameGen, modelSourceGen._atomicFunctions, jobName);
+
+        return std::unique_ptr<BytecodeProgram<Base> >(new BytecodeProgram<Base>(std::move(langBytecode.getProgram())));
+    }
+
+    inline void evaluateHessian(ArrayView<const Base> x,
+                                ArrayView<const Base> w,
+                                ArrayView<Base> hess) {
+        // the multipliers are the independent variables created after x
+        _sparseHessian->setIndependents(_hessReg, 0, x);
+        _sparseHessian->setIndependents(_hessReg, _n, w);
+        _sparseHessian->execute(_hessReg);
+        _sparseHessian->getDependents(_hessReg, hess);
+    }
+
+    inline static void loadSparsity(std::vector<bool>& s,
+                                    size_t nrows, size_t ncols,
+                                    const std::vector<size_t>& rows,
+                                    const std::vector<size_t>& cols) {
+        s.resize(nrows * ncols, false);
+
+        for (size_t e = 0; e < rows.size(); e++) {
+            s[rows[e] * ncols + cols[e]] = true;
+        }
+    }
+
+    inline static void loadSparsity(std::vector<std::set<size_t> >& s,
+                                    size_t nrows, size_t ncols,
+                                    const std::vector<size_t>& rows,
+                                    const std::vector<size_t>& cols) {
+        s.resize(nrows);
+
+        for (size_t e = 0; e < rows.size(); e++) {
+            s[rows[e]].insert(cols[e]);
+        }
+    }
+
+    inline static void createDenseFromSparse(const std::vector<Base>& compressed,
+                                             size_t ncols,
+                                             const std::vector<size_t>& rows,
+                                             const std::vector<size_t>& cols,
+                                             ArrayView<Base> mat) {
+        mat.fill(Base(0));
+
+        for (size_t e = 0; e < compressed.size(); e++) {
+            mat[rows[e] * ncols + cols[e]] = compressed[e];
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
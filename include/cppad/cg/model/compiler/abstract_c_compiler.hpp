@@ -38,6 +38,11 @@ protected:
     std::vector<std::string> _linkFlags;
     bool _verbose;
     bool _saveToDiskFirst;
+    bool _linkTimeOptimization; // whether or not to use -flto
+    bool _objectCache; // whether or not to reuse previously compiled object files
+    std::string _cacheFolder; // path where compiled object files are cached
+    size_t _cacheHits; // number of sources which were not compiled due to the cache
+    size_t _cacheMisses; // number of sources which were compiled and added to the cache
 public:
 
     AbstractCCompiler(const std::string& compilerPath) :
@@ -45,7 +50,11 @@ public:
         _tmpFolder("cppadcg_tmp"),
         _sourcesFolder("cppadcg_sources"),
         _verbose(false),
-        _saveToDiskFirst(false) {
+        _saveToDiskFirst(false),
+        _linkTimeOptimization(false),
+        _objectCache(false),
+        _cacheHits(0),
+        _cacheMisses(0) {
     }
 
     AbstractCCompiler(const AbstractCCompiler& orig) = delete;
@@ -127,6 +136,78 @@ public:
         _compileLibFlags.push_back(compileLibFlag);
     }
 
+    /**
+     * Whether or not link-time optimization is used (-flto) so that functions
+     * in different translation units can be inlined when the library is
+     * linked.
+     */
+    bool isLinkTimeOptimization() const {
+        return _linkTimeOptimization;
+    }
+
+    /**
+     * Defines whether or not link-time optimization is used (-flto).
+     * Static libraries with these object files might require an archiver
+     * with support for the compiler's plugin (e.g. gcc-ar).
+     *
+     * @param lto true to compile and link with -flto
+     */
+    void setLinkTimeOptimization(bool lto) {
+        _linkTimeOptimization = lto;
+    }
+
+    /**
+     * Whether or not object files compiled previously for the same source
+     * code, compiler, and compilation flags are reused instead of compiling
+     * the source code again.
+     */
+    bool isObjectCacheEnabled() const {
+        return _objectCache;
+    }
+
+    /**
+     * Defines whether or not object files compiled previously for the same
+     * source code, compiler, and compilation flags are reused.
+     * Since each source file usually contains a single model function, only
+     * the functions affected by a change to a model are compiled again.
+     * Cached files are not deleted by cleanup().
+     *
+     * @param enabled true to reuse object files from the cache folder
+     */
+    void setObjectCacheEnabled(bool enabled) {
+        _objectCache = enabled;
+    }
+
+    /**
+     * Provides the folder where compiled object files are cached.
+     * By default it is a sub-folder of the temporary folder.
+     */
+    std::string getObjectCacheFolder() const {
+        if (_cacheFolder.empty())
+            return system::createPath(_tmpFolder, "cache");
+        return _cacheFolder;
+    }
+
+    void setObjectCacheFolder(const std::string& cacheFolder) {
+        _cacheFolder = cacheFolder;
+    }
+
+    /**
+     * Provides the total number of source files whose object files were
+     * reused from the cache by this compiler.
+     */
+    size_t getObjectCacheHits() const {
+        return _cacheHits;
+    }
+
+    /**
+     * Provides the total number of source files which were compiled by
+     * this compiler because they were not found in the cache.
+     */
+    size_t getObjectCacheMisses() const {
+        return _cacheMisses;
+    }
+
     bool isVerbose() const override {
         return _verbose;
     }
@@ -161,6 +242,12 @@ public:
 
         system::createFolder(this->_tmpFolder);
 
+        std::string cacheFolder;
+        if (_objectCache) {
+            cacheFolder = getObjectCacheFolder();
+            system::createFolder(cacheFolder);
+        }
+
         // determine the maximum file name length
         size_t maxsize = 0;
         std::map<std::string, std::string>::const_iterator it;
@@ -215,7 +302,17 @@ public:
                 std::cout.fill(f); // restore fill character
             }
 
-            if (_saveToDiskFirst) {
+            std::string cachedFile;
+            if (_objectCache) {
+                cachedFile = system::createPath(cacheFolder, sourceHash(it->second, posIndepCode, outputExtension) + outputExtension);
+            }
+
+            bool cached = _objectCache && isCached(cachedFile, it->second);
+            if (cached) {
+                // reuse the object file compiled previously for the same source
+                copyFile(cachedFile, file);
+                _cacheHits++;
+            } else if (_saveToDiskFirst) {
                 // save a new source file to disk
                 std::ofstream sourceFile;
                 std::string srcfile = system::createPath(_sourcesFolder, it->first);
@@ -230,13 +327,18 @@ public:
                 compileSource(it->second, file, posIndepCode);
             }
 
+            if (_objectCache && !cached) {
+                saveToCache(file, cachedFile, it->second);
+                _cacheMisses++;
+            }
+
             if (timer != nullptr) {
                 timer->finishedJob();
             } else if (_verbose) {
                 steady_clock::time_point endTime = steady_clock::now();
                 duration<float> dt = endTime - beginTime;
                 std::cout << "done [" << std::fixed << std::setprecision(3)
-                        << dt.count() << "]" << std::endl;
+                        << dt.count() << "]" << (cached ? " (cached)" : "") << std::endl;
             }
 
         }
@@ -288,6 +390,96 @@ protected:
     virtual void compileFile(const std::string& path,
                              const std::string& output,
                              bool posIndepCode) = 0;
+
+    /**
+     * Determines the name of a cached object file from the source code and
+     * everything else which affects the compilation (FNV-1a hash).
+     */
+    virtual std::string sourceHash(const std::string& source,
+                                   bool posIndepCode,
+                                   const std::string& outputExtension) const {
+        uint64_t h = 14695981039346656037ull;
+        auto add = [&h](const std::string& str) {
+            for (char c : str) {
+                h ^= uint64_t(static_cast<unsigned char>(c));
+                h *= 1099511628211ull;
+            }
+            h ^= 0xffu; // separator
+            h *= 1099511628211ull;
+        };
+
+        add(_path);
+        for (const std::string& f : _compileFlags)
+            add(f);
+        add(posIndepCode ? "pic" : "");
+        add(_linkTimeOptimization ? "lto" : "");
+        add(outputExtension);
+        add(source);
+
+        std::ostringstream os;
+        os << std::hex << std::setw(16) << std::setfill('0') << h;
+        return os.str();
+    }
+
+    /**
+     * Whether or not an object file was cached for exactly the same source
+     * code (hash collisions are detected by comparing the saved source).
+     */
+    static inline bool isCached(const std::string& cachedFile,
+                                const std::string& source) {
+        if (!system::isFile(cachedFile))
+            return false;
+
+        std::ifstream in(cachedFile + ".src", std::ios::binary);
+        if (!in)
+            return false;
+
+        std::string saved((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        return saved == source;
+    }
+
+    /**
+     * Adds a compiled object file to the cache.
+     * Files are first written with a temporary name and then renamed so
+     * that other processes sharing the cache folder never read a partially
+     * written file. The object file is renamed last since isCached() only
+     * looks for the source of existing object files.
+     */
+    static inline void saveToCache(const std::string& file,
+                                   const std::string& cachedFile,
+                                   const std::string& source) {
+        std::string tmpSuffix = ".tmp" + std::to_string(std::random_device()());
+
+        std::string tmpSource = cachedFile + ".src" + tmpSuffix;
+        {
+            std::ofstream cachedSource(tmpSource, std::ios::binary | std::ios::trunc);
+            if (!cachedSource || !(cachedSource << source)) {
+                throw CGException("Failed to write file '", tmpSource, "'");
+            }
+        }
+        renameFile(tmpSource, cachedFile + ".src");
+
+        std::string tmpFile = cachedFile + tmpSuffix;
+        copyFile(file, tmpFile);
+        renameFile(tmpFile, cachedFile);
+    }
+
+    static inline void renameFile(const std::string& from,
+                                  const std::string& to) {
+        if (std::rename(from.c_str(), to.c_str()) != 0) {
+            std::remove(from.c_str());
+            throw CGException("Failed to rename file '", from, "' to '", to, "'");
+        }
+    }
+
+    static inline void copyFile(const std::string& from,
+                                const std::string& to) {
+        std::ifstream in(from, std::ios::binary);
+        std::ofstream out(to, std::ios::binary | std::ios::trunc);
+        if (!in || !(out << in.rdbuf())) {
+            throw CGException("Failed to copy file '", from, "' to '", to, "'");
+        }
+    }
 };
 
 } // END cg namespace
@@ -59,6 +59,9 @@ public:
 
         std::vector<std::string> args;
         args.insert(args.end(), this->_compileLibFlags.begin(), this->_compileLibFlags.end());
+        if (this->_linkTimeOptimization) {
+            args.push_back("-flto"); // link-time optimization
+        }
         args.push_back(linkerFlags); // Pass suitable options to linker
         args.push_back("-o"); // Output file name
         args.push_back(library); // Output file name
@@ -96,6 +99,9 @@ protected:
         args.push_back("-x");
         args.push_back("c"); // C source files
         args.insert(args.end(), this->_compileFlags.begin(), this->_compileFlags.end());
+        if (this->_linkTimeOptimization) {
+            args.push_back("-flto");
+        }
         args.push_back("-c");
         args.push_back("-");
         if (posIndepCode) {
@@ -114,6 +120,9 @@ protected:
         args.push_back("-x");
         args.push_back("c"); // C source files
         args.insert(args.end(), this->_compileFlags.begin(), this->_compileFlags.end());
+        if (this->_linkTimeOptimization) {
+            args.push_back("-flto");
+        }
         if (posIndepCode) {
             args.push_back("-fPIC"); // position-independent code for dynamic linking
         }
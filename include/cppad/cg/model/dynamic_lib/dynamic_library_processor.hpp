@@ -132,10 +132,8 @@ public:
         const std::map<std::string, ModelCSourceGen < Base>*>&models = this->modelLibraryHelper_->getModels();
         try {
             for (const auto& p : models) {
-                const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
-
                 this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
-                compiler.compileSources(modelSources, true, this->modelLibraryHelper_);
+                compileModelSources(compiler, *p.second, true);
                 this->modelLibraryHelper_->finishedJob();
             }
 
@@ -189,10 +187,8 @@ public:
         const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
         try {
             for (const auto& p : models) {
-                const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
-
                 this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
-                compiler.compileSources(modelSources, posIndepCode, this->modelLibraryHelper_);
+                compileModelSources(compiler, *p.second, posIndepCode);
                 this->modelLibraryHelper_->finishedJob();
             }
 
@@ -223,6 +219,22 @@ protected:
 
     virtual std::unique_ptr<DynamicLib<Base>> loadDynamicLibrary();
 
+    /**
+     * Compiles the source files of a model (possibly grouped into fewer
+     * translation units).
+     */
+    inline void compileModelSources(CCompiler<Base>& compiler,
+                                    ModelCSourceGen<Base>& model,
+                                    bool posIndepCode) {
+        const std::map<std::string, std::string>& modelSources = this->getSources(model);
+
+        if (this->translationUnits_ > 0) {
+            compiler.compileSources(this->amalgamate(model, modelSources), posIndepCode, this->modelLibraryHelper_);
+        } else {
+            compiler.compileSources(modelSources, posIndepCode, this->modelLibraryHelper_);
+        }
+    }
+
 };
 
 } // END cg namespace
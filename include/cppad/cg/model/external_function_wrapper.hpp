@@ -57,6 +57,39 @@ public:
 
     inline virtual ~ExternalFunctionWrapper() {
     }
+
+protected:
+
+    /**
+     * Provides the indexes of the non-zero elements of an array without
+     * copying or densifying its values.
+     * All the elements of a dense array are considered as non-zero.
+     *
+     * @param a the array
+     * @param nnz the number of non-zero elements (output)
+     * @return the indexes of the non-zero elements
+     */
+    inline const size_t* nonZeroIndexes(const Array& a,
+                                        size_t& nnz) {
+        if (a.sparse) {
+            nnz = a.nnz;
+            return a.idx;
+        }
+
+        nnz = a.size;
+        size_t s = denseIdx_.size();
+        if (s < nnz) {
+            denseIdx_.resize(nnz);
+            for (size_t j = s; j < nnz; j++) {
+                denseIdx_[j] = j;
+            }
+        }
+        return denseIdx_.data();
+    }
+
+private:
+    /// indexes used to see dense arrays as sparse arrays
+    std::vector<size_t> denseIdx_;
 };
 
 } // END cg namespace
@@ -25,6 +25,11 @@ namespace cg {
  * A model which can be accessed through function pointers.
  * This class is not thread-safe and it should not be used simultaneously in
  * different threads.
+ * Even the methods which seem to only read from the model can modify it:
+ * all evaluations reuse the same input/output pointer arrays, and
+ * JacobianSparsityCsr(), HessianSparsityCsr(), and the ForwardZero()
+ * with dependency vectors (vx, vy) lazily create and cache the compressed
+ * sparse row patterns when the library does not provide them.
  * Multiple instances of this class for the same model from the same model
  * library object can be used simultaneously in different threads.
  *
@@ -35,6 +40,9 @@ class FunctorGenericModel : public GenericModel<Base> {
 protected:
     static constexpr const char* ERROR_LIBRARY_NOT_READY = "The model library is not ready. The model library that"
                                                            " provided this model might have been closed or deleted.";
+    static constexpr const char* ERROR_PARAMETERS_NOT_DEFINED = "The dynamic parameters of the model are not defined."
+                                                                " Use setDynamicParameters() or provide typical values"
+                                                                " to ModelCSourceGen::setTypicalDynamicParameterValues().";
 protected:
     bool _isLibraryReady;
     /// the model name
@@ -43,10 +51,19 @@ protected:
     size_t _n;
     std::vector<const Base*> _in;
     std::vector<const Base*> _inHess;
+    // the values of the dynamic parameters (the last array in _in)
+    std::vector<Base> _parameters;
+    // whether or not the values of the dynamic parameters were defined
+    bool _parametersDefined;
+    // whether or not the derivatives are evaluated in single precision
+    bool _jacobianSinglePrecision;
+    bool _hessianSinglePrecision;
     std::vector<Base*> _out;
     LangCAtomicFun _atomicFuncArg;
     std::vector<std::string> _atomicNames; // names of the atomic/external functions required by this model
     std::vector<ExternalFunctionWrapper<Base>* > _atomic;
+    // whether or not each atomic function is a model called directly by the compiled code
+    std::vector<bool> _directAtomic;
     size_t _missingAtomicFunctions;
     CppAD::vector<Base> _tx, _ty, _px, _py;
     // original model function
@@ -57,6 +74,10 @@ protected:
     int (*_reverseOne)(Base const tx[], Base const ty[], Base px[], Base const py[], LangCAtomicFun);
     // second order reverse mode
     int (*_reverseTwo)(Base const tx[], Base const ty[], Base px[], Base const py[], LangCAtomicFun);
+    // forward mode for the Taylor coefficients up to a fixed order
+    void (*_forwardTaylor)(Base const*const*, Base * const*, LangCAtomicFun);
+    // the order of the forward Taylor mode
+    size_t _forwardTaylorOrder;
     // jacobian function in the dynamic library
     void (*_jacobian)(Base const*const*, Base * const*, LangCAtomicFun);
     // hessian function in the dynamic library
@@ -89,6 +110,30 @@ protected:
             unsigned long const** row,
             unsigned long const** col,
             unsigned long * nnz);
+    // compressed sparse row Jacobian sparsity function in the dynamic library
+    void (*_jacobianSparsityCsr)(unsigned long const** rowPtr,
+            unsigned long const** col,
+            unsigned long const** elements,
+            unsigned long * nnz);
+    // compressed sparse row Hessian sparsity function in the dynamic library
+    void (*_hessianSparsityCsr)(unsigned long const** rowPtr,
+            unsigned long const** col,
+            unsigned long const** elements,
+            unsigned long * nnz);
+    // lower triangular sparse hessian function (compressed sparse row order) in the dynamic library
+    void (*_sparseHessianLower)(Base const*const*, Base * const*, LangCAtomicFun);
+    // compressed sparse row lower triangular Hessian sparsity function in the dynamic library
+    void (*_hessianLowerSparsityCsr)(unsigned long const** rowPtr,
+            unsigned long const** col,
+            unsigned long const** elements,
+            unsigned long * nnz);
+    // product of the Hessian with a block of directions in the dynamic library
+    void (*_hessianVector)(Base const*const*, Base * const*, LangCAtomicFun);
+    // the number of directions of the Hessian-vector product
+    size_t _hessianVectorDirections;
+    // compressed sparse row sparsities (lazily created, only if the library does not provide them)
+    std::vector<unsigned long> _jacRowPtr, _jacCsrCols, _jacCsrElements;
+    std::vector<unsigned long> _hessRowPtr, _hessCsrCols, _hessCsrElements;
     void (*_atomicFunctions)(const char*** names,
             unsigned long * n);
 
@@ -102,15 +147,22 @@ public:
             _n(other._n),
             _in(std::move(other._in)),
             _inHess(std::move(other._inHess)),
+            _parameters(std::move(other._parameters)),
+            _parametersDefined(other._parametersDefined),
+            _jacobianSinglePrecision(other._jacobianSinglePrecision),
+            _hessianSinglePrecision(other._hessianSinglePrecision),
             _out(std::move(other._out)),
             _atomicFuncArg{this, &atomicForward, &atomicReverse},
             _atomicNames(std::move(other._atomicNames)),
             _atomic(std::move(other._atomic)),
+            _directAtomic(std::move(other._directAtomic)),
             _missingAtomicFunctions(other._missingAtomicFunctions),
             _zero(other._zero),
             _forwardOne(other._forwardOne),
             _reverseOne(other._reverseOne),
             _reverseTwo(other._reverseTwo),
+            _forwardTaylor(other._forwardTaylor),
+            _forwardTaylorOrder(other._forwardTaylorOrder),
             _jacobian(other._jacobian),
             _hessian(other._hessian),
             _sparseForwardOne(other._sparseForwardOne),
@@ -124,6 +176,18 @@ public:
             _jacobianSparsity(other._jacobianSparsity),
             _hessianSparsity(other._hessianSparsity),
             _hessianSparsity2(other._hessianSparsity2),
+            _jacobianSparsityCsr(other._jacobianSparsityCsr),
+            _hessianSparsityCsr(other._hessianSparsityCsr),
+            _sparseHessianLower(other._sparseHessianLower),
+            _hessianLowerSparsityCsr(other._hessianLowerSparsityCsr),
+            _hessianVector(other._hessianVector),
+            _hessianVectorDirections(other._hessianVectorDirections),
+            _jacRowPtr(std::move(other._jacRowPtr)),
+            _jacCsrCols(std::move(other._jacCsrCols)),
+            _jacCsrElements(std::move(other._jacCsrElements)),
+            _hessRowPtr(std::move(other._hessRowPtr)),
+            _hessCsrCols(std::move(other._hessCsrCols)),
+            _hessCsrElements(std::move(other._hessCsrElements)),
             _atomicFunctions(other._atomicFunctions) {
 
         other._isLibraryReady = false;
@@ -156,6 +220,11 @@ public:
                 (atomic, atomic.getName());
     }
 
+    bool addAtomicFunction(ArrayViewAtomicFun<Base>& atomic) override {
+        return addExternalFunction<ArrayViewAtomicFun<Base>, ArrayViewExternalFunctionWrapper<Base> >
+                (atomic, atomic.getName());
+    }
+
     // Jacobian sparsity
     bool isJacobianSparsityAvailable() override {
         return _jacobianSparsity != nullptr;
@@ -209,6 +278,59 @@ public:
         std::copy(col, col + nnz, variables.begin());
     }
 
+    /**
+     * Provides the Jacobian sparsity pattern in the coordinate format
+     * without copying it from the dynamic library.
+     *
+     * @return a view of the Jacobian sparsity which remains valid while
+     *         the dynamic library is loaded
+     */
+    CooSparsityView JacobianSparsityCoo() {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_jacobianSparsity != nullptr, "No Jacobian sparsity function defined in the dynamic library")
+
+        unsigned long const* row, *col;
+        unsigned long nnz;
+        (*_jacobianSparsity)(&row, &col, &nnz);
+
+        return CooSparsityView{ArrayView<const unsigned long>(row, nnz),
+                               ArrayView<const unsigned long>(col, nnz)};
+    }
+
+    /**
+     * Provides the Jacobian sparsity pattern in the compressed sparse row
+     * format without copying it from the dynamic library.
+     * The pattern is only created (once) and cached in this model if the
+     * dynamic library was generated without it, and therefore this method
+     * is not reentrant.
+     *
+     * @return a view of the Jacobian sparsity which remains valid while
+     *         the dynamic library is loaded
+     */
+    CsrSparsityView JacobianSparsityCsr() {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_jacobianSparsity != nullptr, "No Jacobian sparsity function defined in the dynamic library")
+
+        if (_jacobianSparsityCsr != nullptr) {
+            unsigned long const* rowPtr, *col, *elements;
+            unsigned long nnz;
+            (*_jacobianSparsityCsr)(&rowPtr, &col, &elements, &nnz);
+
+            return CsrSparsityView{ArrayView<const unsigned long>(rowPtr, _m + 1),
+                                   ArrayView<const unsigned long>(col, nnz),
+                                   ArrayView<const unsigned long>(elements, nnz)};
+        }
+
+        if (_jacRowPtr.empty()) {
+            CooSparsityView coo = JacobianSparsityCoo();
+            createCsr(coo, _m, _jacRowPtr, _jacCsrCols, _jacCsrElements);
+        }
+
+        return CsrSparsityView{ArrayView<const unsigned long>(_jacRowPtr.data(), _jacRowPtr.size()),
+                               ArrayView<const unsigned long>(_jacCsrCols.data(), _jacCsrCols.size()),
+                               ArrayView<const unsigned long>(_jacCsrElements.data(), _jacCsrElements.size())};
+    }
+
     // Hessian sparsity
     bool isHessianSparsityAvailable() override {
         return _hessianSparsity != nullptr;
@@ -262,6 +384,99 @@ public:
         std::copy(col, col + nnz, cols.begin());
     }
 
+    /**
+     * Provides the Hessian sparsity pattern in the coordinate format
+     * without copying it from the dynamic library.
+     *
+     * @return a view of the Hessian sparsity which remains valid while
+     *         the dynamic library is loaded
+     */
+    CooSparsityView HessianSparsityCoo() {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_hessianSparsity != nullptr, "No Hessian sparsity function defined in the dynamic library")
+
+        unsigned long const* row, *col;
+        unsigned long nnz;
+        (*_hessianSparsity)(&row, &col, &nnz);
+
+        return CooSparsityView{ArrayView<const unsigned long>(row, nnz),
+                               ArrayView<const unsigned long>(col, nnz)};
+    }
+
+    /**
+     * Provides the Hessian sparsity pattern in the compressed sparse row
+     * format without copying it from the dynamic library.
+     * The pattern is only created (once) and cached in this model if the
+     * dynamic library was generated without it, and therefore this method
+     * is not reentrant.
+     *
+     * @return a view of the Hessian sparsity which remains valid while
+     *         the dynamic library is loaded
+     */
+    CsrSparsityView HessianSparsityCsr() {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_hessianSparsity != nullptr, "No Hessian sparsity function defined in the dynamic library")
+
+        if (_hessianSparsityCsr != nullptr) {
+            unsigned long const* rowPtr, *col, *elements;
+            unsigned long nnz;
+            (*_hessianSparsityCsr)(&rowPtr, &col, &elements, &nnz);
+
+            return CsrSparsityView{ArrayView<const unsigned long>(rowPtr, _n + 1),
+                                   ArrayView<const unsigned long>(col, nnz),
+                                   ArrayView<const unsigned long>(elements, nnz)};
+        }
+
+        if (_hessRowPtr.empty()) {
+            CooSparsityView coo = HessianSparsityCoo();
+            createCsr(coo, _n, _hessRowPtr, _hessCsrCols, _hessCsrElements);
+        }
+
+        return CsrSparsityView{ArrayView<const unsigned long>(_hessRowPtr.data(), _hessRowPtr.size()),
+                               ArrayView<const unsigned long>(_hessCsrCols.data(), _hessCsrCols.size()),
+                               ArrayView<const unsigned long>(_hessCsrElements.data(), _hessCsrElements.size())};
+    }
+
+    /**
+     * Provides the compressed sparse row layout of the values computed by
+     * SparseHessianLower() without copying it from the dynamic library.
+     *
+     * @return a view of the lower triangular Hessian layout which remains
+     *         valid while the dynamic library is loaded
+     */
+    CsrSparsityView HessianLowerSparsityCsr() {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_hessianLowerSparsityCsr != nullptr, "No lower triangular Hessian sparsity function defined in the dynamic library")
+
+        unsigned long const* rowPtr, *col, *elements;
+        unsigned long nnz;
+        (*_hessianLowerSparsityCsr)(&rowPtr, &col, &elements, &nnz);
+
+        return CsrSparsityView{ArrayView<const unsigned long>(rowPtr, _n + 1),
+                               ArrayView<const unsigned long>(col, nnz),
+                               ArrayView<const unsigned long>(elements, nnz)};
+    }
+
+    /**
+     * Provides the Hessian sparsity pattern of a single equation in the
+     * coordinate format without copying it from the dynamic library.
+     *
+     * @param i the equation index
+     * @return a view of the Hessian sparsity which remains valid while
+     *         the dynamic library is loaded
+     */
+    CooSparsityView HessianSparsityCoo(size_t i) {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_hessianSparsity2 != nullptr, "No Hessian sparsity function defined in the dynamic library")
+
+        unsigned long const* row, *col;
+        unsigned long nnz;
+        (*_hessianSparsity2)(i, &row, &col, &nnz);
+
+        return CooSparsityView{ArrayView<const unsigned long>(row, nnz),
+                               ArrayView<const unsigned long>(col, nnz)};
+    }
+
     bool isEquationHessianSparsityAvailable() override {
         return _hessianSparsity2 != nullptr;
     }
@@ -326,6 +541,34 @@ public:
         return _m;
     }
 
+    size_t DynamicParameterSize() const override {
+        return _parameters.size();
+    }
+
+    void setDynamicParameters(ArrayView<const Base> p) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(p.size() == _parameters.size(), "Invalid dynamic parameter array size")
+
+        std::copy(p.begin(), p.end(), _parameters.begin()); // the array pointers must remain the same
+        _parametersDefined = true;
+    }
+
+    /**
+     * Provides the values of the dynamic parameters currently used by
+     * this model.
+     */
+    inline ArrayView<const Base> getDynamicParameters() const {
+        return ArrayView<const Base>(_parameters.data(), _parameters.size());
+    }
+
+    bool isJacobianSinglePrecision() const override {
+        return _jacobianSinglePrecision;
+    }
+
+    bool isHessianSinglePrecision() const override {
+        return _hessianSinglePrecision;
+    }
+
     bool isForwardZeroAvailable() override {
         return _zero != nullptr;
     }
@@ -336,8 +579,9 @@ public:
     void ForwardZero(ArrayView<const Base> x,
                      ArrayView<Base> dep) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_zero != nullptr, "No zero order forward function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
@@ -352,14 +596,16 @@ public:
     void ForwardZero(const std::vector<const Base*> &x,
                      ArrayView<Base> dep) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_zero != nullptr, "No zero order forward function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == x.size(), "The number of independent variable arrays is invalid")
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == x.size(), "The number of independent variable arrays is invalid")
         CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
+        std::copy(x.begin(), x.end(), _in.begin());
         _out[0] = dep.data();
 
-        (*_zero)(&x[0], &_out[0], _atomicFuncArg);
+        (*_zero)(&_in[0], &_out[0], _atomicFuncArg);
     }
 
     void ForwardZero(const CppAD::vector<bool>& vx,
@@ -367,8 +613,9 @@ public:
                      ArrayView<const Base> tx,
                      ArrayView<Base> ty) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_zero != nullptr, "No zero order forward function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(tx.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(ty.size() == _m, "Invalid dependent array size")
@@ -382,10 +629,10 @@ public:
         if (vx.size() > 0) {
             CPPADCG_ASSERT_KNOWN(vx.size() >= _n, "Invalid vx size")
             CPPADCG_ASSERT_KNOWN(vy.size() >= _m, "Invalid vy size")
-            const std::vector<std::set<size_t> > jacSparsity = JacobianSparsitySet();
+            CsrSparsityView jacSparsity = JacobianSparsityCsr();
             for (size_t i = 0; i < _m; i++) {
-                for (size_t j : jacSparsity[i]) {
-                    if (vx[j]) {
+                for (size_t e = jacSparsity.rowPtr[i]; e < jacSparsity.rowPtr[i + 1]; e++) {
+                    if (vx[jacSparsity.cols[e]]) {
                         vy[i] = true;
                         break;
                     }
@@ -402,8 +649,9 @@ public:
     void Jacobian(ArrayView<const Base> x,
                   ArrayView<Base> jac) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_jacobian != nullptr, "No Jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian array size")
@@ -425,8 +673,9 @@ public:
                  ArrayView<const Base> w,
                  ArrayView<Base> hess) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_hessian != nullptr, "No Hessian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
@@ -434,7 +683,7 @@ public:
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
         _inHess[0] = x.data();
-        _inHess[1] = w.data();
+        _inHess.back() = w.data();
         _out[0] = hess.data();
 
         (*_hessian)(&_inHess[0], &_out[0], _atomicFuncArg);
@@ -449,6 +698,7 @@ public:
         const size_t k = 1;
 
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_forwardOne != nullptr, "No forward one function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(tx.size() >= (k + 1) * _n, "Invalid tx size")
         CPPADCG_ASSERT_KNOWN(ty.size() >= (k + 1) * _m, "Invalid ty size")
@@ -467,6 +717,7 @@ public:
                     size_t tx1Nnz, const size_t idx[], const Base tx1[],
                     ArrayView<Base> ty1) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_sparseForwardOne != nullptr, "No sparse forward one function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(_forwardOneSparsity != nullptr, "No forward one sparsity function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(x.size() >= _n, "Invalid x size")
@@ -490,7 +741,7 @@ public:
             size_t j = idx[ej];
             (*_forwardOneSparsity)(j, &pos, &nnz);
 
-            _inHess[1] = &tx1[ej];
+            _inHess.back() = &tx1[ej];
             int ret = (*_sparseForwardOne)(j, &_inHess[0], &_out[0], _atomicFuncArg);
 
             CPPADCG_ASSERT_KNOWN(ret == 0, "First-order forward mode failed.") // generic failure
@@ -513,6 +764,7 @@ public:
         const size_t k1 = k + 1;
 
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_reverseOne != nullptr, "No reverse one function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(tx.size() >= k1 * _n, "Invalid tx size")
         CPPADCG_ASSERT_KNOWN(ty.size() >= k1 * _m, "Invalid ty size")
@@ -533,6 +785,7 @@ public:
                     ArrayView<Base> px,
                     size_t pyNnz, const size_t idx[], const Base py[]) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_sparseReverseOne != nullptr, "No sparse reverse one function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(_reverseOneSparsity != nullptr, "No reverse one sparsity function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(x.size() >= _n, "Invalid x size")
@@ -556,7 +809,7 @@ public:
             size_t i = idx[ei];
             (*_reverseOneSparsity)(i, &pos, &nnz);
 
-            _inHess[1] = &py[ei];
+            _inHess.back() = &py[ei];
             int ret = (*_sparseReverseOne)(i, &_inHess[0], &_out[0], _atomicFuncArg);
 
             CPPADCG_ASSERT_KNOWN(ret == 0, "First-order reverse mode failed.")
@@ -579,8 +832,9 @@ public:
         const size_t k1 = k + 1;
 
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_reverseTwo != nullptr, "No sparse reverse two function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1")
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1")
         CPPADCG_ASSERT_KNOWN(tx.size() >= k1 * _n, "Invalid tx size")
         CPPADCG_ASSERT_KNOWN(ty.size() >= k1 * _m, "Invalid ty size")
         CPPADCG_ASSERT_KNOWN(px.size() >= k1 * _n, "Invalid px size")
@@ -602,6 +856,7 @@ public:
                     ArrayView<Base> px2,
                     ArrayView<const Base> py2) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_sparseReverseTwo != nullptr, "No sparse reverse two function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(_reverseTwoSparsity != nullptr, "No reverse two sparsity function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(x.size() >= _n, "Invalid x size")
@@ -619,16 +874,19 @@ public:
         _px.resize(_n);
         Base* compressed = &_px[0];
 
-        const Base * in[3];
+        // the dynamic parameters (if any) are placed after x
+        size_t d = _parameters.empty() ? 1 : 2;
+        const Base * in[4];
         in[0] = x.data();
-        in[2] = py2.data();
+        in[1] = _parameters.data();
+        in[d + 1] = py2.data();
         _out[0] = compressed;
 
         for (size_t ej = 0; ej < tx1Nnz; ej++) {
             size_t j = idx[ej];
             (*_reverseTwoSparsity)(j, &pos, &nnz);
 
-            in[1] = &tx1[ej];
+            in[d] = &tx1[ej];
             int ret = (*_sparseReverseTwo)(j, &in[0], &_out[0], _atomicFuncArg);
 
             CPPADCG_ASSERT_KNOWN(ret == 0, "Second-order reverse mode failed.") // generic failure
@@ -639,6 +897,32 @@ public:
         }
     }
 
+    bool isForwardTaylorAvailable() override {
+        return _forwardTaylor != nullptr;
+    }
+
+    size_t ForwardTaylorOrder() override {
+        return _forwardTaylorOrder;
+    }
+
+    void ForwardTaylor(ArrayView<const Base> tx,
+                       ArrayView<Base> ty) override {
+        const size_t p1 = _forwardTaylorOrder + 1;
+
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
+        CPPADCG_ASSERT_KNOWN(_forwardTaylor != nullptr, "No forward Taylor function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1")
+        CPPADCG_ASSERT_KNOWN(tx.size() == p1 * _n, "Invalid tx size")
+        CPPADCG_ASSERT_KNOWN(ty.size() == p1 * _m, "Invalid ty size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        _in[0] = tx.data();
+        _out[0] = ty.data();
+
+        (*_forwardTaylor)(&_in[0], &_out[0], _atomicFuncArg);
+    }
+
     bool isSparseJacobianAvailable() override {
         return _jacobianSparsity != nullptr && _sparseJacobian != nullptr;
     }
@@ -648,8 +932,9 @@ public:
     void SparseJacobian(ArrayView<const Base> x,
                         ArrayView<Base> jac) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian size")
@@ -681,8 +966,9 @@ public:
                         std::vector<size_t>& row,
                         std::vector<size_t>& col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse Jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
@@ -710,8 +996,9 @@ public:
                         size_t const** row,
                         size_t const** col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse Jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
@@ -737,8 +1024,9 @@ public:
                         size_t const** row,
                         size_t const** col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse Jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == x.size(), "The number of independent variable arrays is invalid")
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == x.size(), "The number of independent variable arrays is invalid")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
         unsigned long const* drow;
@@ -750,9 +1038,10 @@ public:
         *col = dcol;
 
         if (nnz > 0) {
+            std::copy(x.begin(), x.end(), _in.begin());
             _out[0] = jac.data();
 
-            (*_sparseJacobian)(&x[0], &_out[0], _atomicFuncArg);
+            (*_sparseJacobian)(&_in[0], &_out[0], _atomicFuncArg);
         }
     }
 
@@ -766,11 +1055,12 @@ public:
                        ArrayView<const Base> w,
                        ArrayView<Base> hess) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
         // CPPADCG_ASSERT_KNOWN(hess.size() == _n * _n, "Invalid Hessian size")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
@@ -781,7 +1071,7 @@ public:
         CppAD::vector<Base> compressed(nnz);
         if (nnz > 0) {
             _inHess[0] = x.data();
-            _inHess[1] = w.data();
+            _inHess.back() = w.data();
             _out[0] = &compressed[0];
 
             (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
@@ -800,10 +1090,11 @@ public:
                        std::vector<size_t>& row,
                        std::vector<size_t>& col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
@@ -820,7 +1111,7 @@ public:
             std::copy(dcol, dcol + nnz, col.begin());
 
             _inHess[0] = &x[0];
-            _inHess[1] = &w[0];
+            _inHess.back() = &w[0];
             _out[0] = &hess[0];
 
             (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
@@ -833,8 +1124,9 @@ public:
                        size_t const** row,
                        size_t const** col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
@@ -849,7 +1141,7 @@ public:
 
         if (nnz > 0) {
             _inHess[0] = x.data();
-            _inHess[1] = w.data();
+            _inHess.back() = w.data();
             _out[0] = hess.data();
 
             (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
@@ -862,8 +1154,9 @@ public:
                        size_t const** row,
                        size_t const** col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
         CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == x.size(), "The number of independent variable arrays is invalid")
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == x.size(), "The number of independent variable arrays is invalid")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
@@ -883,6 +1176,70 @@ public:
         }
     }
 
+    bool isSparseHessianLowerAvailable() override {
+        return _sparseHessianLower != nullptr;
+    }
+
+    void SparseHessianLower(ArrayView<const Base> x,
+                            ArrayView<const Base> w,
+                            ArrayView<Base> hess) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
+        CPPADCG_ASSERT_KNOWN(_sparseHessianLower != nullptr, "No lower triangular sparse Hessian function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        unsigned long const* rowPtr, *col, *elements;
+        unsigned long nnz;
+        (*_hessianLowerSparsityCsr)(&rowPtr, &col, &elements, &nnz);
+        CPPADCG_ASSERT_KNOWN(nnz == hess.size(), "Invalid number of non-zero elements in the lower triangular Hessian")
+
+        if (nnz > 0) {
+            _inHess[0] = x.data();
+            _inHess.back() = w.data();
+            _out[0] = hess.data();
+
+            (*_sparseHessianLower)(&_inHess[0], &_out[0], _atomicFuncArg);
+        }
+    }
+
+    bool isHessianVectorProductAvailable() override {
+        return _hessianVector != nullptr;
+    }
+
+    size_t HessianVectorDirections() override {
+        return _hessianVectorDirections;
+    }
+
+    void HessianVectorProduct(ArrayView<const Base> x,
+                              ArrayView<const Base> w,
+                              ArrayView<const Base> v,
+                              ArrayView<Base> hv) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_parametersDefined, ERROR_PARAMETERS_NOT_DEFINED)
+        CPPADCG_ASSERT_KNOWN(_hessianVector != nullptr, "No Hessian-vector product function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(independentArrayCount() == 1, "The number of independent variable arrays is higher than 1")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
+        CPPADCG_ASSERT_KNOWN(v.size() == _hessianVectorDirections * _n, "Invalid direction array size")
+        CPPADCG_ASSERT_KNOWN(hv.size() == _hessianVectorDirections * _n, "Invalid Hessian-vector product array size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        // the dynamic parameters (if any) are placed after x
+        size_t d = _parameters.empty() ? 1 : 2;
+        const Base* in[4];
+        in[0] = x.data();
+        in[1] = _parameters.data();
+        in[d] = v.data();
+        in[d + 1] = w.data();
+        _out[0] = hv.data();
+
+        (*_hessianVector)(&in[0], &_out[0], _atomicFuncArg);
+    }
+
 protected:
 
     /**
@@ -895,12 +1252,17 @@ protected:
         _name(std::move(name)),
         _m(0),
         _n(0),
+        _parametersDefined(true),
+        _jacobianSinglePrecision(false),
+        _hessianSinglePrecision(false),
         _atomicFuncArg{nullptr}, // not really required
         _missingAtomicFunctions(0),
         _zero(nullptr),
         _forwardOne(nullptr),
         _reverseOne(nullptr),
         _reverseTwo(nullptr),
+        _forwardTaylor(nullptr),
+        _forwardTaylorOrder(0),
         _jacobian(nullptr),
         _hessian(nullptr),
         _sparseForwardOne(nullptr),
@@ -914,6 +1276,12 @@ protected:
         _jacobianSparsity(nullptr),
         _hessianSparsity(nullptr),
         _hessianSparsity2(nullptr),
+        _jacobianSparsityCsr(nullptr),
+        _hessianSparsityCsr(nullptr),
+        _sparseHessianLower(nullptr),
+        _hessianLowerSparsityCsr(nullptr),
+        _hessianVector(nullptr),
+        _hessianVectorDirections(0),
         _atomicFunctions(nullptr) {
 
     }
@@ -950,6 +1318,48 @@ protected:
         _inHess.resize(inSize + 1);
         _out.resize(outSize);
 
+        /**
+         * Dynamic parameters (not available in older libraries)
+         */
+        void (*paramSizeFunc)(unsigned long*);
+        paramSizeFunc = reinterpret_cast<decltype(paramSizeFunc)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_DYNAMIC_PARAMETER_SIZE, false));
+        unsigned long np = 0;
+        if (paramSizeFunc != nullptr) {
+            (*paramSizeFunc)(&np);
+        }
+        _parameters.resize(np);
+        _parametersDefined = true;
+        if (np > 0) {
+            CPPADCG_ASSERT_KNOWN(inSize > 1,
+                                 "Invalid number of independent arrays received from the dynamic library.")
+            _in[inSize - 1] = _parameters.data();
+            _inHess[inSize - 1] = _parameters.data();
+
+            /**
+             * Initial values of the dynamic parameters (typical values
+             * provided when the sources were generated)
+             */
+            void (*paramValuesFunc)(Base*, int*);
+            paramValuesFunc = reinterpret_cast<decltype(paramValuesFunc)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_DYNAMIC_PARAMETER_VALUES, false));
+            int defined = 0;
+            if (paramValuesFunc != nullptr) {
+                (*paramValuesFunc)(_parameters.data(), &defined);
+            }
+            _parametersDefined = defined != 0;
+        }
+
+        /**
+         * Precision of the derivatives (not available in older libraries)
+         */
+        void (*precisionFunc)(int*, int*);
+        precisionFunc = reinterpret_cast<decltype(precisionFunc)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_DERIVATIVE_PRECISION, false));
+        if (precisionFunc != nullptr) {
+            int jacobian = 0, hessian = 0;
+            (*precisionFunc)(&jacobian, &hessian);
+            _jacobianSinglePrecision = jacobian != 0;
+            _hessianSinglePrecision = hessian != 0;
+        }
+
         CPPADCG_ASSERT_KNOWN(local == std::string(dynamicLibBaseName),
                              (std::string("Invalid data type in dynamic library. Expected '") + local
                              + "' but the library provided '" + dynamicLibBaseName + "'.").c_str())
@@ -966,6 +1376,7 @@ protected:
         _forwardOne = reinterpret_cast<decltype(_forwardOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE, false));
         _reverseOne = reinterpret_cast<decltype(_reverseOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE, false));
         _reverseTwo = reinterpret_cast<decltype(_reverseTwo)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO, false));
+        _forwardTaylor = reinterpret_cast<decltype(_forwardTaylor)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_TAYLOR, false));
         _jacobian = reinterpret_cast<decltype(_jacobian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_JACOBIAN, false));
         _hessian = reinterpret_cast<decltype(_hessian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN, false));
         _sparseForwardOne = reinterpret_cast<decltype(_sparseForwardOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE, false));
@@ -979,6 +1390,11 @@ protected:
         _jacobianSparsity = reinterpret_cast<decltype(_jacobianSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_JACOBIAN_SPARSITY, false));
         _hessianSparsity = reinterpret_cast<decltype(_hessianSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY, false));
         _hessianSparsity2 = reinterpret_cast<decltype(_hessianSparsity2)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY2, false));
+        _jacobianSparsityCsr = reinterpret_cast<decltype(_jacobianSparsityCsr)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_JACOBIAN_SPARSITY_CSR, false));
+        _hessianSparsityCsr = reinterpret_cast<decltype(_hessianSparsityCsr)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY_CSR, false));
+        _sparseHessianLower = reinterpret_cast<decltype(_sparseHessianLower)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN_LOWER, false));
+        _hessianLowerSparsityCsr = reinterpret_cast<decltype(_hessianLowerSparsityCsr)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_LOWER_SPARSITY_CSR, false));
+        _hessianVector = reinterpret_cast<decltype(_hessianVector)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_VECTOR, false));
         _atomicFunctions = reinterpret_cast<decltype(_atomicFunctions)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES, true));
 
         CPPADCG_ASSERT_KNOWN((_sparseForwardOne == nullptr) == (_forwardOneSparsity == nullptr), "Missing functions in the dynamic library")
@@ -989,6 +1405,23 @@ protected:
         CPPADCG_ASSERT_KNOWN((_sparseReverseTwo == nullptr) == (_reverseTwo == nullptr), "Missing functions in the dynamic library")
         CPPADCG_ASSERT_KNOWN((_sparseJacobian == nullptr) || (_jacobianSparsity != nullptr), "Missing functions in the dynamic library")
         CPPADCG_ASSERT_KNOWN((_sparseHessian == nullptr) || (_hessianSparsity != nullptr), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN((_sparseHessianLower == nullptr) == (_hessianLowerSparsityCsr == nullptr), "Missing functions in the dynamic library")
+
+        if (_forwardTaylor != nullptr) {
+            void (*orderFunc)(unsigned long*);
+            orderFunc = reinterpret_cast<decltype(orderFunc)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_TAYLOR_ORDER, true));
+            unsigned long p;
+            (*orderFunc)(&p);
+            _forwardTaylorOrder = p;
+        }
+
+        if (_hessianVector != nullptr) {
+            void (*directionsFunc)(unsigned long*);
+            directionsFunc = reinterpret_cast<decltype(directionsFunc)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_VECTOR_DIRECTIONS, true));
+            unsigned long k;
+            (*directionsFunc)(&k);
+            _hessianVectorDirections = k;
+        }
 
         /**
          * Prepare the atomic functions argument
@@ -998,15 +1431,19 @@ protected:
         (*_atomicFunctions)(&names, &n);
         _atomic.resize(n);
         _atomicNames.resize(n);
+        _directAtomic.resize(n);
+        _missingAtomicFunctions = 0;
         for (unsigned long i = 0; i < n; ++i) {
             _atomicNames[i] = std::string(names[i]);
+            // models in the same library can be called directly (they do not have to be provided)
+            _directAtomic[i] = loadFunction(_atomicNames[i] + "_" + LanguageC<Base>::DIRECT_ATOMIC_FORWARD, false) != nullptr;
+            if (!_directAtomic[i])
+                _missingAtomicFunctions++;
         }
 
         _atomicFuncArg.libModel = this;
         _atomicFuncArg.forward = &atomicForward;
         _atomicFuncArg.reverse = &atomicReverse;
-
-        _missingAtomicFunctions = n;
     }
 
     template <class VectorSet>
@@ -1050,12 +1487,58 @@ protected:
         }
     }
 
+    /**
+     * Creates a sparsity pattern in the compressed sparse row format from
+     * the coordinate format (elements in the same row are sorted by column).
+     */
+    inline static void createCsr(const CooSparsityView& coo,
+                                 size_t nRows,
+                                 std::vector<unsigned long>& rowPtr,
+                                 std::vector<unsigned long>& cols,
+                                 std::vector<unsigned long>& elements) {
+        size_t nnz = coo.nnz();
+
+        elements.resize(nnz);
+        for (size_t e = 0; e < nnz; e++)
+            elements[e] = e;
+        std::stable_sort(elements.begin(), elements.end(), [&coo](unsigned long a, unsigned long b) {
+            return coo.rows[a] < coo.rows[b] || (coo.rows[a] == coo.rows[b] && coo.cols[a] < coo.cols[b]);
+        });
+
+        rowPtr.assign(nRows + 1, 0);
+        cols.resize(nnz);
+        for (size_t e = 0; e < nnz; e++) {
+            cols[e] = coo.cols[elements[e]];
+            rowPtr[coo.rows[elements[e]] + 1]++;
+        }
+        for (size_t i = 0; i < nRows; i++)
+            rowPtr[i + 1] += rowPtr[i];
+    }
+
+    /**
+     * The number of arrays with independent variables (the dynamic
+     * parameters are provided to the compiled functions in an additional
+     * array).
+     */
+    inline size_t independentArrayCount() const {
+        return _parameters.empty() ? _in.size() : _in.size() - 1;
+    }
+
+    /**
+     * Whether or not the compiled zero order forward mode function can be
+     * called directly by other compiled models.
+     */
+    inline bool isDirectForwardZeroAvailable() const {
+        return _isLibraryReady && _zero != nullptr && _in.size() == 1 && _missingAtomicFunctions == 0;
+    }
+
     virtual void modelLibraryClosed() {
         _isLibraryReady = false;
         _zero = nullptr;
         _forwardOne = nullptr;
         _reverseOne = nullptr;
         _reverseTwo = nullptr;
+        _forwardTaylor = nullptr;
         _jacobian = nullptr;
         _hessian = nullptr;
         _sparseForwardOne = nullptr;
@@ -1069,6 +1552,11 @@ protected:
         _jacobianSparsity = nullptr;
         _hessianSparsity = nullptr;
         _hessianSparsity2 = nullptr;
+        _jacobianSparsityCsr = nullptr;
+        _hessianSparsityCsr = nullptr;
+        _sparseHessianLower = nullptr;
+        _hessianLowerSparsityCsr = nullptr;
+        _hessianVector = nullptr;
     }
 
 private:
@@ -1080,7 +1568,8 @@ private:
         for (size_t i = 0; i < n; i++) {
             if (name == _atomicNames[i]) {
                 if (_atomic[i] == nullptr) {
-                    _missingAtomicFunctions--;
+                    if (!_directAtomic[i])
+                        _missingAtomicFunctions--;
                 } else {
                     delete _atomic[i];
                 }
@@ -1099,6 +1588,8 @@ private:
                              Array* ty) {
         auto* libModel = static_cast<FunctorGenericModel<Base>*> (libModelIn);
         ExternalFunctionWrapper<Base>* externalFunc = libModel->_atomic[atomicIndex];
+        CPPADCG_ASSERT_KNOWN(externalFunc != nullptr, "A nested model called directly does not provide the requested "
+                                                      "forward mode (it must be provided with addExternalModel())")
 
         return externalFunc->forward(*libModel, q, p, tx, *ty);
     }
@@ -1111,6 +1602,8 @@ private:
                              const Array py[]) {
         auto* libModel = static_cast<FunctorGenericModel<Base>*> (libModelIn);
         ExternalFunctionWrapper<Base>* externalFunc = libModel->_atomic[atomicIndex];
+        CPPADCG_ASSERT_KNOWN(externalFunc != nullptr, "A nested model called directly does not provide the requested "
+                                                      "reverse mode (it must be provided with addExternalModel())")
 
         return externalFunc->reverse(*libModel, p, tx, *px, py);
     }
@@ -1118,6 +1611,7 @@ private:
     friend class LinuxDynamicLib<Base>;
 #endif
     friend class AtomicExternalFunctionWrapper<Base>;
+    friend class GenericModelExternalFunctionWrapper<Base>;
 };
 
 } // END cg namespace
@@ -135,6 +135,60 @@ public:
      */
     virtual size_t Range() const = 0;
 
+    /**
+     * Provides the number of independent dynamic parameters
+     * (see CppAD::Independent and CppAD::ADFun::new_dynamic).
+     *
+     * @return The number of dynamic parameters
+     */
+    virtual size_t DynamicParameterSize() const {
+        return 0;
+    }
+
+    /**
+     * Defines the values of the dynamic parameters used by all the
+     * following evaluations of this model.
+     * New values do not require new source code nor a new compilation.
+     * The derivatives and sparsities are always relative to the
+     * independent variables.
+     * The values are stored in the model (they are shared by all the
+     * threads evaluating it) and, therefore, this method must not be
+     * called while there are evaluations in progress.
+     * Models created without typical dynamic parameter values (see
+     * ModelCSourceGen::setTypicalDynamicParameterValues()) cannot be
+     * evaluated before this method is called.
+     *
+     * @param p The dynamic parameter values (with DynamicParameterSize()
+     *          elements)
+     */
+    virtual void setDynamicParameters(ArrayView<const Base> p) {
+        CPPADCG_ASSERT_KNOWN(p.size() == 0, "This model does not use dynamic parameters")
+    }
+
+    /**
+     * Whether or not the operations of the Jacobian related functions
+     * (Jacobian, SparseJacobian, ForwardOne, and ReverseOne) are performed
+     * in single precision.
+     * The values are still provided with the Base type but they only have
+     * the accuracy of a float.
+     *
+     * @return true if the Jacobian is evaluated with float values
+     */
+    virtual bool isJacobianSinglePrecision() const {
+        return false;
+    }
+
+    /**
+     * Whether or not the operations of the Hessian related functions
+     * (Hessian, SparseHessian, and ReverseTwo) are performed in single
+     * precision.
+     *
+     * @return true if the Hessian is evaluated with float values
+     */
+    virtual bool isHessianSinglePrecision() const {
+        return false;
+    }
+
     /**
      * The names of the atomic functions required by this model.
      * All external/atomic functions must be provided before using
@@ -157,6 +211,19 @@ public:
      */
     virtual bool addAtomicFunction(atomic_base<Base>& atomic) = 0;
 
+    /**
+     * Defines an atomic function which is called by the compiled code
+     * without copying the array values.
+     * It should match an external function name previously provided to
+     * create the source.
+     *
+     * @param atomic The atomic function. This object must only be deleted
+     *               after the model.
+     * @return true if the atomic function is required by the model, false
+     *         if it will never be used.
+     */
+    virtual bool addAtomicFunction(ArrayViewAtomicFun<Base>& atomic) = 0;
+
     /**
      * Defines a generic model to be used as an external function by the
      * compiled code.
@@ -672,6 +739,50 @@ public:
                             ArrayView<Base> px2,
                             ArrayView<const Base> py2) = 0;
 
+    /***********************************************************************
+     *                        Forward Taylor
+     **********************************************************************/
+
+    /**
+     * Determines whether or not the forward mode for the Taylor
+     * coefficients up to ForwardTaylorOrder() can be called.
+     *
+     * @return true if it is possible to evaluate the forward Taylor mode
+     */
+    virtual bool isForwardTaylorAvailable() {
+        return false;
+    }
+
+    /**
+     * The highest order of the Taylor coefficients determined by
+     * ForwardTaylor() (defined when the source code was generated).
+     *
+     * @return the order p or zero if the forward Taylor mode is not
+     *         available
+     */
+    virtual size_t ForwardTaylorOrder() {
+        return 0;
+    }
+
+    /**
+     * Computes the Taylor coefficients of the dependent variables from
+     * order zero up to order p = ForwardTaylorOrder() in a single forward
+     * mode sweep (the same as CppAD's ADFun::Forward(p, tx)).
+     * This can be used, for instance, to propagate the right-hand side of
+     * an ODE in Taylor series integrators.
+     *
+     * @param tx The Taylor coefficients of the independent variables
+     *           (tx[j * (p + 1) + k] is the order k coefficient of
+     *           variable j)
+     * @param ty The Taylor coefficients of the dependent variables
+     *           (ty[i * (p + 1) + k] is the order k coefficient of
+     *           equation i)
+     */
+    virtual void ForwardTaylor(ArrayView<const Base> tx,
+                               ArrayView<Base> ty) {
+        throw CGException("The forward Taylor mode is not available for model '", getName(), "'");
+    }
+
     /***********************************************************************
      *                        Sparse Jacobians
      **********************************************************************/
@@ -879,6 +990,80 @@ public:
                                size_t const** row,
                                size_t const** col) = 0;
 
+    /**
+     * Determines whether or not the lower triangle of the sparse weighted
+     * sum of the Hessians can be evaluated with SparseHessianLower().
+     *
+     * @return true if it is possible to evaluate the lower triangle of the
+     *         sparse weighted sum of the Hessians
+     */
+    virtual bool isSparseHessianLowerAvailable() {
+        return false;
+    }
+
+    /**
+     * Determines the lower triangle of the sparse weighted sum of the
+     * Hessians in the compressed sparse row layout defined when the source
+     * code was generated (see ModelCSourceGen::setCreateSparseHessianLower()).
+     * \f[ hess = \frac{\rm d^2  }{{\rm d} x^2 }  \sum_{i} w_i F_i (x) \f]
+     * \f[ i = 0 , \ldots , m - 1 \f]
+     *
+     * @param x The independent variables
+     * @param w The equation multipliers
+     * @param hess The values of the lower triangle of the Hessian in the
+     *             compressed sparse row order
+     */
+    virtual void SparseHessianLower(ArrayView<const Base> x,
+                                    ArrayView<const Base> w,
+                                    ArrayView<Base> hess) {
+        throw CGException("The lower triangular sparse Hessian is not available for model '", getName(), "'");
+    }
+
+    /***********************************************************************
+     *                        Hessian-vector product
+     **********************************************************************/
+
+    /**
+     * Determines whether or not the product of the weighted sum of the
+     * Hessians with a block of directions can be evaluated with
+     * HessianVectorProduct().
+     *
+     * @return true if it is possible to evaluate the Hessian-vector product
+     */
+    virtual bool isHessianVectorProductAvailable() {
+        return false;
+    }
+
+    /**
+     * The number of directions K used by HessianVectorProduct()
+     * (defined when the source code was generated).
+     *
+     * @return the number of directions or zero if the Hessian-vector
+     *         product is not available
+     */
+    virtual size_t HessianVectorDirections() {
+        return 0;
+    }
+
+    /**
+     * Determines the product of the weighted sum of the Hessians with
+     * K = HessianVectorDirections() directions without forming the Hessian.
+     * \f[ hv_k = \left( \frac{\rm d^2  }{{\rm d} x^2 } \sum_{i} w_i F_i (x) \right) v_k \f]
+     * \f[ k = 0 , \ldots , K - 1 \f]
+     *
+     * @param x The independent variables
+     * @param w The equation multipliers
+     * @param v The directions (v[k * n + j] is element j of direction k);
+     *          unused directions can be set to zero
+     * @param hv The products (hv[k * n + j] is element j of product k)
+     */
+    virtual void HessianVectorProduct(ArrayView<const Base> x,
+                                      ArrayView<const Base> w,
+                                      ArrayView<const Base> v,
+                                      ArrayView<Base> hv) {
+        throw CGException("The Hessian-vector product is not available for model '", getName(), "'");
+    }
+
     /**
      * Provides a wrapper for this compiled model allowing it to be used as
      * an atomic function. The model must not be deleted while the atomic
@@ -18,14 +18,23 @@
 namespace CppAD {
 namespace cg {
 
+/**
+ * Allows compiled models to call other models (GenericModel) as atomic
+ * functions without copying the array values.
+ * Calls to compiled models (FunctorGenericModel) for the zero order
+ * forward mode go directly to the compiled function.
+ */
 template<class Base>
 class GenericModelExternalFunctionWrapper : public ExternalFunctionWrapper<Base> {
 private:
     GenericModel<Base>* model_;
+    // not null when the model is also a compiled model
+    FunctorGenericModel<Base>* functor_;
 public:
 
     inline GenericModelExternalFunctionWrapper(GenericModel<Base>& model) :
-        model_(&model) {
+        model_(&model),
+        functor_(dynamic_cast<FunctorGenericModel<Base>*> (&model)) {
     }
 
     inline virtual ~GenericModelExternalFunctionWrapper() {
@@ -44,15 +53,25 @@ public:
 
 
         if (p == 0) {
-            model_->ForwardZero(x, y);
+            if (functor_ != nullptr && functor_->isDirectForwardZeroAvailable()) {
+                // compiled model to compiled model
+                CPPADCG_ASSERT_KNOWN(x.size() == functor_->_n, "Invalid independent array size")
+                CPPADCG_ASSERT_KNOWN(y.size() == functor_->_m, "Invalid dependent array size")
+                const Base* in = x.data();
+                Base* out = y.data();
+                (*functor_->_zero)(&in, &out, functor_->_atomicFuncArg);
+            } else {
+                model_->ForwardZero(x, y);
+            }
             return true;
 
         } else if (p == 1) {
-            CPPADCG_ASSERT_KNOWN(tx[1].sparse, "independent Taylor array must be sparse");
+            size_t tx1Nnz;
+            const size_t* idx = this->nonZeroIndexes(tx[1], tx1Nnz);
             Base* tx1 = static_cast<Base*> (tx[1].data);
 
             model_->ForwardOne(x,
-                               tx[1].nnz, tx[1].idx, tx1,
+                               tx1Nnz, idx, tx1,
                                y);
             return true;
         }
@@ -72,16 +91,18 @@ public:
         ArrayView<Base> pxb(static_cast<Base*> (px.data), px.size);
 
         if (p == 0) {
-            CPPADCG_ASSERT_KNOWN(py[0].sparse, "dependent partials array must be sparse");
+            size_t pyNnz;
+            const size_t* idx = this->nonZeroIndexes(py[0], pyNnz);
             Base* pyb = static_cast<Base*> (py[0].data);
 
             model_->ReverseOne(x,
                                pxb,
-                               py[0].nnz, py[0].idx, pyb);
+                               pyNnz, idx, pyb);
             return true;
 
         } else if (p == 1) {
-            CPPADCG_ASSERT_KNOWN(tx[1].sparse, "independent array must be sparse");
+            size_t tx1Nnz;
+            const size_t* idx = this->nonZeroIndexes(tx[1], tx1Nnz);
             const Base* tx1 = static_cast<const Base*> (tx[1].data);
             CPPADCG_ASSERT_KNOWN(py[0].sparse, "dependent partials array must be sparse");
             CPPADCG_ASSERT_KNOWN(py[0].nnz == 0, "first order dependent partials must be zero");
@@ -89,7 +110,7 @@ public:
             ArrayView<const Base> py2(static_cast<Base*> (py[1].data), py[1].size);
 
             model_->ReverseTwo(x,
-                               tx[1].nnz, tx[1].idx, tx1,
+                               tx1Nnz, idx, tx1,
                                pxb,
                                py2);
             return true;
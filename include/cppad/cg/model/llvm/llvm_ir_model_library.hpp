@@ -0,0 +1,228 @@
+#ifndef CPPAD_CG_LLVM_IR_MODEL_LIBRARY_INCLUDED
+#define CPPAD_CG_LLVM_IR_MODEL_LIBRARY_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A model library JIT'ed by LLVM from IR created directly from the
+ * operation graphs (see LanguageLlvmIr).
+ * No C source code is generated and, therefore, neither Clang nor an
+ * external compiler are required, which significantly reduces the time
+ * required to create small models.
+ *
+ * Only the zero order forward mode, the sparse Jacobian, and the sparse
+ * Hessian are available (see LlvmIrGenericModel).
+ * The models created by this library do not use a thread pool.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LlvmIrModelLibrary : public ModelLibrary<Base> {
+protected:
+    std::shared_ptr<llvm::LLVMContext> _context;
+    llvm::Module* _module; // owned by _executionEngine
+    std::unique_ptr<llvm::ExecutionEngine> _executionEngine;
+    std::unique_ptr<llvm::legacy::FunctionPassManager> _fpm;
+    // the model prototypes (with the JIT'ed functions)
+    std::map<std::string, std::unique_ptr<LlvmIrGenericModel<Base> > > _models;
+public:
+
+    /**
+     * Creates and JIT's the LLVM IR for all the models in a library
+     * source generator.
+     *
+     * @param libSourceGen the source generator of the model library
+     */
+    explicit LlvmIrModelLibrary(ModelLibraryCSourceGen<Base>& libSourceGen) :
+            _context(new llvm::LLVMContext()),
+            _module(nullptr) {
+        std::unique_ptr<llvm::Module> module(new llvm::Module("cppadcg_llvm_ir", *_context));
+        _module = module.get();
+
+        for (const auto& p : libSourceGen.getModels()) {
+            _models[p.first].reset(new LlvmIrGenericModel<Base>(*p.second, *_module));
+        }
+
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+
+        // Create the JIT.  This takes ownership of the module.
+        std::string errStr;
+        _executionEngine.reset(llvm::EngineBuilder(std::move(module))
+                                       .setErrorStr(&errStr)
+                                       .setEngineKind(llvm::EngineKind::JIT)
+#ifndef NDEBUG
+                                       .setVerifyModules(true)
+#endif
+                                       .create());
+        if (!_executionEngine.get()) {
+            throw CGException("Could not create ExecutionEngine: ", errStr);
+        }
+
+        // values printed by the generated code
+        llvm::Function* printFunc = _module->getFunction(LanguageLlvmIr<Base>::PRINT_FUNCTION);
+        if (printFunc != nullptr) {
+            _executionEngine->addGlobalMapping(printFunc, reinterpret_cast<void*>(&LanguageLlvmIr<Base>::print));
+        }
+
+        _fpm.reset(new llvm::legacy::FunctionPassManager(_module));
+
+        preparePassManager();
+
+        _fpm->doInitialization();
+
+        for (auto& p : _models) {
+            p.second->loadFunctions(*this);
+        }
+    }
+
+    LlvmIrModelLibrary(const LlvmIrModelLibrary&) = delete;
+    LlvmIrModelLibrary& operator=(const LlvmIrModelLibrary&) = delete;
+
+    inline virtual ~LlvmIrModelLibrary() {
+        _models.clear();
+        _fpm.reset();
+        _executionEngine.reset(); // the module must be deleted before the context
+    }
+
+    /**
+     * Provides the LLVM module with the generated functions.
+     */
+    inline const llvm::Module& getModule() const {
+        return *_module;
+    }
+
+    std::set<std::string> getModelNames() override {
+        std::set<std::string> names;
+        for (const auto& p : _models) {
+            names.insert(p.first);
+        }
+        return names;
+    }
+
+    /**
+     * Creates a new model object which uses the JIT'ed functions.
+     * This library must not be deleted while the model is in use.
+     */
+    std::unique_ptr<GenericModel<Base>> model(const std::string& modelName) override {
+        std::unique_ptr<GenericModel<Base>> m;
+        auto it = _models.find(modelName);
+        if (it != _models.end()) {
+            m.reset(new LlvmIrGenericModel<Base>(*it->second));
+        }
+        return m;
+    }
+
+    /**
+     * Provides a pointer to a JIT'ed function.
+     *
+     * @param functionName The name of the function in the LLVM module
+     * @param required Whether or not the function must exist
+     * @return A pointer to the function if it exists, nullptr otherwise.
+     * @throws CGException If the function is required and it does not exist
+     */
+    virtual void* loadFunction(const std::string& functionName,
+                               bool required = true) {
+        llvm::Function* func = _module->getFunction(functionName);
+        if (func == nullptr) {
+            if (required)
+                throw CGException("Unable to find function '", functionName, "' in LLVM module");
+            return nullptr;
+        }
+
+#ifndef NDEBUG
+        // Validate the generated code, checking for consistency.
+        llvm::raw_os_ostream os(std::cerr);
+        bool failed = llvm::verifyFunction(*func, &os);
+        if (failed)
+            throw CGException("Function '", functionName, "' verification failed");
+#endif
+
+        // Optimize the function.
+        _fpm->run(*func);
+
+        // JIT the function, returning a function pointer.
+        uint64_t fPtr = _executionEngine->getFunctionAddress(functionName);
+        if (fPtr == 0 && required) {
+            throw CGException("Unable to find function '", functionName, "' in LLVM module");
+        }
+        return (void*) fPtr;
+    }
+
+    /**
+     * The models do not use a thread pool
+     */
+    void setThreadPoolDisabled(bool disabled) override {
+    }
+
+    bool isThreadPoolDisabled() const override {
+        return true;
+    }
+
+    unsigned int getThreadNumber() const override {
+        return 1;
+    }
+
+    void setThreadNumber(unsigned int n) override {
+    }
+
+    ThreadPoolScheduleStrategy getThreadPoolSchedulerStrategy() const override {
+        return ThreadPoolScheduleStrategy::DYNAMIC;
+    }
+
+    void setThreadPoolSchedulerStrategy(ThreadPoolScheduleStrategy s) override {
+    }
+
+    void setThreadPoolVerbose(bool v) override {
+    }
+
+    bool isThreadPoolVerbose() const override {
+        return false;
+    }
+
+    void setThreadPoolGuidedMaxWork(float v) override {
+    }
+
+    float getThreadPoolGuidedMaxWork() const override {
+        return 1.0;
+    }
+
+    void setThreadPoolNumberOfTimeMeas(unsigned int n) override {
+    }
+
+    unsigned int getThreadPoolNumberOfTimeMeas() const override {
+        return 0;
+    }
+
+protected:
+
+    /**
+     * Set up the optimizer pipeline
+     */
+    virtual void preparePassManager() {
+        llvm::PassManagerBuilder builder;
+        builder.OptLevel = 2;
+        builder.populateFunctionPassManager(*_fpm);
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
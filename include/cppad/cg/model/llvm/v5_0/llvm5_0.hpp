@@ -57,6 +57,8 @@
 //#include <llvm/ExecutionEngine/JIT.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Module.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Intrinsics.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/Pass.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
@@ -89,5 +91,8 @@
 #include <cppad/cg/model/llvm/llvm_model.hpp>
 #include <cppad/cg/model/llvm/v5_0/llvm_model_library_impl.hpp>
 #include <cppad/cg/model/llvm/v5_0/llvm_model_library_processor.hpp>
+#include <cppad/cg/lang/llvm/language_llvm_ir.hpp>
+#include <cppad/cg/model/llvm/llvm_ir_generic_model.hpp>
+#include <cppad/cg/model/llvm/llvm_ir_model_library.hpp>
 
 #endif
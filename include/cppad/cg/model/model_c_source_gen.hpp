@@ -47,11 +47,19 @@ public:
     static const std::string FUNCTION_FORWARD_ONE;
     static const std::string FUNCTION_REVERSE_ONE;
     static const std::string FUNCTION_REVERSE_TWO;
+    static const std::string FUNCTION_FORWARD_TAYLOR;
+    static const std::string FUNCTION_FORWARD_TAYLOR_ORDER;
     static const std::string FUNCTION_SPARSE_JACOBIAN;
     static const std::string FUNCTION_SPARSE_HESSIAN;
     static const std::string FUNCTION_JACOBIAN_SPARSITY;
     static const std::string FUNCTION_HESSIAN_SPARSITY;
     static const std::string FUNCTION_HESSIAN_SPARSITY2;
+    static const std::string FUNCTION_JACOBIAN_SPARSITY_CSR;
+    static const std::string FUNCTION_HESSIAN_SPARSITY_CSR;
+    static const std::string FUNCTION_SPARSE_HESSIAN_LOWER;
+    static const std::string FUNCTION_HESSIAN_LOWER_SPARSITY_CSR;
+    static const std::string FUNCTION_HESSIAN_VECTOR;
+    static const std::string FUNCTION_HESSIAN_VECTOR_DIRECTIONS;
     static const std::string FUNCTION_SPARSE_FORWARD_ONE;
     static const std::string FUNCTION_SPARSE_REVERSE_ONE;
     static const std::string FUNCTION_SPARSE_REVERSE_TWO;
@@ -59,6 +67,9 @@ public:
     static const std::string FUNCTION_REVERSE_ONE_SPARSITY;
     static const std::string FUNCTION_REVERSE_TWO_SPARSITY;
     static const std::string FUNCTION_INFO;
+    static const std::string FUNCTION_DYNAMIC_PARAMETER_SIZE;
+    static const std::string FUNCTION_DYNAMIC_PARAMETER_VALUES;
+    static const std::string FUNCTION_DERIVATIVE_PRECISION;
     static const std::string FUNCTION_ATOMIC_FUNC_NAMES;
 protected:
     static const std::string CONST;
@@ -165,6 +176,10 @@ protected:
      * Typical values of the independent vector
      */
     std::vector<Base> _x;
+    /**
+     * Typical values of the dynamic parameters
+     */
+    std::vector<Base> _p;
     /**
      * Whether or not to enable the generation of multithreaded code for the
      * sparse Jacobian and sparse Hessian if possible and requested by the
@@ -182,6 +197,10 @@ protected:
     bool _sparseJacobian;
     /// generate source code for a sparse Hessian
     bool _sparseHessian;
+    /// generate source code for the lower triangle of a sparse Hessian in CSR order
+    bool _sparseHessianLower;
+    /// the number of directions of the Hessian-vector product (zero if disabled)
+    size_t _hessianVectorDirections;
     /**
      * generate source-code for the Hessian sparsity pattern for each
      * equation/dependent
@@ -193,6 +212,8 @@ protected:
     bool _reverseOne;
     /// generate source code for reverse second order mode
     bool _reverseTwo;
+    /// the order of the generated forward Taylor mode (zero if disabled)
+    size_t _forwardTaylorOrder;
     /**
      * whether or not the sparse Jacobian should reuse the forward or reverse
      * one functions when _sparseJacobian is true
@@ -214,6 +235,10 @@ protected:
      */
     Position _custom_hess;
     LocalSparsityInfo _hessSparsity;
+    /**
+     * Custom lower triangular Hessian element indexes (in CSR order)
+     */
+    Position _custom_hess_lower;
     /**
      * Hessian sparsity from the model for each equation
      */
@@ -222,6 +247,12 @@ protected:
      * The order of the atomic functions
      */
     std::vector<std::string> _atomicFunctions;
+    /**
+     * The atomic functions which are other models in the same library and
+     * which are called directly from the generated code
+     * (defined by ModelLibraryCSourceGen)
+     */
+    std::set<std::string> _directAtomicFunctions;
     /**
      * Maps each atomic function ID to information regarding how the atomic function is used
      */
@@ -238,10 +269,39 @@ protected:
      * the maximum number of operations per variable assignment
      */
     size_t _maxOperationsPerAssignment;
+    /**
+     * whether or not to use OpenMP SIMD directives in loops with
+     * independent iterations
+     */
+    bool _loopSimd;
+    /**
+     * whether or not to use OpenMP parallel for directives in loops with
+     * independent iterations
+     */
+    bool _loopParallelFor;
+    /**
+     * whether or not the constants are saved in static arrays
+     */
+    bool _parameterPool;
+    /**
+     * whether or not the Jacobian related functions are evaluated in
+     * single precision
+     */
+    bool _jacobianSinglePrecision;
+    /**
+     * whether or not the Hessian related functions are evaluated in
+     * single precision
+     */
+    bool _hessianSinglePrecision;
     /**
      *
      */
     std::vector<std::set<size_t> > _relatedDepCandidates;
+    /**
+     * whether or not to determine the related dependents automatically
+     * when they are not provided
+     */
+    bool _autoRelatedDependents;
     /**
      * Maps the column groups of each loop model to the set of columns
      * (loop->group->{columns->{compressed forward 1 position} })
@@ -280,6 +340,11 @@ protected:
      * Generated source code (maps file names to content)
      */
     std::map<std::string, std::string> _sources;
+    /**
+     * The names of the generated functions which are loaded from the
+     * compiled library
+     */
+    std::set<std::string> _libraryFunctions;
 public:
 
     /**
@@ -303,16 +368,25 @@ public:
         _hessian(false),
         _sparseJacobian(false),
         _sparseHessian(false),
+        _sparseHessianLower(false),
+        _hessianVectorDirections(0),
         _hessianByEquation(false),
         _forwardOne(false),
         _reverseOne(false),
         _reverseTwo(false),
+        _forwardTaylorOrder(0),
         _sparseJacobianReusesOne(true),
         _sparseHessianReusesRev2(true),
         _jacMode(JacobianADMode::Automatic),
         _atomicsInfo(nullptr),
         _maxAssignPerFunc(20000),
         _maxOperationsPerAssignment(1000),
+        _loopSimd(false),
+        _loopParallelFor(false),
+        _parameterPool(false),
+        _jacobianSinglePrecision(false),
+        _hessianSinglePrecision(false),
+        _autoRelatedDependents(false),
         _jobTimer(nullptr) {
 
         CPPADCG_ASSERT_KNOWN(!_name.empty(), "Model name cannot be empty")
@@ -359,6 +433,39 @@ public:
         }
     }
 
+    /**
+     * Provides the number of independent dynamic parameters in the model
+     * (see CppAD::Independent and CppAD::ADFun::new_dynamic).
+     * The dynamic parameters are provided to the compiled model at runtime
+     * in a separate array and, therefore, new parameter values do not
+     * require the generation and compilation of new source code.
+     */
+    inline size_t getDynamicParameterSize() const {
+        return _fun.size_dyn_ind();
+    }
+
+    /**
+     * Defines typical values for the dynamic parameters.
+     * The dynamic parameters of the ADFun are set to these values (or zero
+     * if they are not defined) once the source code is generated.
+     * These values are also exported to the compiled library and used as the
+     * initial dynamic parameter values of the loaded models; without them
+     * the loaded models can only be evaluated after
+     * GenericModel::setDynamicParameters() is called.
+     *
+     * @param p The typical values. An empty vector removes the currently
+     *          defined values.
+     */
+    template<class VectorBase>
+    inline void setTypicalDynamicParameterValues(const VectorBase& p) {
+        CPPAD_ASSERT_KNOWN(p.size() == 0 || p.size() == _fun.size_dyn_ind(),
+                           "Invalid dynamic parameter vector size")
+        _p.resize(p.size());
+        for (size_t i = 0; i < p.size(); i++) {
+            _p[i] = p[i];
+        }
+    }
+
     inline void setRelatedDependents(const std::vector<std::set<size_t> >& relatedDepCandidates) {
         _relatedDepCandidates = relatedDepCandidates;
     }
@@ -367,6 +474,29 @@ public:
         return _relatedDepCandidates;
     }
 
+    /**
+     * Whether or not the groups of related dependents (used to detect
+     * loops) are determined automatically, through the structure of the
+     * dependent expressions, when they are not provided with
+     * setRelatedDependents().
+     */
+    inline bool isAutomaticRelatedDependents() const {
+        return _autoRelatedDependents;
+    }
+
+    /**
+     * Defines whether or not the groups of related dependents (used to
+     * detect loops) are determined automatically, through the structure of
+     * the dependent expressions, when they are not provided with
+     * setRelatedDependents().
+     * The groups found are available through getRelatedDependents() after
+     * the source code generation.
+     * Loops are not detected in models with dynamic parameters.
+     */
+    inline void setAutomaticRelatedDependents(bool automatic) {
+        _autoRelatedDependents = automatic;
+    }
+
     /**
      * Provides the maximum precision used to print constant values in the
      * generated source code
@@ -506,6 +636,7 @@ public:
      *
      * @see setCustomSparseHessianElements()
      * @see setSparseHessianReusesRev2()
+     * @see setCreateSparseHessianLower()
      *
      * @return true if source-code for a sparse Hessian should be created,
      *         false otherwise
@@ -528,6 +659,7 @@ public:
      *
      * @see setCustomSparseHessianElements()
      * @see setSparseHessianReusesRev2()
+     * @see setCreateSparseHessianLower()
      *
      * @param create true if source-code for a sparse Hessian should be
      *               created, false otherwise
@@ -562,6 +694,71 @@ public:
         _sparseHessianReusesRev2 = reuse;
     }
 
+    /**
+     * Determines whether or not to generate source-code for a function
+     * that evaluates only the lower triangle of a sparse Hessian
+     * (FUNCTION_SPARSE_HESSIAN_LOWER).
+     *
+     * @see setCreateSparseHessianLower()
+     *
+     * @return true if source-code for the lower triangle of the sparse
+     *         Hessian should be created, false otherwise
+     */
+    inline bool isCreateSparseHessianLower() const {
+        return _sparseHessianLower;
+    }
+
+    /**
+     * Defines whether or not to generate source-code for a function
+     * that evaluates only the lower triangle of a sparse Hessian.
+     * The values are written in compressed sparse row (CSR) order, either
+     * in the layout defined with setCustomSparseHessianLowerCsr() or in
+     * the lower triangle of the Hessian sparsity pattern
+     * (provided by FUNCTION_HESSIAN_LOWER_SPARSITY_CSR).
+     * Symmetric coloring is used to determine the elements and, therefore,
+     * fewer second order reverse passes are required than for the full
+     * sparse Hessian.
+     * The elements of the layout which are not in the Hessian sparsity
+     * pattern are set to zero.
+     * This function is independent from setCreateSparseHessian() and it is
+     * not available for models with loops.
+     *
+     * @param create true if source-code for the lower triangle of the
+     *               sparse Hessian should be created, false otherwise
+     */
+    inline void setCreateSparseHessianLower(bool create) {
+        _sparseHessianLower = create;
+    }
+
+    /**
+     * Provides the number of directions of the generated Hessian-vector
+     * product function.
+     *
+     * @return the number of directions or zero if the source for the
+     *         Hessian-vector product is not generated
+     */
+    inline size_t getHessianVectorDirections() const {
+        return _hessianVectorDirections;
+    }
+
+    /**
+     * Defines whether or not to generate source-code for a function which
+     * determines the product of the weighted sum of the Hessians with a
+     * block of directions (FUNCTION_HESSIAN_VECTOR):
+     * \f[ hv_k = \left( \frac{\rm d^2  }{{\rm d} x^2 } \sum_{i} w_i F_i (x) \right) v_k \f]
+     * \f[ k = 0 , \ldots , K - 1 \f]
+     * The Hessian is never formed and the zero order forward sweep is
+     * shared by all the directions.
+     * This can be used, for instance, by matrix-free Newton-Krylov methods.
+     * It is not available for models with loops.
+     *
+     * @param directions the number of directions K evaluated by each call
+     *                   (zero disables the generation of this function)
+     */
+    inline void setCreateHessianVectorProduct(size_t directions) {
+        _hessianVectorDirections = directions;
+    }
+
     /**
      * Determines whether or not to generate source-code for a function that
      * provides the Hessian sparsity pattern for each equation/dependent,
@@ -789,6 +986,35 @@ public:
         _reverseTwo = create;
     }
 
+    /**
+     * Provides the order of the Taylor coefficients determined by the
+     * generated forward Taylor mode function.
+     *
+     * @return the highest order of the Taylor coefficients or zero if the
+     *         source for the forward Taylor mode is not generated
+     */
+    inline size_t getForwardTaylorOrder() const {
+        return _forwardTaylorOrder;
+    }
+
+    /**
+     * Defines whether or not to generate source-code for a forward mode
+     * function which determines the Taylor coefficients of the dependent
+     * variables from order zero up to a fixed order p
+     * (the same as CppAD's ADFun::Forward(p, tx)).
+     * The order is defined here and the recurrences for all orders are
+     * unrolled in the generated source code.
+     * This can be used, for instance, by Taylor series ODE integrators.
+     * It is not available for models with loops and the atomic functions
+     * used by the model must support forward mode of order p.
+     *
+     * @param order the highest order of the Taylor coefficients
+     *              (zero disables the generation of this function)
+     */
+    inline void setCreateForwardTaylor(size_t order) {
+        _forwardTaylorOrder = order;
+    }
+
     /**
      * Specifies a user defined Jacobian sparsity to be computed.
      * The elements can be provided in any order as long as they are a subset
@@ -851,6 +1077,43 @@ public:
         _custom_hess = Position(elements);
     }
 
+    /**
+     * Specifies the compressed sparse row (CSR) layout of the lower
+     * triangle of the Hessian used by FUNCTION_SPARSE_HESSIAN_LOWER
+     * (see setCreateSparseHessianLower()).
+     * The layout can contain elements which are not in the Hessian
+     * sparsity pattern (their values will be zero).
+     *
+     * @param rowPtr The position of the first element of each row in cols
+     *               (the size must be the number of independent variables
+     *               plus one)
+     * @param cols The column indexes of each row, which must be sorted,
+     *             unique, and not greater than the row index
+     * @throws CGException if the layout is not a valid lower triangular
+     *                     CSR layout
+     */
+    inline void setCustomSparseHessianLowerCsr(const std::vector<size_t>& rowPtr,
+                                               const std::vector<size_t>& cols) {
+        size_t n = _fun.Domain();
+        if (rowPtr.size() != n + 1 || rowPtr[0] != 0 || rowPtr[n] != cols.size())
+            throw CGException("Invalid row pointer array for the lower triangular Hessian");
+
+        std::vector<size_t> rows(cols.size());
+        for (size_t i = 0; i < n; i++) {
+            if (rowPtr[i + 1] < rowPtr[i])
+                throw CGException("Invalid row pointer array for the lower triangular Hessian");
+            for (size_t e = rowPtr[i]; e < rowPtr[i + 1]; e++) {
+                if (cols[e] > i)
+                    throw CGException("Element (", i, ", ", cols[e], ") is not in the lower triangle of the Hessian");
+                if (e > rowPtr[i] && cols[e] <= cols[e - 1])
+                    throw CGException("The columns of row ", i, " of the lower triangular Hessian must be sorted and unique");
+                rows[e] = i;
+            }
+        }
+
+        _custom_hess_lower = Position(rows, cols);
+    }
+
     /**
      * The maximum number of assignment per generated function.
      * Zero means it is disabled (no limit).
@@ -896,6 +1159,132 @@ public:
         _maxOperationsPerAssignment = maxOperationsPerAssignment;
     }
 
+    /**
+     * Whether or not the loops created by the detection of equation
+     * patterns are marked with '#pragma omp simd' when their iterations
+     * are independent.
+     *
+     * @return true if OpenMP SIMD directives are used in loops
+     */
+    inline bool isLoopSimd() const {
+        return _loopSimd;
+    }
+
+    /**
+     * Defines whether or not the loops created by the detection of equation
+     * patterns are marked with '#pragma omp simd' when their iterations
+     * are independent (see LanguageC::setLoopSimd()).
+     * The compiler must be provided with the flags required to enable
+     * OpenMP (e.g. -fopenmp-simd).
+     *
+     * @param simd true if OpenMP SIMD directives are used in loops
+     */
+    inline void setLoopSimd(bool simd) {
+        _loopSimd = simd;
+    }
+
+    /**
+     * Whether or not the loops created by the detection of equation
+     * patterns are marked with '#pragma omp parallel for' when their
+     * iterations are independent.
+     *
+     * @return true if OpenMP parallel for directives are used in loops
+     */
+    inline bool isLoopParallelFor() const {
+        return _loopParallelFor;
+    }
+
+    /**
+     * Defines whether or not the loops created by the detection of equation
+     * patterns are marked with '#pragma omp parallel for' when their
+     * iterations are independent (see LanguageC::setLoopParallelFor()).
+     * The compiler and the linker must be provided with the flags required
+     * to enable OpenMP (e.g. -fopenmp).
+     *
+     * @param parallel true if OpenMP parallel for directives are used in loops
+     */
+    inline void setLoopParallelFor(bool parallel) {
+        _loopParallelFor = parallel;
+    }
+
+    /**
+     * Whether or not the constants in the generated functions are saved in
+     * static arrays instead of being printed where they are used.
+     *
+     * @return true if the constants are saved in static arrays
+     */
+    inline bool isParameterPool() const {
+        return _parameterPool;
+    }
+
+    /**
+     * Defines whether or not the constants in the generated functions are
+     * saved in static arrays instead of being printed where they are used
+     * (see LanguageC::setParameterPool()).
+     * Each distinct value is printed only once per function in the
+     * hexadecimal floating point format which can reduce the size of the
+     * source files and the compilation time for models with many
+     * tabulated values.
+     *
+     * @param pool true if the constants are saved in static arrays
+     */
+    inline void setParameterPool(bool pool) {
+        _parameterPool = pool;
+    }
+
+    /**
+     * Whether or not the operations in the Jacobian related functions are
+     * performed in single precision.
+     *
+     * @return true if the Jacobian is evaluated with float values
+     */
+    inline bool isJacobianSinglePrecision() const {
+        return _jacobianSinglePrecision;
+    }
+
+    /**
+     * Defines whether or not the operations in the Jacobian related
+     * functions (jacobian, sparse_jacobian, forward_one, and reverse_one)
+     * are performed in single precision (see LanguageC::setSinglePrecision()).
+     * The arguments of these functions keep the Base type and the zero
+     * order forward mode is not affected, so that the residuals are still
+     * evaluated in double precision.
+     * This is typically enough for the Jacobians used by Newton-type
+     * methods and it reduces the memory traffic of the temporary variables.
+     * Loops are not affected and, when they are used, the compiled model
+     * reports that its derivatives are evaluated with the Base type
+     * (see GenericModel::isJacobianSinglePrecision()).
+     *
+     * @param singlePrecision true if the Jacobian is evaluated with float
+     *                        values
+     */
+    inline void setJacobianSinglePrecision(bool singlePrecision) {
+        _jacobianSinglePrecision = singlePrecision;
+    }
+
+    /**
+     * Whether or not the operations in the Hessian related functions are
+     * performed in single precision.
+     *
+     * @return true if the Hessian is evaluated with float values
+     */
+    inline bool isHessianSinglePrecision() const {
+        return _hessianSinglePrecision;
+    }
+
+    /**
+     * Defines whether or not the operations in the Hessian related
+     * functions (hessian, sparse_hessian, sparse_hessian_lower,
+     * hessian_vector, and reverse_two) are performed in single precision
+     * (see setJacobianSinglePrecision()).
+     *
+     * @param singlePrecision true if the Hessian is evaluated with float
+     *                        values
+     */
+    inline void setHessianSinglePrecision(bool singlePrecision) {
+        _hessianSinglePrecision = singlePrecision;
+    }
+
     inline virtual ~ModelCSourceGen() {
         delete _funNoLoops;
         delete _atomicsInfo;
@@ -922,18 +1311,84 @@ protected:
                                                                      const std::string& tmpName = "v",
                                                                      const std::string& tmpArrayName = "array");
 
+    /**
+     * Creates the variable name generator for the functions of the model
+     * which includes the dynamic parameters (if any) as an additional
+     * independent array after the arrays of the independent variables.
+     */
+    virtual VariableNameGenerator<Base>* createModelVariableNameGenerator(const std::string& depName = "y");
+
+    /**
+     * Creates the variables for the dynamic parameters in a code handler
+     * and uses them as the dynamic parameters of the ADFun.
+     * Must be called after the independent variables are created and
+     * before any other variable.
+     */
+    virtual void makeDynamicParameterVariables(CodeHandler<Base>& handler);
+
+    /**
+     * Sets the dynamic parameters of the ADFun back to their typical
+     * values so that it does not refer to variables of a code handler.
+     */
+    virtual void resetDynamicParameters();
+
     const std::map<std::string, std::string>& getSources(MultiThreadingType multiThreadingType,
                                                          JobTimer* timer);
 
     virtual void generateSources(MultiThreadingType multiThreadingType,
                                  JobTimer* timer = nullptr);
 
+    /**
+     * Provides the name of a model function which is loaded from the
+     * compiled library and registers it as one of the generated library
+     * functions.
+     *
+     * @param function the function name without the model name prefix
+     *                 (e.g. FUNCTION_FORWAD_ZERO)
+     */
+    inline std::string libraryFunction(const std::string& function) {
+        std::string funcName = _name + "_" + function;
+        _libraryFunctions.insert(funcName);
+        return funcName;
+    }
+
+    /**
+     * @return the names of the functions loaded from the compiled library
+     *         (only defined after the sources are generated)
+     */
+    inline const std::set<std::string>& getLibraryFunctions() const {
+        return _libraryFunctions;
+    }
+
     virtual void generateLoops();
 
     virtual void generateInfoSource();
 
+    virtual void generateDynamicParameterSizeSource();
+
+    /**
+     * Generates a function which provides the typical values of the dynamic
+     * parameters (see setTypicalDynamicParameterValues()) used as the
+     * initial values of the dynamic parameters in the compiled model.
+     */
+    virtual void generateDynamicParameterValuesSource();
+
+    virtual void generateDerivativePrecisionSource();
+
     virtual void generateAtomicFuncNames();
 
+    /**
+     * Applies the source generation options of this model which are shared
+     * by all the functions (parameters, atomic functions, and loops) to
+     * a language object used to generate one of the model functions.
+     *
+     * @param langC the language object
+     * @param singlePrecision whether or not the operations of the
+     *                        function are performed in single precision
+     */
+    virtual void configureLanguageC(LanguageC<Base>& langC,
+                                    bool singlePrecision) const;
+
     virtual bool isAtomicsUsed();
 
     virtual const std::map<size_t, AtomicUseInfo<Base> >& getAtomicsInfo();
@@ -944,6 +1399,15 @@ protected:
 
     virtual void generateZeroSource();
 
+    /**
+     * Generates the operation graph for the zero order model
+     *
+     * @param handler the code handler where the independent variables are
+     *                created
+     * @return the dependent variables
+     */
+    virtual std::vector<CGBase> prepareForward0(CodeHandler<Base>& handler);
+
     /**
      * Generates the operation graph for the zero order model with loops
      */
@@ -960,6 +1424,24 @@ protected:
 
     virtual void generateSparseJacobianSource(bool forward);
 
+    /**
+     * Determines whether the sparse Jacobian should be evaluated using
+     * forward mode (otherwise reverse mode).
+     */
+    virtual bool isSparseJacobianForwardMode();
+
+    /**
+     * Generates the operation graph for the sparse Jacobian
+     * (requires the Jacobian sparsity to be already determined)
+     *
+     * @param handler the code handler where the independent variables are
+     *                created
+     * @param forward whether or not to use forward mode
+     * @return the Jacobian elements in the same order as the sparsity
+     */
+    virtual std::vector<CGBase> prepareSparseJacobian(CodeHandler<Base>& handler,
+                                                      bool forward);
+
     virtual void generateSparseJacobianForRevSource(bool forward,
                                                     MultiThreadingType multiThreadingType);
 
@@ -1061,6 +1543,17 @@ protected:
 
     virtual void generateSparseHessianSourceDirectly();
 
+    /**
+     * Generates the operation graph for the sparse Hessian without
+     * reusing the second order reverse mode
+     * (requires the Hessian sparsity to be already determined)
+     *
+     * @param handler the code handler where the independent variables and
+     *                the multipliers are created
+     * @return the Hessian elements in the same order as the sparsity
+     */
+    virtual std::vector<CGBase> prepareSparseHessianDirectly(CodeHandler<Base>& handler);
+
     virtual void generateSparseHessianSourceFromRev2(MultiThreadingType multiThreadingType);
 
     virtual std::string generateSparseHessianRev2SingleThreadSource(const std::string& functionName,
@@ -1079,6 +1572,21 @@ protected:
     virtual void determineSecondOrderElements4Eval(std::vector<size_t>& userRows,
                                                    std::vector<size_t>& userCols);
 
+    virtual void generateSparseHessianLowerSource();
+
+    virtual void generateHessianVectorSource();
+
+    /**
+     * Determines the elements of the lower triangle of the Hessian, in CSR
+     * order, computed by FUNCTION_SPARSE_HESSIAN_LOWER
+     * (requires the Hessian sparsity to be already determined)
+     *
+     * @param rows the row index of each element
+     * @param cols the column index of each element
+     */
+    virtual void determineHessianLowerElements(std::vector<size_t>& rows,
+                                               std::vector<size_t>& cols);
+
     /**
      * Loops
      */
@@ -1147,6 +1655,15 @@ protected:
     virtual void generateSparsity2DSource2(const std::string& function,
                                            const std::vector<LocalSparsityInfo>& sparsities);
 
+    /**
+     * Generates a function which provides a sparsity pattern in the
+     * compressed sparse row format (row pointers, sorted column indexes,
+     * and the position of each element in the coordinate format).
+     */
+    virtual void generateSparsityCSRSource(const std::string& function,
+                                           const LocalSparsityInfo& sparsity,
+                                           size_t nRows);
+
     virtual void generateSparsity1DSource2(const std::string& function,
                                            const std::map<size_t, std::vector<size_t> >& rows);
 
@@ -1213,6 +1730,14 @@ protected:
 
     virtual void generateReverseTwoSources();
 
+    /***********************************************************************
+     * Forward Taylor mode
+     **********************************************************************/
+
+    virtual void generateForwardTaylorSource();
+
+    virtual void generateForwardTaylorOrderSource();
+
     virtual void generateGlobalDirectionalFunctionSource(const std::string& function,
                                                          const std::string& function2_suffix,
                                                          const std::string& function_sparsity,
@@ -1312,6 +1837,12 @@ protected:
 
     friend class
     ModelLibraryProcessor<Base>;
+
+    friend class
+    BytecodeGenericModel<Base>;
+
+    friend class
+    LlvmIrGenericModel<Base>;
 };
 
 } // END cg namespace
@@ -19,14 +19,7 @@ namespace CppAD {
 namespace cg {
 
 template<class Base>
-void ModelCSourceGen<Base>::generateZeroSource() {
-    const std::string jobName = "model (zero-order forward)";
-
-    startingJob("'" + jobName + "'", JobTimer::GRAPH);
-
-    CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
-
+std::vector<CG<Base> > ModelCSourceGen<Base>::prepareForward0(CodeHandler<Base>& handler) {
     std::vector<CGBase> indVars(_fun.Domain());
     handler.makeVariables(indVars);
     if (_x.size() > 0) {
@@ -35,27 +28,39 @@ void ModelCSourceGen<Base>::generateZeroSource() {
         }
     }
 
-    std::vector<CGBase> dep;
+    makeDynamicParameterVariables(handler);
 
     if (_loopTapes.empty()) {
-        dep = _fun.Forward(0, indVars);
+        return _fun.Forward(0, indVars);
     } else {
         /**
          * Contains loops
          */
-        dep = prepareForward0WithLoops(handler, indVars);
+        return prepareForward0WithLoops(handler, indVars);
     }
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateZeroSource() {
+    const std::string jobName = "model (zero-order forward)";
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+
+    std::vector<CGBase> dep = prepareForward0(handler);
 
     finishedJob();
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-    langC.setParameterPrecision(_parameterPrecision);
-    langC.setGenerateFunction(_name + "_" + FUNCTION_FORWAD_ZERO);
+    configureLanguageC(langC, false);
+    langC.setGenerateFunction(libraryFunction(FUNCTION_FORWAD_ZERO));
 
     std::ostringstream code;
-    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator());
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator());
 
     handler.generateCode(code, langC, dep, *nameGen, _atomicFunctions, jobName);
 }
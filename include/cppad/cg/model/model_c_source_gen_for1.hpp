@@ -93,6 +93,8 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
             }
         }
 
+        makeDynamicParameterVariables(handler);
+
         CGBase dx;
         handler.makeVariable(dx);
         if (_x.size() > 0) {
@@ -116,14 +118,14 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
+        configureLanguageC(langC, _jacobianSinglePrecision);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
 
         std::ostringstream code;
-        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dy"));
-        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator("dy"));
+        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n + _fun.size_dyn_ind());
 
         handler.generateCode(code, langC, dyCustom, nameGenHess, _atomicFunctions, subJobName);
     }
@@ -149,6 +151,8 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
         }
     }
 
+    makeDynamicParameterVariables(handler);
+
     CGBase dx;
     handler.makeVariable(dx);
     if (_x.size() > 0) {
@@ -203,14 +207,14 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
+        configureLanguageC(langC, _jacobianSinglePrecision);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
 
         std::ostringstream code;
-        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dy"));
-        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator("dy"));
+        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n + _fun.size_dyn_ind());
 
         handler.generateCode(code, langC, dyCustom, nameGenHess, _atomicFunctions, subJobName);
     }
@@ -222,9 +226,7 @@ void ModelCSourceGen<Base>::generateForwardOneSources() {
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
 
-    _cache.str("");
-    _cache << _name << "_" << FUNCTION_FORWARD_ONE;
-    std::string model_function(_cache.str());
+    std::string model_function = libraryFunction(FUNCTION_FORWARD_ONE);
 
     LanguageC<Base> langC(_baseTypeName);
     std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
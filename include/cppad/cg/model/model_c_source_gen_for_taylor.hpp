@@ -0,0 +1,84 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_FOR_TAYLOR_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_FOR_TAYLOR_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+void ModelCSourceGen<Base>::generateForwardTaylorSource() {
+    if (!_loopTapes.empty()) {
+        throw CGException("The forward Taylor mode is not available for models with loops ('", _name, "')");
+    }
+
+    const std::string jobName = "model (forward Taylor order " + std::to_string(_forwardTaylorOrder) + ")";
+    size_t n = _fun.Domain();
+    size_t p1 = _forwardTaylorOrder + 1;
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+
+    // Taylor coefficients of the independent variables (tx[j * (p + 1) + k])
+    std::vector<CGBase> tx(n * p1);
+    handler.makeVariables(tx);
+    if (_x.size() > 0) {
+        for (size_t j = 0; j < n; j++) {
+            tx[j * p1].setValue(_x[j]);
+        }
+    }
+
+    makeDynamicParameterVariables(handler);
+
+    // all orders are determined by a single sweep (the recurrences are unrolled in the graph)
+    std::vector<CGBase> ty = _fun.Forward(_forwardTaylorOrder, tx);
+
+    finishedJob();
+
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    configureLanguageC(langC, false);
+    langC.setGenerateFunction(libraryFunction(FUNCTION_FORWARD_TAYLOR));
+
+    std::ostringstream code;
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("ty"));
+    if (_fun.size_dyn_ind() > 0) {
+        // the dynamic parameters are placed after all the Taylor coefficients
+        nameGen.reset(new LangCDefaultParameterVarNameGenerator<Base>(std::move(nameGen), n * p1));
+    }
+
+    handler.generateCode(code, langC, ty, *nameGen, _atomicFunctions, jobName);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateForwardTaylorOrderSource() {
+    std::string funcName = libraryFunction(FUNCTION_FORWARD_TAYLOR_ORDER);
+
+    _cache.str("");
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {"unsigned long* p"});
+    _cache << " {\n"
+            "   *p = " << _forwardTaylorOrder << "; // the highest order of the Taylor coefficients\n"
+            "}\n\n";
+
+    _sources[funcName + ".c"] = _cache.str();
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
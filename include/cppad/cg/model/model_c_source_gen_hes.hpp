@@ -42,6 +42,8 @@ void ModelCSourceGen<Base>::generateHessianSource() {
         }
     }
 
+    makeDynamicParameterVariables(handler);
+
     // multipliers
     vector<CGBase> w(m);
     handler.makeVariables(w);
@@ -65,12 +67,12 @@ void ModelCSourceGen<Base>::generateHessianSource() {
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-    langC.setParameterPrecision(_parameterPrecision);
-    langC.setGenerateFunction(_name + "_" + FUNCTION_HESSIAN);
+    configureLanguageC(langC, _hessianSinglePrecision);
+    langC.setGenerateFunction(libraryFunction(FUNCTION_HESSIAN));
 
     std::ostringstream code;
-    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hess"));
-    LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator("hess"));
+    LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n + _fun.size_dyn_ind());
 
     handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
 }
@@ -82,7 +84,10 @@ void ModelCSourceGen<Base>::generateSparseHessianSource(MultiThreadingType multi
      */
     determineHessianSparsity();
 
-    if (_sparseHessianReusesRev2 && _reverseTwo) {
+    // the calls to the reverse two functions do not pass the dynamic parameters
+    bool reuseRev2 = _sparseHessianReusesRev2 && _reverseTwo && _fun.size_dyn_ind() == 0;
+
+    if (reuseRev2) {
         generateSparseHessianSourceFromRev2(multiThreadingType);
     } else {
         generateSparseHessianSourceDirectly();
@@ -94,6 +99,34 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
     using std::vector;
 
     const std::string jobName = "sparse Hessian";
+    size_t n = _fun.Domain();
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+
+    vector<CGBase> hess = prepareSparseHessianDirectly(handler);
+
+    finishedJob();
+
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    configureLanguageC(langC, _hessianSinglePrecision);
+    langC.setGenerateFunction(libraryFunction(FUNCTION_SPARSE_HESSIAN));
+
+    std::ostringstream code;
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator("hess"));
+    LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n + _fun.size_dyn_ind());
+
+    handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+}
+
+template<class Base>
+std::vector<CG<Base> > ModelCSourceGen<Base>::prepareSparseHessianDirectly(CodeHandler<Base>& handler) {
+    using std::vector;
+
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
 
@@ -155,14 +188,6 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
         }
     }
 
-    /**
-     * 
-     */
-    startingJob("'" + jobName + "'", JobTimer::GRAPH);
-
-    CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
-
     // independent variables
     vector<CGBase> indVars(n);
     handler.makeVariables(indVars);
@@ -172,6 +197,8 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
         }
     }
 
+    makeDynamicParameterVariables(handler);
+
     // multipliers
     vector<CGBase> w(m);
     handler.makeVariables(w);
@@ -208,19 +235,244 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
                                              duplicates);
     }
 
+    return hess;
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseHessianLowerSource() {
+    using std::vector;
+
+    determineHessianSparsity();
+
+    if (!_loopTapes.empty()) {
+        throw CGException("The lower triangular sparse Hessian is not available for models with loops ('", _name, "')");
+    }
+
+    const std::string jobName = "sparse Hessian (lower triangle)";
+    size_t m = _fun.Range();
+    size_t n = _fun.Domain();
+
+    vector<size_t> rows, cols;
+    determineHessianLowerElements(rows, cols);
+
+    /**
+     * the elements evaluated by CppAD (the upper element is used when only
+     * that one is in the sparsity pattern)
+     */
+    vector<size_t> evalRows, evalCols, evalOrder;
+    evalRows.reserve(rows.size());
+    evalCols.reserve(rows.size());
+    evalOrder.reserve(rows.size());
+    for (size_t e = 0; e < rows.size(); e++) {
+        size_t i = rows[e];
+        size_t j = cols[e];
+        if (_hessSparsity.sparsity[i].find(j) != _hessSparsity.sparsity[i].end()) {
+            evalRows.push_back(i);
+            evalCols.push_back(j);
+        } else if (_hessSparsity.sparsity[j].find(i) != _hessSparsity.sparsity[j].end()) {
+            evalRows.push_back(j);
+            evalCols.push_back(i);
+        } else {
+            continue; // structural zero
+        }
+        evalOrder.push_back(e);
+    }
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+
+    // independent variables
+    vector<CGBase> indVars(n);
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < n; i++) {
+            indVars[i].setValue(_x[i]);
+        }
+    }
+
+    makeDynamicParameterVariables(handler);
+
+    // multipliers
+    vector<CGBase> w(m);
+    handler.makeVariables(w);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < m; i++) {
+            w[i].setValue(Base(1.0));
+        }
+    }
+
+    vector<CGBase> hess(rows.size(), CGBase(Base(0)));
+    if (!evalRows.empty()) {
+        CppAD::sparse_hessian_work work;
+        // atomic functions might only provide half of the elements which
+        // is not compatible with the symmetric coloring
+        work.color_method = isAtomicsUsed() ? "cppad.general" : "cppad.symmetric";
+        vector<CGBase> evalHess(evalRows.size());
+        _fun.SparseHessian(indVars, w, _hessSparsity.sparsity, evalRows, evalCols, evalHess, work);
+
+        for (size_t e = 0; e < evalOrder.size(); e++) {
+            hess[evalOrder[e]] = evalHess[e];
+        }
+    }
+
     finishedJob();
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-    langC.setParameterPrecision(_parameterPrecision);
-    langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_HESSIAN);
+    configureLanguageC(langC, _hessianSinglePrecision);
+    langC.setGenerateFunction(libraryFunction(FUNCTION_SPARSE_HESSIAN_LOWER));
 
     std::ostringstream code;
-    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hess"));
-    LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator("hess"));
+    LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n + _fun.size_dyn_ind());
 
     handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+
+    /**
+     * the layout of the values
+     */
+    LocalSparsityInfo lower;
+    lower.rows = std::move(rows);
+    lower.cols = std::move(cols);
+
+    _cache.str("");
+    generateSparsityCSRSource(libraryFunction(FUNCTION_HESSIAN_LOWER_SPARSITY_CSR), lower, n);
+    _sources[libraryFunction(FUNCTION_HESSIAN_LOWER_SPARSITY_CSR) + ".c"] = _cache.str();
+    _cache.str("");
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateHessianVectorSource() {
+    using std::vector;
+
+    if (!_loopTapes.empty()) {
+        throw CGException("The Hessian-vector product is not available for models with loops ('", _name, "')");
+    }
+
+    const std::string jobName = "Hessian-vector product";
+    size_t m = _fun.Range();
+    size_t n = _fun.Domain();
+    size_t nDir = _hessianVectorDirections;
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+
+    // independent variables
+    vector<CGBase> tx0(n);
+    handler.makeVariables(tx0);
+    if (_x.size() > 0) {
+        for (size_t j = 0; j < n; j++) {
+            tx0[j].setValue(_x[j]);
+        }
+    }
+
+    makeDynamicParameterVariables(handler);
+
+    // directions
+    vector<CGBase> v(nDir * n);
+    handler.makeVariables(v);
+    if (_x.size() > 0) {
+        for (size_t j = 0; j < v.size(); j++) {
+            v[j].setValue(Base(1.0));
+        }
+    }
+
+    // multipliers
+    vector<CGBase> w(m);
+    handler.makeVariables(w);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < m; i++) {
+            w[i].setValue(Base(1.0));
+        }
+    }
+
+    /**
+     * the zero order forward sweep is shared by all directions
+     */
+    _fun.Forward(0, tx0);
+
+    // the multipliers are applied to the first order coefficients so that
+    // the zero order partials are the Hessian-vector products
+    vector<CGBase> py(2 * m);
+    for (size_t i = 0; i < m; i++) {
+        py[i * 2] = Base(0);
+        py[i * 2 + 1] = w[i];
+    }
+
+    vector<CGBase> hv(nDir * n);
+    vector<CGBase> tx1(n);
+    for (size_t k = 0; k < nDir; k++) {
+        for (size_t j = 0; j < n; j++) {
+            tx1[j] = v[k * n + j];
+        }
+        _fun.Forward(1, tx1);
+
+        vector<CGBase> px = _fun.Reverse(2, py);
+        for (size_t j = 0; j < n; j++) {
+            hv[k * n + j] = px[j * 2];
+        }
+    }
+
+    finishedJob();
+
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    configureLanguageC(langC, _hessianSinglePrecision);
+    langC.setGenerateFunction(libraryFunction(FUNCTION_HESSIAN_VECTOR));
+
+    std::ostringstream code;
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator("hv"));
+    LangCDefaultReverse2VarNameGenerator<Base> nameGenHv(nameGen.get(), n + _fun.size_dyn_ind(), "v", nDir * n, "w");
+
+    handler.generateCode(code, langC, hv, nameGenHv, _atomicFunctions, jobName);
+
+    /**
+     * the number of directions
+     */
+    std::string funcName = libraryFunction(FUNCTION_HESSIAN_VECTOR_DIRECTIONS);
+
+    _cache.str("");
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {"unsigned long* k"});
+    _cache << " {\n"
+            "   *k = " << nDir << "; // the number of directions\n"
+            "}\n\n";
+
+    _sources[funcName + ".c"] = _cache.str();
+    _cache.str("");
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::determineHessianLowerElements(std::vector<size_t>& rows,
+                                                          std::vector<size_t>& cols) {
+    if (_custom_hess_lower.defined) {
+        rows = _custom_hess_lower.row;
+        cols = _custom_hess_lower.col;
+        return;
+    }
+
+    /**
+     * the lower triangle of the (symmetric) sparsity pattern
+     */
+    size_t n = _fun.Domain();
+    SparsitySetType lower(n);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j : _hessSparsity.sparsity[i]) {
+            if (j <= i)
+                lower[i].insert(j);
+            else
+                lower[j].insert(i);
+        }
+    }
+
+    Position p(lower);
+    rows = std::move(p.row);
+    cols = std::move(p.col);
 }
 
 template<class Base>
@@ -289,7 +541,7 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceFromRev2(MultiThreadingTy
         return;
     }
 
-    string functionName = _name + "_" + FUNCTION_SPARSE_HESSIAN;
+    string functionName = libraryFunction(FUNCTION_SPARSE_HESSIAN);
     string functionRev2 = _name + "_" + FUNCTION_SPARSE_REVERSE_TWO;
     string rev2Suffix = "indep";
 
@@ -663,13 +915,17 @@ template<class Base>
 void ModelCSourceGen<Base>::generateHessianSparsitySource() {
     determineHessianSparsity();
 
-    generateSparsity2DSource(_name + "_" + FUNCTION_HESSIAN_SPARSITY, _hessSparsity);
-    _sources[_name + "_" + FUNCTION_HESSIAN_SPARSITY + ".c"] = _cache.str();
+    generateSparsity2DSource(libraryFunction(FUNCTION_HESSIAN_SPARSITY), _hessSparsity);
+    _sources[libraryFunction(FUNCTION_HESSIAN_SPARSITY) + ".c"] = _cache.str();
+    _cache.str("");
+
+    generateSparsityCSRSource(libraryFunction(FUNCTION_HESSIAN_SPARSITY_CSR), _hessSparsity, _fun.Domain());
+    _sources[libraryFunction(FUNCTION_HESSIAN_SPARSITY_CSR) + ".c"] = _cache.str();
     _cache.str("");
 
     if (_hessianByEquation || _reverseTwo) {
-        generateSparsity2DSource2(_name + "_" + FUNCTION_HESSIAN_SPARSITY2, _hessSparsities);
-        _sources[_name + "_" + FUNCTION_HESSIAN_SPARSITY2 + ".c"] = _cache.str();
+        generateSparsity2DSource2(libraryFunction(FUNCTION_HESSIAN_SPARSITY2), _hessSparsities);
+        _sources[libraryFunction(FUNCTION_HESSIAN_SPARSITY2) + ".c"] = _cache.str();
         _cache.str("");
     }
 }
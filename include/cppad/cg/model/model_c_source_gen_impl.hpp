@@ -38,6 +38,12 @@ const std::string ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE = "reverse_one";
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO = "reverse_two";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_FORWARD_TAYLOR = "forward_taylor";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_FORWARD_TAYLOR_ORDER = "forward_taylor_order";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN = "sparse_jacobian";
 
@@ -53,6 +59,24 @@ const std::string ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY = "hessian_sp
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY2 = "hessian_sparsity2";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_JACOBIAN_SPARSITY_CSR = "jacobian_sparsity_csr";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY_CSR = "hessian_sparsity_csr";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN_LOWER = "sparse_hessian_lower";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_HESSIAN_LOWER_SPARSITY_CSR = "hessian_lower_sparsity_csr";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_HESSIAN_VECTOR = "hessian_vector";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_HESSIAN_VECTOR_DIRECTIONS = "hessian_vector_directions";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE = "sparse_forward_one";
 
@@ -74,6 +98,15 @@ const std::string ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO_SPARSITY = "sparse
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_INFO = "info";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_DYNAMIC_PARAMETER_SIZE = "dynamic_parameter_size";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_DYNAMIC_PARAMETER_VALUES = "dynamic_parameter_values";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_DERIVATIVE_PRECISION = "derivative_precision";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES = "atomic_functions";
 
@@ -88,6 +121,49 @@ VariableNameGenerator<Base>* ModelCSourceGen<Base>::createVariableNameGenerator(
     return new LangCDefaultVariableNameGenerator<Base> (depName, indepName, tmpName, tmpArrayName);
 }
 
+template<class Base>
+VariableNameGenerator<Base>* ModelCSourceGen<Base>::createModelVariableNameGenerator(const std::string& depName) {
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator(depName));
+    if (_fun.size_dyn_ind() == 0) {
+        return nameGen.release();
+    }
+
+    return new LangCDefaultParameterVarNameGenerator<Base>(std::move(nameGen), _fun.Domain());
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::makeDynamicParameterVariables(CodeHandler<Base>& handler) {
+    size_t np = _fun.size_dyn_ind();
+    if (np == 0)
+        return;
+
+    std::vector<CGBase> p(np);
+    handler.makeVariables(p);
+    if (_p.size() > 0) {
+        for (size_t i = 0; i < np; i++) {
+            p[i].setValue(_p[i]);
+        }
+    }
+
+    _fun.new_dynamic(p);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::resetDynamicParameters() {
+    size_t np = _fun.size_dyn_ind();
+    if (np == 0)
+        return;
+
+    std::vector<CGBase> p(np, CGBase(Base(0)));
+    if (_p.size() > 0) {
+        for (size_t i = 0; i < np; i++) {
+            p[i] = _p[i];
+        }
+    }
+
+    _fun.new_dynamic(p);
+}
+
 template<class Base>
 const std::map<std::string, std::string>& ModelCSourceGen<Base>::getSources(MultiThreadingType multiThreadingType,
                                                                             JobTimer* timer) {
@@ -119,19 +195,33 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
         generateHessianSource();
     }
 
+    /**
+     * the dense directional functions (used by atomic functions) do not
+     * receive the dynamic parameters
+     */
+    bool dynamicParameters = _fun.size_dyn_ind() > 0;
+
     if (_forwardOne) {
         generateSparseForwardOneSources();
-        generateForwardOneSources();
+        if (!dynamicParameters)
+            generateForwardOneSources();
     }
 
     if (_reverseOne) {
         generateSparseReverseOneSources();
-        generateReverseOneSources();
+        if (!dynamicParameters)
+            generateReverseOneSources();
     }
 
     if (_reverseTwo) {
         generateSparseReverseTwoSources();
-        generateReverseTwoSources();
+        if (!dynamicParameters)
+            generateReverseTwoSources();
+    }
+
+    if (_forwardTaylorOrder > 0) {
+        generateForwardTaylorSource();
+        generateForwardTaylorOrderSource();
     }
 
     if (_sparseJacobian) {
@@ -142,6 +232,14 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
         generateSparseHessianSource(multiThreadingType);
     }
 
+    if (_sparseHessianLower) {
+        generateSparseHessianLowerSource();
+    }
+
+    if (_hessianVectorDirections > 0) {
+        generateHessianVectorSource();
+    }
+
     if (_sparseJacobian || _forwardOne || _reverseOne) {
         generateJacobianSparsitySource();
     }
@@ -152,17 +250,32 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
 
     generateInfoSource();
 
+    generateDynamicParameterSizeSource();
+
+    generateDynamicParameterValuesSource();
+
+    generateDerivativePrecisionSource();
+
     generateAtomicFuncNames();
 
+    resetDynamicParameters();
+
     finishedJob();
 }
 
 template<class Base>
 void ModelCSourceGen<Base>::generateLoops() {
-    if (_relatedDepCandidates.empty()) {
+    if (_relatedDepCandidates.empty() && !_autoRelatedDependents) {
         return; //nothing to do
     }
 
+    if (_fun.size_dyn_ind() > 0) {
+        if (_relatedDepCandidates.empty()) {
+            return; // the automatic detection of loops is just not used
+        }
+        throw CGException("Loops are not supported in models with dynamic parameters ('", _name, "')");
+    }
+
     startingJob("", JobTimer::LOOP_DETECTION);
 
     CodeHandler<Base> handler;
@@ -178,6 +291,16 @@ void ModelCSourceGen<Base>::generateLoops() {
 
     std::vector<CGBase> yy = _fun.Forward(0, xx);
 
+    if (_relatedDepCandidates.empty()) {
+        RelatedDependentFinder<Base> finder;
+        _relatedDepCandidates = finder.find(yy);
+
+        if (_relatedDepCandidates.empty()) {
+            finishedJob();
+            return; // no loops
+        }
+    }
+
     DependentPatternMatcher<Base> matcher(_relatedDepCandidates, yy, xx);
     matcher.generateTapes(_funNoLoops, _loopTapes);
 
@@ -192,9 +315,9 @@ template<class Base>
 void ModelCSourceGen<Base>::generateInfoSource() {
     const char* localBaseName = typeid (Base).name();
 
-    std::string funcName = _name + "_" + FUNCTION_INFO;
+    std::string funcName = libraryFunction(FUNCTION_INFO);
 
-    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator());
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator());
 
     _cache.str("");
     LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {"const char** baseName",
@@ -213,9 +336,82 @@ void ModelCSourceGen<Base>::generateInfoSource() {
     _sources[funcName + ".c"] = _cache.str();
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::generateDynamicParameterSizeSource() {
+    std::string funcName = libraryFunction(FUNCTION_DYNAMIC_PARAMETER_SIZE);
+
+    _cache.str("");
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {"unsigned long* np"});
+    _cache << " {\n"
+            "   *np = " << _fun.size_dyn_ind() << "; // number of dynamic parameters\n"
+            "}\n\n";
+
+    _sources[funcName + ".c"] = _cache.str();
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateDynamicParameterValuesSource() {
+    size_t np = _fun.size_dyn_ind();
+    if (np == 0)
+        return;
+
+    std::string funcName = libraryFunction(FUNCTION_DYNAMIC_PARAMETER_VALUES);
+
+    bool defined = _p.size() == np;
+
+    _cache.str("");
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {_baseTypeName + "* p",
+                                                                         "int* defined"});
+    _cache << " {\n";
+    if (defined) {
+        std::ostringstream value;
+        value << std::setprecision(_parameterPrecision);
+        for (size_t i = 0; i < np; i++) {
+            value.str("");
+            value << _p[i];
+            _cache << "   p[" << i << "] = " << value.str() << ";\n";
+        }
+    }
+    _cache << "   *defined = " << (defined ? 1 : 0) << "; // whether or not typical values were provided\n"
+            "}\n\n";
+
+    _sources[funcName + ".c"] = _cache.str();
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateDerivativePrecisionSource() {
+    std::string funcName = libraryFunction(FUNCTION_DERIVATIVE_PRECISION);
+
+    // the functions generated for loops are always evaluated with the Base type
+    bool loops = !_loopTapes.empty();
+    bool jacobian = _jacobianSinglePrecision && !loops;
+    bool hessian = _hessianSinglePrecision && !loops;
+
+    _cache.str("");
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {"int* jacobian",
+                                                                         "int* hessian"});
+    _cache << " {\n"
+            "   *jacobian = " << (jacobian ? 1 : 0) << "; // whether or not the Jacobian is evaluated in single precision\n"
+            "   *hessian = " << (hessian ? 1 : 0) << "; // whether or not the Hessian is evaluated in single precision\n"
+            "}\n\n";
+
+    _sources[funcName + ".c"] = _cache.str();
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::configureLanguageC(LanguageC<Base>& langC,
+                                               bool singlePrecision) const {
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
+    langC.setLoopSimd(_loopSimd);
+    langC.setLoopParallelFor(_loopParallelFor);
+    langC.setParameterPool(_parameterPool);
+    langC.setSinglePrecision(singlePrecision);
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::generateAtomicFuncNames() {
-    std::string funcName = _name + "_" + FUNCTION_ATOMIC_FUNC_NAMES;
+    std::string funcName = libraryFunction(FUNCTION_ATOMIC_FUNC_NAMES);
     size_t n = _atomicFunctions.size();
     _cache.str("");
     LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {"const char*** names",
@@ -323,9 +519,7 @@ void ModelCSourceGen<Base>::generateGlobalDirectionalFunctionSource(const std::s
     std::vector<std::string> argsDcl2 = langC.generateDefaultFunctionArgumentsDcl2();
     std::string args = langC.generateDefaultFunctionArguments();
 
-    _cache.str("");
-    _cache << _name << "_" << function;
-    std::string model_function = _cache.str();
+    std::string model_function = libraryFunction(function);
     _cache.str("");
 
     _cache << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
@@ -351,8 +545,8 @@ void ModelCSourceGen<Base>::generateGlobalDirectionalFunctionSource(const std::s
     /**
      * Sparsity
      */
-    generateSparsity1DSource2(_name + "_" + function_sparsity, elements);
-    _sources[_name + "_" + function_sparsity + ".c"] = _cache.str();
+    generateSparsity1DSource2(libraryFunction(function_sparsity), elements);
+    _sources[libraryFunction(function_sparsity) + ".c"] = _cache.str();
     _cache.str("");
 }
 
@@ -411,6 +605,58 @@ void ModelCSourceGen<Base>::generateSparsity2DSource(const std::string& function
             "}\n";
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::generateSparsityCSRSource(const std::string& function,
+                                                      const LocalSparsityInfo& sparsity,
+                                                      size_t nRows) {
+    const std::vector<size_t>& rows = sparsity.rows;
+    const std::vector<size_t>& cols = sparsity.cols;
+
+    CPPADCG_ASSERT_UNKNOWN(rows.size() == cols.size());
+
+    size_t nnz = rows.size();
+
+    // sort the elements by row and then by column
+    std::vector<size_t> positions(nnz);
+    for (size_t e = 0; e < nnz; e++)
+        positions[e] = e;
+
+    std::stable_sort(positions.begin(), positions.end(), [&](size_t e1, size_t e2) {
+        return rows[e1] < rows[e2] || (rows[e1] == rows[e2] && cols[e1] < cols[e2]);
+    });
+
+    std::vector<size_t> rowPtr(nRows + 1, 0);
+    std::vector<size_t> csrCols(nnz);
+    for (size_t e = 0; e < nnz; e++) {
+        CPPADCG_ASSERT_UNKNOWN(rows[positions[e]] < nRows);
+        rowPtr[rows[positions[e]] + 1]++;
+        csrCols[e] = cols[positions[e]];
+    }
+    for (size_t i = 0; i < nRows; i++)
+        rowPtr[i + 1] += rowPtr[i];
+
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", function, {"unsigned long const** rowPtr",
+                                                                         "unsigned long const** col",
+                                                                         "unsigned long const** elements",
+                                                                         "unsigned long* nnz"});
+    _cache << " {\n";
+
+    _cache << "   ";
+    LanguageC<Base>::printStaticIndexArray(_cache, "rowPtrs", rowPtr);
+
+    _cache << "   ";
+    LanguageC<Base>::printStaticIndexArray(_cache, "cols", csrCols);
+
+    _cache << "   ";
+    LanguageC<Base>::printStaticIndexArray(_cache, "positions", positions);
+
+    _cache << "   *rowPtr = rowPtrs;\n"
+            "   *col = cols;\n"
+            "   *elements = positions;\n"
+            "   *nnz = " << nnz << ";\n"
+            "}\n";
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::generateSparsity2DSource2(const std::string& function,
                                                       const std::vector<LocalSparsityInfo>& sparsities) {
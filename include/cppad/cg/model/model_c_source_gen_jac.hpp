@@ -37,6 +37,8 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
         }
     }
 
+    makeDynamicParameterVariables(handler);
+
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
 
@@ -54,43 +56,49 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-    langC.setParameterPrecision(_parameterPrecision);
-    langC.setGenerateFunction(_name + "_" + FUNCTION_JACOBIAN);
+    configureLanguageC(langC, _jacobianSinglePrecision);
+    langC.setGenerateFunction(libraryFunction(FUNCTION_JACOBIAN));
 
     std::ostringstream code;
-    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator("jac"));
 
     handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
 }
 
 template<class Base>
-void ModelCSourceGen<Base>::generateSparseJacobianSource(MultiThreadingType multiThreadingType) {
+bool ModelCSourceGen<Base>::isSparseJacobianForwardMode() {
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
 
-    /**
-     * Determine the sparsity pattern
-     */
-    determineJacobianSparsity();
-
-    bool forwardMode;
-
     if (_jacMode == JacobianADMode::Automatic) {
         if (_custom_jac.defined) {
-            forwardMode = estimateBestJacobianADMode(_jacSparsity.rows, _jacSparsity.cols);
+            return estimateBestJacobianADMode(_jacSparsity.rows, _jacSparsity.cols);
         } else {
-            forwardMode = n <= m;
+            return n <= m;
         }
     } else {
-        forwardMode = _jacMode == JacobianADMode::Forward;
+        return _jacMode == JacobianADMode::Forward;
     }
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseJacobianSource(MultiThreadingType multiThreadingType) {
+    /**
+     * Determine the sparsity pattern
+     */
+    determineJacobianSparsity();
+
+    bool forwardMode = isSparseJacobianForwardMode();
+
+    // the calls to the forward/reverse one functions do not pass the dynamic parameters
+    bool reuseOne = _sparseJacobianReusesOne && _fun.size_dyn_ind() == 0;
 
     /**
      * call the appropriate method for source code generation
      */
-    if (_sparseJacobianReusesOne && _forwardOne && forwardMode) {
+    if (reuseOne && _forwardOne && forwardMode) {
         generateSparseJacobianForRevSource(true, multiThreadingType);
-    } else if (_sparseJacobianReusesOne && _reverseOne && !forwardMode) {
+    } else if (reuseOne && _reverseOne && !forwardMode) {
         generateSparseJacobianForRevSource(false, multiThreadingType);
     } else {
         generateSparseJacobianSource(forwardMode);
@@ -103,14 +111,34 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
 
     const std::string jobName = "sparse Jacobian";
 
-    //size_t m = _fun.Range();
-    size_t n = _fun.Domain();
-
     startingJob("'" + jobName + "'", JobTimer::GRAPH);
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
 
+    vector<CGBase> jac = prepareSparseJacobian(handler, forward);
+
+    finishedJob();
+
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    configureLanguageC(langC, _jacobianSinglePrecision);
+    langC.setGenerateFunction(libraryFunction(FUNCTION_SPARSE_JACOBIAN));
+
+    std::ostringstream code;
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator("jac"));
+
+    handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+}
+
+template<class Base>
+std::vector<CG<Base> > ModelCSourceGen<Base>::prepareSparseJacobian(CodeHandler<Base>& handler,
+                                                                    bool forward) {
+    using std::vector;
+
+    size_t n = _fun.Domain();
+
     vector<CGBase> indVars(n);
     handler.makeVariables(indVars);
     if (_x.size() > 0) {
@@ -119,6 +147,8 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
         }
     }
 
+    makeDynamicParameterVariables(handler);
+
     vector<CGBase> jac(_jacSparsity.rows.size());
     if (_loopTapes.empty()) {
         //printSparsityPattern(_jacSparsity.sparsity, "jac sparsity");
@@ -133,18 +163,7 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
         jac = prepareSparseJacobianWithLoops(handler, indVars, forward);
     }
 
-    finishedJob();
-
-    LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-    langC.setParameterPrecision(_parameterPrecision);
-    langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_JACOBIAN);
-
-    std::ostringstream code;
-    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
-
-    handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+    return jac;
 }
 
 template<class Base>
@@ -237,8 +256,7 @@ void ModelCSourceGen<Base>::generateSparseJacobianForRevSource(bool forward,
     }
 
     _cache.str("");
-    _cache << _name << "_" << FUNCTION_SPARSE_JACOBIAN;
-    string functionName(_cache.str());
+    string functionName = libraryFunction(FUNCTION_SPARSE_JACOBIAN);
 
     if(!_multiThreading || multiThreadingType == MultiThreadingType::NONE) {
         _sources[functionName + ".c"] = generateSparseJacobianForRevSingleThreadSource(functionName, jacInfo, maxCompressedSize, functionRevFor, revForSuffix, forward);
@@ -481,8 +499,12 @@ template<class Base>
 void ModelCSourceGen<Base>::generateJacobianSparsitySource() {
     determineJacobianSparsity();
 
-    generateSparsity2DSource(_name + "_" + FUNCTION_JACOBIAN_SPARSITY, _jacSparsity);
-    _sources[_name + "_" + FUNCTION_JACOBIAN_SPARSITY + ".c"] = _cache.str();
+    generateSparsity2DSource(libraryFunction(FUNCTION_JACOBIAN_SPARSITY), _jacSparsity);
+    _sources[libraryFunction(FUNCTION_JACOBIAN_SPARSITY) + ".c"] = _cache.str();
+    _cache.str("");
+
+    generateSparsityCSRSource(libraryFunction(FUNCTION_JACOBIAN_SPARSITY_CSR), _jacSparsity, _fun.Range());
+    _sources[libraryFunction(FUNCTION_JACOBIAN_SPARSITY_CSR) + ".c"] = _cache.str();
     _cache.str("");
 }
 
@@ -97,6 +97,8 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std
             }
         }
 
+        makeDynamicParameterVariables(handler);
+
         CGBase py;
         handler.makeVariable(py);
         if (_x.size() > 0) {
@@ -121,14 +123,14 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
+        configureLanguageC(langC, _jacobianSinglePrecision);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
         langC.setGenerateFunction(_cache.str());
 
         std::ostringstream code;
-        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dw"));
-        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n);
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator("dw"));
+        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n + _fun.size_dyn_ind());
 
         handler.generateCode(code, langC, dwCustom, nameGenHess, _atomicFunctions, subJobName);
     }
@@ -155,6 +157,8 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
         }
     }
 
+    makeDynamicParameterVariables(handler);
+
     CGBase py;
     handler.makeVariable(py);
     if (_x.size() > 0) {
@@ -209,14 +213,14 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
+        configureLanguageC(langC, _jacobianSinglePrecision);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
         langC.setGenerateFunction(_cache.str());
 
         std::ostringstream code;
-        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dw"));
-        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n);
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator("dw"));
+        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n + _fun.size_dyn_ind());
 
         handler.generateCode(code, langC, dwCustom, nameGenHess, _atomicFunctions, subJobName);
     }
@@ -227,9 +231,7 @@ void ModelCSourceGen<Base>::generateReverseOneSources() {
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
 
-    _cache.str("");
-    _cache << _name << "_" << FUNCTION_REVERSE_ONE;
-    std::string model_function(_cache.str());
+    std::string model_function = libraryFunction(FUNCTION_REVERSE_ONE);
     _cache.str("");
 
     LanguageC<Base> langC(_baseTypeName);
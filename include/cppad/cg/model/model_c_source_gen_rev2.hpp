@@ -97,6 +97,8 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
             }
         }
 
+        makeDynamicParameterVariables(handler);
+
         CGBase tx1;
         handler.makeVariable(tx1);
         if (_x.size() > 0) {
@@ -129,14 +131,14 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
+        configureLanguageC(langC, _hessianSinglePrecision);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
 
         std::ostringstream code;
-        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
-        LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator("px"));
+        LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n + _fun.size_dyn_ind(), 1);
 
         handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
     }
@@ -176,6 +178,8 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
         }
     }
 
+    makeDynamicParameterVariables(handler);
+
     CGBase tx1;
     handler.makeVariable(tx1);
     if (_x.size() > 0) {
@@ -232,14 +236,14 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
+        configureLanguageC(langC, _hessianSinglePrecision);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
 
         std::ostringstream code;
-        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
-        LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createModelVariableNameGenerator("px"));
+        LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n + _fun.size_dyn_ind(), 1);
 
         handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
     }
@@ -250,9 +254,7 @@ void ModelCSourceGen<Base>::generateReverseTwoSources() {
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
 
-    _cache.str("");
-    _cache << _name << "_" << FUNCTION_REVERSE_TWO;
-    std::string model_function(_cache.str());
+    std::string model_function = libraryFunction(FUNCTION_REVERSE_TWO);
     _cache.str("");
 
     LanguageC<Base> langC(_baseTypeName);
@@ -64,6 +64,20 @@ protected:
      * Parallelization can be disabled locally for each model.
      */
     MultiThreadingType _multiThreading;
+    /**
+     * Whether or not models used as atomic functions by other models in
+     * this library are called directly from the generated code
+     */
+    bool _linkNestedModels;
+    /**
+     * Whether or not the models called directly by other models have
+     * already been determined
+     */
+    bool _nestedModelsPrepared;
+    /**
+     * The models which are called directly by other models in this library
+     */
+    std::set<std::string> _linkedModels;
     /**
      * temporary stream to generate source code
      */
@@ -78,7 +92,9 @@ public:
      *              this object)
      */
     inline ModelLibraryCSourceGen(ModelCSourceGen<Base>& model):
-        _multiThreading(MultiThreadingType::NONE) {
+        _multiThreading(MultiThreadingType::NONE),
+        _linkNestedModels(true),
+        _nestedModelsPrepared(false) {
         CPPADCG_ASSERT_KNOWN(_models.find(model.getName()) == _models.end(),
                              "Another model with the same name was already registered")
 
@@ -112,6 +128,7 @@ public:
         _models[model.getName()] = &model;
 
         _libSources.clear(); // must regenerate library sources again
+        _nestedModelsPrepared = false;
     }
 
     inline const std::map<std::string, ModelCSourceGen<Base>*>& getModels() const {
@@ -158,6 +175,55 @@ public:
         _multiThreading = multiThreading;
     }
 
+    /**
+     * Whether or not models used as atomic functions by other models in
+     * this library are called directly from the generated code.
+     *
+     * @return true if nested models are linked directly
+     */
+    inline bool isLinkNestedModels() const {
+        return _linkNestedModels;
+    }
+
+    /**
+     * Defines whether or not models used as atomic functions by other
+     * models in this library are called directly from the generated code
+     * (enabled by default).
+     * An atomic function is considered to be a model in this library if it
+     * has the same name.
+     * Direct calls avoid the round trip through the atomic function
+     * callbacks (and GenericModel::addExternalModel() is not required
+     * for those models) and they allow the compiler to inline the nested
+     * model (e.g. with link-time optimization or an amalgamated build).
+     *
+     * A model is only called directly if it creates the zero order forward
+     * mode, if it creates all the evaluation modes required by the
+     * functions enabled in the outer model (e.g., a sparse Jacobian requires
+     * the first order forward and/or reverse modes and a sparse Hessian
+     * also requires the second order reverse mode), and if all the atomic
+     * functions it uses can also be called directly.
+     * Otherwise the nested model is evaluated through the atomic function
+     * callbacks of the outer model and it must be provided with
+     * GenericModel::addExternalModel() or GenericModel::addAtomicFunction().
+     *
+     * @param link true to call nested models directly
+     */
+    inline void setLinkNestedModels(bool link) {
+        _linkNestedModels = link;
+        _nestedModelsPrepared = false;
+    }
+
+    /**
+     * Provides the models which are called directly by other models in
+     * this library.
+     *
+     * @return the names of the models called directly by other models
+     */
+    inline const std::set<std::string>& getLinkedModels() {
+        prepareNestedModels();
+        return _linkedModels;
+    }
+
     /**
      * Saves the generated C source code into several files.
      * 
@@ -186,6 +252,28 @@ protected:
 
     virtual void generateThreadPoolSources(std::map<std::string, std::string>& sources);
 
+    /**
+     * Determines which models are called directly by other models in this
+     * library and defines the atomic functions to call directly in each
+     * model source generator.
+     * This must be performed before generating the model sources.
+     */
+    virtual void prepareNestedModels();
+
+    /**
+     * Generates the C functions used to call nested models directly
+     * (<name>_atomic_forward and <name>_atomic_reverse) with the same
+     * behaviour as the atomic function callbacks.
+     */
+    virtual void generateNestedModelSources(std::map<std::string, std::string>& sources);
+
+    /**
+     * Whether or not a nested model provides all the evaluation modes
+     * which can be used by the functions enabled in an outer model.
+     */
+    static bool isNestedModelComplete(const ModelCSourceGen<Base>& outer,
+                                      const ModelCSourceGen<Base>& nested);
+
     static void saveSources(const std::string& sourcesFolder,
                             const std::map<std::string, std::string>& sources);
 
@@ -77,6 +77,8 @@ void ModelLibraryCSourceGen<Base>::saveSources(const std::string& sourcesFolder)
     // create the folder if it does not exist
     system::createFolder(sourcesFolder);
 
+    prepareNestedModels();
+
     // save/generate model sources
     for (const auto& it : _models) {
         saveSources(sourcesFolder, it.second->getSources());
@@ -104,11 +106,14 @@ void ModelLibraryCSourceGen<Base>::saveSources(const std::string& sourcesFolder,
 
 template<class Base>
 const std::map<std::string, std::string>& ModelLibraryCSourceGen<Base>::getLibrarySources() {
+    prepareNestedModels();
+
     if (_libSources.empty()) {
         generateVersionSource(_libSources);
         generateModelsSource(_libSources);
         generateOnCloseSource(_libSources);
         generateThreadPoolSources(_libSources);
+        generateNestedModelSources(_libSources);
 
         if(_multiThreading != MultiThreadingType::NONE) {
             bool usingMultiThreading = false;
@@ -165,6 +170,319 @@ void ModelLibraryCSourceGen<Base>::generateModelsSource(std::map<std::string, st
     sources[FUNCTION_MODELS + ".c"] = _cache.str();
 }
 
+template<class Base>
+void ModelLibraryCSourceGen<Base>::prepareNestedModels() {
+    if (_nestedModelsPrepared)
+        return;
+    _nestedModelsPrepared = true;
+
+    std::set<std::string> linked;
+
+    /**
+     * the atomic functions used by each model (determined from the tapes)
+     */
+    std::map<std::string, std::set<std::string> > used;
+    if (_linkNestedModels) {
+        for (const auto& p : _models) {
+            std::set<std::string>& names = used[p.first];
+            for (const auto& a : p.second->getAtomicsInfo()) {
+                names.insert(a.second.atom->atomic_name());
+            }
+        }
+
+        /**
+         * a model can only be called directly if the atomic functions it
+         * uses are also called directly (the atomic function callbacks
+         * received by the nested model belong to the outer model)
+         */
+        std::set<std::string> linkable;
+        for (const auto& p : _models) {
+            // the outer model cannot provide values for dynamic parameters
+            if (p.second->isCreateForwardZero() && p.second->getDynamicParameterSize() == 0)
+                linkable.insert(p.first);
+        }
+
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (auto it = linkable.begin(); it != linkable.end();) {
+                const ModelCSourceGen<Base>& model = *_models.at(*it);
+                bool ok = true;
+                for (const std::string& a : used.at(*it)) {
+                    if (linkable.find(a) == linkable.end() || !isNestedModelComplete(model, *_models.at(a))) {
+                        ok = false;
+                        break;
+                    }
+                }
+
+                if (ok) {
+                    ++it;
+                } else {
+                    it = linkable.erase(it);
+                    changed = true;
+                }
+            }
+        }
+
+        for (const auto& p : used) {
+            for (const std::string& a : p.second) {
+                if (linkable.find(a) != linkable.end())
+                    linked.insert(a);
+            }
+        }
+    }
+
+    for (auto& p : _models) {
+        std::set<std::string> direct;
+        if (_linkNestedModels) {
+            for (const std::string& a : used.at(p.first)) {
+                if (linked.find(a) != linked.end())
+                    direct.insert(a);
+            }
+        }
+
+        ModelCSourceGen<Base>& model = *p.second;
+        if (model._directAtomicFunctions != direct) {
+            model._directAtomicFunctions = std::move(direct);
+            model._sources.clear(); // must regenerate the model sources
+        }
+    }
+
+    if (_linkedModels != linked) {
+        _linkedModels = std::move(linked);
+        _libSources.clear(); // must regenerate library sources again
+    }
+}
+
+template<class Base>
+bool ModelLibraryCSourceGen<Base>::isNestedModelComplete(const ModelCSourceGen<Base>& outer,
+                                                         const ModelCSourceGen<Base>& nested) {
+    /**
+     * the evaluation modes of the nested model used by each enabled
+     * function of the outer model
+     */
+    bool jacobian = outer.isCreateJacobian() || outer.isCreateSparseJacobian();
+    bool jacobianFor = jacobian && outer.getJacobianADMode() != JacobianADMode::Reverse;
+    bool jacobianRev = jacobian && outer.getJacobianADMode() != JacobianADMode::Forward;
+    bool hessian = outer.isCreateHessian() || outer.isCreateSparseHessian() || outer.isCreateSparseHessianLower() ||
+                   outer.isCreateReverseTwo() || outer.getHessianVectorDirections() > 0;
+
+    // only the zero and first order forward modes can be called directly
+    if (outer.getForwardTaylorOrder() > 1)
+        return false;
+
+    bool forwardOne = outer.isCreateSparseForwardOne() || jacobianFor || hessian || outer.getForwardTaylorOrder() == 1;
+    bool reverseOne = outer.isCreateReverseOne() || jacobianRev || hessian;
+    bool reverseTwo = hessian;
+
+    return (!forwardOne || nested.isCreateSparseForwardOne()) &&
+           (!reverseOne || nested.isCreateReverseOne()) &&
+           (!reverseTwo || nested.isCreateReverseTwo());
+}
+
+template<class Base>
+void ModelLibraryCSourceGen<Base>::generateNestedModelSources(std::map<std::string, std::string>& sources) {
+    const std::string& DIRECT_FORWARD = LanguageC<Base>::DIRECT_ATOMIC_FORWARD;
+    const std::string& DIRECT_REVERSE = LanguageC<Base>::DIRECT_ATOMIC_REVERSE;
+
+    for (const std::string& name : _linkedModels) {
+        const ModelCSourceGen<Base>& model = *_models.at(name);
+        const std::string& baseType = model._baseTypeName;
+        size_t m = model._fun.Range();
+        size_t n = model._fun.Domain();
+        bool forwardOne = model.isCreateSparseForwardOne();
+        bool reverseOne = model.isCreateReverseOne();
+        bool reverseTwo = model.isCreateReverseTwo();
+
+        LanguageC<Base> langC(baseType);
+        std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+
+        /**
+         * forward mode
+         */
+        _cache.str("");
+        _cache << "#include <stdlib.h>\n"
+                << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
+                "\n"
+                "void " << name << "_" << ModelCSourceGen<Base>::FUNCTION_FORWAD_ZERO << "(" << argsDcl << ");\n";
+        if (forwardOne) {
+            _cache << "int " << name << "_" << ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE << "(unsigned long pos, " << argsDcl << ");\n"
+                    "void " << name << "_" << ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+        }
+        _cache << "\n";
+        LanguageC<Base>::printFunctionDeclaration(_cache, "int", name + "_" + DIRECT_FORWARD, {"struct LangCAtomicFun atomicFun",
+                                                                                               "int atomicIndex",
+                                                                                               "int q",
+                                                                                               "int p",
+                                                                                               "const Array tx[]",
+                                                                                               "Array* ty"});
+        _cache << " {\n"
+                "   " << baseType << " const * in[2];\n"
+                "   " << baseType << "* out[1];\n";
+        if (forwardOne) {
+            _cache << "   " << baseType << " const * tx1;\n"
+                    "   " << baseType << "* ty1;\n"
+                    "   " << baseType << "* compressed;\n"
+                    "   unsigned long const* pos;\n"
+                    "   unsigned long e, ePos, i, j, nnz, nnzTx;\n"
+                    "   int ret;\n";
+        }
+        _cache << "\n"
+                "   in[0] = (" << baseType << " const *) tx[0].data;\n"
+                "   if (p == 0) {\n"
+                "      out[0] = (" << baseType << "*) ty->data;\n"
+                "      " << name << "_" << ModelCSourceGen<Base>::FUNCTION_FORWAD_ZERO << "(in, out, atomicFun);\n"
+                "      return 1;\n"
+                "   }\n";
+        if (forwardOne) {
+            _cache << "   if (p == 1) {\n"
+                    "      ty1 = (" << baseType << "*) ty->data;\n"
+                    "      for (i = 0; i < " << m << "; i++)\n"
+                    "         ty1[i] = 0;\n"
+                    "\n"
+                    "      tx1 = (" << baseType << " const *) tx[1].data;\n"
+                    "      nnzTx = tx[1].sparse ? tx[1].nnz : tx[1].size;\n"
+                    "      if (nnzTx == 0)\n"
+                    "         return 1; //nothing to do\n"
+                    "\n"
+                    "      compressed = (" << baseType << "*) malloc(" << m << " * sizeof(" << baseType << "));\n"
+                    "      if (compressed == NULL)\n"
+                    "         return 0; // failure to allocate memory\n"
+                    "      out[0] = compressed;\n"
+                    "\n"
+                    "      for (e = 0; e < nnzTx; e++) {\n"
+                    "         j = tx[1].sparse ? tx[1].idx[e] : e;\n"
+                    "         " << name << "_" << ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE_SPARSITY << "(j, &pos, &nnz);\n"
+                    "         if (nnz == 0)\n"
+                    "            continue;\n"
+                    "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                    "            compressed[ePos] = 0;\n"
+                    "\n"
+                    "         in[1] = &tx1[e];\n"
+                    "         ret = " << name << "_" << ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE << "(j, in, out, atomicFun);\n"
+                    "         if (ret != 0) {\n"
+                    "            free(compressed);\n"
+                    "            return 0;\n"
+                    "         }\n"
+                    "\n"
+                    "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                    "            ty1[pos[ePos]] += compressed[ePos];\n"
+                    "      }\n"
+                    "\n"
+                    "      free(compressed);\n"
+                    "      return 1;\n"
+                    "   }\n";
+        }
+        _cache << "\n"
+                "   // not available in the nested model\n"
+                "   return atomicFun.forward(atomicFun.libModel, atomicIndex, q, p, tx, ty);\n"
+                "}\n\n";
+
+        sources[name + "_" + DIRECT_FORWARD + ".c"] = _cache.str();
+
+        /**
+         * reverse mode
+         */
+        _cache.str("");
+        _cache << "#include <stdlib.h>\n"
+                << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
+                "\n";
+        if (reverseOne) {
+            _cache << "int " << name << "_" << ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_ONE << "(unsigned long pos, " << argsDcl << ");\n"
+                    "void " << name << "_" << ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+        }
+        if (reverseTwo) {
+            _cache << "int " << name << "_" << ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO << "(unsigned long pos, " << argsDcl << ");\n"
+                    "void " << name << "_" << ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+        }
+        _cache << "\n";
+        LanguageC<Base>::printFunctionDeclaration(_cache, "int", name + "_" + DIRECT_REVERSE, {"struct LangCAtomicFun atomicFun",
+                                                                                               "int atomicIndex",
+                                                                                               "int p",
+                                                                                               "const Array tx[]",
+                                                                                               "Array* px",
+                                                                                               "const Array py[]"});
+        _cache << " {\n";
+        if (reverseOne || reverseTwo) {
+            /**
+             * p == 0: first order reverse mode with the sparse direction py[0]
+             * p == 1: second order reverse mode with the sparse direction tx[1]
+             */
+            auto printReverse = [&](const std::string& sparsityFunc,
+                                    const std::string& sparseFunc,
+                                    const std::string& indent) {
+                _cache << indent << name << "_" << sparsityFunc << "(k, &pos, &nnz);\n"
+                       << indent << "if (nnz == 0)\n"
+                       << indent << "   continue;\n"
+                       << indent << "for (ePos = 0; ePos < nnz; ePos++)\n"
+                       << indent << "   compressed[ePos] = 0;\n"
+                       << indent << "ret = " << name << "_" << sparseFunc << "(k, in, out, atomicFun);\n";
+            };
+
+            _cache << "   " << baseType << " const * in[3];\n"
+                    "   " << baseType << "* out[1];\n"
+                    "   " << baseType << " const * v;\n"
+                    "   " << baseType << "* px0;\n"
+                    "   " << baseType << "* compressed;\n"
+                    "   const Array* a;\n"
+                    "   unsigned long const* pos;\n"
+                    "   unsigned long e, ePos, j, k, nnz, nnzV;\n"
+                    "   int ret;\n"
+                    "\n"
+                    "   if (" << (reverseOne && reverseTwo ? "p == 0 || p == 1" : (reverseOne ? "p == 0" : "p == 1")) << ") {\n"
+                    "      px0 = (" << baseType << "*) px->data;\n"
+                    "      for (j = 0; j < " << n << "; j++)\n"
+                    "         px0[j] = 0;\n"
+                    "\n"
+                    "      a = p == 0 ? &py[0] : &tx[1];\n"
+                    "      v = (" << baseType << " const *) a->data;\n"
+                    "      nnzV = a->sparse ? a->nnz : a->size;\n"
+                    "      if (nnzV == 0)\n"
+                    "         return 1; //nothing to do\n"
+                    "\n"
+                    "      compressed = (" << baseType << "*) malloc(" << n << " * sizeof(" << baseType << "));\n"
+                    "      if (compressed == NULL)\n"
+                    "         return 0; // failure to allocate memory\n"
+                    "      in[0] = (" << baseType << " const *) tx[0].data;\n"
+                    "      in[2] = p == 1 ? (" << baseType << " const *) py[1].data : 0;\n"
+                    "      out[0] = compressed;\n"
+                    "\n"
+                    "      for (e = 0; e < nnzV; e++) {\n"
+                    "         k = a->sparse ? a->idx[e] : e;\n"
+                    "         in[1] = &v[e];\n";
+            if (reverseOne && reverseTwo) {
+                _cache << "         if (p == 0) {\n";
+                printReverse(ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE_SPARSITY, ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_ONE, "            ");
+                _cache << "         } else {\n";
+                printReverse(ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO_SPARSITY, ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO, "            ");
+                _cache << "         }\n";
+            } else if (reverseOne) {
+                printReverse(ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE_SPARSITY, ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_ONE, "         ");
+            } else {
+                printReverse(ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO_SPARSITY, ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO, "         ");
+            }
+            _cache << "         if (ret != 0) {\n"
+                    "            free(compressed);\n"
+                    "            return 0;\n"
+                    "         }\n"
+                    "\n"
+                    "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                    "            px0[pos[ePos]] += compressed[ePos];\n"
+                    "      }\n"
+                    "\n"
+                    "      free(compressed);\n"
+                    "      return 1;\n"
+                    "   }\n"
+                    "\n";
+        }
+        _cache << "   // not available in the nested model\n"
+                "   return atomicFun.reverse(atomicFun.libModel, atomicIndex, p, tx, px, py);\n"
+                "}\n\n";
+
+        sources[name + "_" + DIRECT_REVERSE + ".c"] = _cache.str();
+    }
+}
+
 template<class Base>
 void ModelLibraryCSourceGen<Base>::generateOnCloseSource(std::map<std::string, std::string>& sources) {
     bool pthreads = false;
@@ -28,14 +28,51 @@ template<class Base>
 class ModelLibraryProcessor {
 protected:
     ModelLibraryCSourceGen<Base>* modelLibraryHelper_;
+    /**
+     * the number of translation units used for the source files of each
+     * model (zero to compile each source file separately)
+     */
+    size_t translationUnits_;
 public:
 
     inline explicit ModelLibraryProcessor(ModelLibraryCSourceGen<Base>& modelLibraryHelper) :
-        modelLibraryHelper_(&modelLibraryHelper) {
+        modelLibraryHelper_(&modelLibraryHelper),
+        translationUnits_(0) {
     }
 
     inline virtual ~ModelLibraryProcessor() = default;
 
+    /**
+     * Provides the number of translation units used to compile the source
+     * files of each model.
+     *
+     * @return the number of translation units or zero if each source file
+     *         is compiled separately (default)
+     */
+    inline size_t getTranslationUnits() const {
+        return translationUnits_;
+    }
+
+    /**
+     * Defines the number of translation units used to compile the source
+     * files of each model (amalgamated build).
+     * Source files with consecutive names, which are usually related
+     * functions, are placed in the same translation unit so that the
+     * compiler can inline small functions such as the row and column
+     * functions called by the sparse Jacobian and Hessian functions.
+     * Functions which are not loaded from the library are given hidden
+     * visibility which, like static linkage, allows them to be inlined in
+     * position-independent code.
+     * Fewer translation units usually result in faster code but in longer
+     * compilation times.
+     *
+     * @param n the number of translation units per model or zero to
+     *          compile each source file separately
+     */
+    inline void setTranslationUnits(size_t n) {
+        translationUnits_ = n;
+    }
+
 protected:
 
     inline const std::map<std::string, std::string>& getLibrarySources() {
@@ -43,9 +80,105 @@ protected:
     }
 
     inline const std::map<std::string, std::string>& getSources(ModelCSourceGen<Base>& model) {
+        modelLibraryHelper_->prepareNestedModels();
         return model.getSources(modelLibraryHelper_->getMultiThreading(), modelLibraryHelper_);
     }
 
+    /**
+     * Groups the source files of a model into getTranslationUnits()
+     * translation units with a similar size.
+     * Definitions which are repeated in each generated source file with
+     * different contents (the function pointer type and the structures used
+     * with the thread pool) are renamed with macros and the system headers
+     * are included before any visibility pragma.
+     *
+     * @param model the model which generated the sources
+     * @param sources maps the source file names to their contents
+     * @return maps the names of the translation units to their contents
+     */
+    inline std::map<std::string, std::string> amalgamate(const ModelCSourceGen<Base>& model,
+                                                         const std::map<std::string, std::string>& sources) const {
+        CPPADCG_ASSERT_KNOWN(translationUnits_ > 0, "The number of translation units must be positive")
+
+        static const std::vector<std::string> renamed{"cppadcg_function_type", "ExecArgStruct", "exec_func"};
+
+        const std::string& modelName = model.getName();
+
+        /**
+         * functions loaded from the dynamic library
+         */
+        std::set<std::string> api;
+        for (const std::string& f : model.getLibraryFunctions()) {
+            api.insert(f + ".c");
+        }
+
+        /**
+         * split the sources (in name order) into groups of similar size
+         */
+        size_t total = 0;
+        for (const auto& s : sources)
+            total += s.second.size();
+
+        size_t n = std::min(translationUnits_, sources.size());
+        std::vector<std::vector<const std::pair<const std::string, std::string>*> > groups(n);
+        size_t accumulated = 0;
+        for (const auto& s : sources) {
+            size_t g = std::min<size_t>(n - 1, (accumulated * n) / std::max<size_t>(total, 1));
+            groups[g].push_back(&s);
+            accumulated += s.second.size();
+        }
+
+        std::map<std::string, std::string> units;
+        std::ostringstream out;
+        size_t id = 0;
+        for (size_t g = 0; g < groups.size(); g++) {
+            if (groups[g].empty())
+                continue;
+
+            out.str("");
+            out << "/* translation unit " << (g + 1) << " of " << n << " for model '" << modelName << "' */\n\n";
+
+            // system headers must not be affected by the visibility pragma
+            std::set<std::string> includes;
+            for (const auto* s : groups[g]) {
+                std::istringstream lines(s->second);
+                std::string line;
+                while (std::getline(lines, line)) {
+                    if (line.compare(0, 10, "#include <") == 0)
+                        includes.insert(line);
+                }
+            }
+            for (const std::string& inc : includes)
+                out << inc << "\n";
+            out << "\n";
+
+            // functions which are not loaded from the library are defined first
+            for (bool isApi : {false, true}) {
+                for (const auto* s : groups[g]) {
+                    if ((api.find(s->first) != api.end()) != isApi)
+                        continue;
+
+                    out << "/* " << s->first << " */\n";
+                    if (!isApi)
+                        out << "#pragma GCC visibility push(hidden)\n";
+                    for (const std::string& r : renamed)
+                        out << "#define " << r << " " << r << "_" << id << "\n";
+                    out << s->second << "\n";
+                    for (const std::string& r : renamed)
+                        out << "#undef " << r << "\n";
+                    if (!isApi)
+                        out << "#pragma GCC visibility pop\n";
+                    out << "\n";
+                    id++;
+                }
+            }
+
+            units[modelName + "_unit" + std::to_string(g) + ".c"] = out.str();
+        }
+
+        return units;
+    }
+
 };
 
 } // END cg namespace
@@ -346,7 +346,7 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
 
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJcolDcl);
-            langC.setParameterPrecision(_parameterPrecision);
+            configureLanguageC(langC, false);
 
             _cache.str("");
             std::ostringstream code;
@@ -404,7 +404,7 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
     /**
      * 
      */
-    string functionFor1 = _name + "_" + FUNCTION_SPARSE_FORWARD_ONE;
+    string functionFor1 = libraryFunction(FUNCTION_SPARSE_FORWARD_ONE);
     _sources[functionFor1 + ".c"] = generateGlobalForRevWithLoopsFunctionSource(elements,
                                                                                 _loopFor1Groups, _nonLoopFor1Elements,
                                                                                 functionFor1, _name, _baseTypeName, "indep",
@@ -413,8 +413,8 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
      * Sparsity
      */
     _cache.str("");
-    generateSparsity1DSource2(_name + "_" + FUNCTION_FORWARD_ONE_SPARSITY, elements);
-    _sources[_name + "_" + FUNCTION_FORWARD_ONE_SPARSITY + ".c"] = _cache.str();
+    generateSparsity1DSource2(libraryFunction(FUNCTION_FORWARD_ONE_SPARSITY), elements);
+    _sources[libraryFunction(FUNCTION_FORWARD_ONE_SPARSITY) + ".c"] = _cache.str();
     _cache.str("");
 }
 
@@ -430,7 +430,7 @@ void ModelCSourceGen<Base>::createForwardOneWithLoopsNL(CodeHandler<Base>& handl
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-    langC.setParameterPrecision(_parameterPrecision);
+    configureLanguageC(langC, false);
     _cache.str("");
     _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_noloop_indep" << j;
     langC.setGenerateFunction(_cache.str());
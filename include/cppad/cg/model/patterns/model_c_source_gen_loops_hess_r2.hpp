@@ -32,7 +32,7 @@ void ModelCSourceGen<Base>::generateSparseHessianWithLoopsSourceFromRev2(const s
     LanguageC<Base> langC(_baseTypeName);
     string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
 
-    string model_function = _name + "_" + FUNCTION_SPARSE_HESSIAN;
+    string model_function = libraryFunction(FUNCTION_SPARSE_HESSIAN);
     string functionRev2 = _name + "_" + FUNCTION_SPARSE_REVERSE_TWO;
     string suffix = "indep";
     string nlRev2Suffix = "noloop_" + suffix;
@@ -38,7 +38,7 @@ void ModelCSourceGen<Base>::generateSparseJacobianWithLoopsSourceFromForRev(cons
     LanguageC<Base> langC(_baseTypeName);
     string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
 
-    string model_function = _name + "_" + FUNCTION_SPARSE_JACOBIAN;
+    string model_function = libraryFunction(FUNCTION_SPARSE_JACOBIAN);
     string localFunction = _name + "_" + localFunctionTypeName;
     string nlSuffix = "noloop_" + suffix;
 
@@ -281,7 +281,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
              */
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJrowDcl);
-            langC.setParameterPrecision(_parameterPrecision);
+            configureLanguageC(langC, false);
 
             _cache.str("");
             std::ostringstream code;
@@ -339,7 +339,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
     /**
      * 
      */
-    string functionRev1 = _name + "_" + FUNCTION_SPARSE_REVERSE_ONE;
+    string functionRev1 = libraryFunction(FUNCTION_SPARSE_REVERSE_ONE);
     _sources[functionRev1 + ".c"] = generateGlobalForRevWithLoopsFunctionSource(elements,
                                                                                 _loopRev1Groups, _nonLoopRev1Elements,
                                                                                 functionRev1, _name, _baseTypeName, "dep",
@@ -348,8 +348,8 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
      * Sparsity
      */
     _cache.str("");
-    generateSparsity1DSource2(_name + "_" + FUNCTION_REVERSE_ONE_SPARSITY, elements);
-    _sources[_name + "_" + FUNCTION_REVERSE_ONE_SPARSITY + ".c"] = _cache.str();
+    generateSparsity1DSource2(libraryFunction(FUNCTION_REVERSE_ONE_SPARSITY), elements);
+    _sources[libraryFunction(FUNCTION_REVERSE_ONE_SPARSITY) + ".c"] = _cache.str();
     _cache.str("");
 }
 
@@ -365,7 +365,7 @@ void ModelCSourceGen<Base>::createReverseOneWithLoopsNL(CodeHandler<Base>& handl
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-    langC.setParameterPrecision(_parameterPrecision);
+    configureLanguageC(langC, false);
     _cache.str("");
     _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_noloop_dep" << i;
     langC.setGenerateFunction(_cache.str());
@@ -382,7 +382,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
 
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJrowDcl);
-            langC.setParameterPrecision(_parameterPrecision);
+            configureLanguageC(langC, false);
 
             std::ostringstream code;
             std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
@@ -525,7 +525,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
                 LanguageC<Base> langC(_baseTypeName);
                 langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
                 langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-                langC.setParameterPrecision(_parameterPrecision);
+                configureLanguageC(langC, false);
                 _cache.str("");
                 _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_noloop_indep" << j;
                 string functionName = _cache.str();
@@ -546,7 +546,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
     /**
      * 
      */
-    string functionRev2 = _name + "_" + FUNCTION_SPARSE_REVERSE_TWO;
+    string functionRev2 = libraryFunction(FUNCTION_SPARSE_REVERSE_TWO);
     _sources[functionRev2 + ".c"] = generateGlobalForRevWithLoopsFunctionSource(elements,
                                                                                 _loopRev2Groups, _nonLoopRev2Elements,
                                                                                 functionRev2, _name, _baseTypeName, "indep",
@@ -555,8 +555,8 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
      * Sparsity
      */
     _cache.str("");
-    generateSparsity1DSource2(_name + "_" + FUNCTION_REVERSE_TWO_SPARSITY, elements);
-    _sources[_name + "_" + FUNCTION_REVERSE_TWO_SPARSITY + ".c"] = _cache.str();
+    generateSparsity1DSource2(libraryFunction(FUNCTION_REVERSE_TWO_SPARSITY), elements);
+    _sources[libraryFunction(FUNCTION_REVERSE_TWO_SPARSITY) + ".c"] = _cache.str();
     _cache.str("");
 }
 
@@ -0,0 +1,644 @@
+#ifndef CPPAD_CG_RELOADABLE_GENERIC_MODEL_INCLUDED
+#define CPPAD_CG_RELOADABLE_GENERIC_MODEL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A model which owns the model library it was loaded from and which can
+ * replace that library by a new one (e.g. a recompiled dynamic library)
+ * while the model is being used.
+ *
+ * A replacement library is only accepted if it contains a model with the
+ * same name, domain, range, and atomic functions and, for
+ * FunctorModelLibrary objects, the same API version.
+ * Evaluations which start after reload() use the new library while
+ * evaluations which started before continue with the previous one.
+ * The previous library is only closed once all of those evaluations have
+ * finished (reference counting similar to read-copy-update).
+ *
+ * Evaluations may be performed in other threads while reload() is
+ * executing, however, simultaneous evaluations are only safe if the
+ * loaded models support them.
+ * Dynamic libraries should be given a different file name for each
+ * version since the operating system may return the previously loaded
+ * library for the same path.
+ * Sparsity pointers returned by the SparseJacobian() and SparseHessian()
+ * methods belong to the library which was active during the call and must
+ * not be used after a reload.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class ReloadableGenericModel : public GenericModel<Base> {
+protected:
+    /**
+     * A loaded library and its model
+     * (the model is deleted before the library)
+     */
+    struct Generation {
+        std::unique_ptr<ModelLibrary<Base> > library;
+        std::unique_ptr<GenericModel<Base> > model;
+    };
+
+    /**
+     * Registers an evaluation in the current generation so that its
+     * library is not closed during the evaluation.
+     */
+    class ActiveCall {
+    private:
+        std::atomic<size_t>& _calls;
+        GenericModel<Base>* _model;
+    public:
+        inline explicit ActiveCall(ReloadableGenericModel& m) :
+                _calls(m._calls[m._epoch.load() & 1]) {
+            _calls.fetch_add(1);
+            _model = m._current.load()->model.get();
+        }
+
+        ActiveCall(const ActiveCall&) = delete;
+        ActiveCall& operator=(const ActiveCall&) = delete;
+
+        inline ~ActiveCall() {
+            _calls.fetch_sub(1);
+        }
+
+        inline GenericModel<Base>* operator->() const {
+            return _model;
+        }
+    };
+
+protected:
+    const std::string _name;
+    // the library and model which are currently used (protected by _mutex)
+    std::unique_ptr<Generation> _generation;
+    // the generation used by new evaluations
+    std::atomic<Generation*> _current;
+    // defines which counter is incremented by new evaluations
+    std::atomic<size_t> _epoch;
+    // the number of evaluations in progress for each epoch parity
+    std::atomic<size_t> _calls[2];
+    // the properties which must be kept by new libraries
+    size_t _domain;
+    size_t _range;
+    std::vector<std::string> _atomicNames;
+    // serializes reloads and the registration of atomic functions
+    mutable std::mutex _mutex;
+    std::vector<atomic_base<Base>*> _atomics;
+    std::vector<ArrayViewAtomicFun<Base>*> _arrayViewAtomics;
+    std::vector<GenericModel<Base>*> _externalModels;
+    // the dynamic parameters which must be used by new libraries
+    std::vector<Base> _parameters;
+    size_t _reloads;
+public:
+
+    /**
+     * Creates a new model using a library.
+     *
+     * @param library the library which contains the model (it is owned
+     *                by this object)
+     * @param modelName the name of the model in the library
+     * @throws CGException if the model does not exist in the library
+     */
+    ReloadableGenericModel(std::unique_ptr<ModelLibrary<Base> > library,
+                           std::string modelName) :
+            _name(std::move(modelName)),
+            _current(nullptr),
+            _epoch(0),
+            _domain(0),
+            _range(0),
+            _reloads(0) {
+        _calls[0].store(0);
+        _calls[1].store(0);
+
+        _generation = load(std::move(library));
+
+        GenericModel<Base>& model = *_generation->model;
+        _domain = model.Domain();
+        _range = model.Range();
+        _atomicNames = model.getAtomicFunctionNames();
+
+        _current.store(_generation.get());
+    }
+
+    ReloadableGenericModel(const ReloadableGenericModel&) = delete;
+    ReloadableGenericModel& operator=(const ReloadableGenericModel&) = delete;
+
+    /**
+     * All evaluations must have finished before the model is deleted.
+     */
+    virtual ~ReloadableGenericModel() = default;
+
+    /**
+     * Replaces the model library.
+     * New evaluations use the model in the new library once this method
+     * starts to wait for the evaluations using the previous library.
+     * This method only returns after the previous library is closed.
+     * It must not be called from inside an evaluation of this model
+     * (e.g. by an atomic function).
+     *
+     * @param library the new library (it is owned by this object)
+     * @throws CGException if the library is not compatible with the
+     *                     current one (the current library is kept)
+     */
+    virtual void reload(std::unique_ptr<ModelLibrary<Base> > library) {
+        std::unique_ptr<Generation> g = load(std::move(library));
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        validate(*g);
+        addAtomics(*g->model);
+        if (!_parameters.empty()) {
+            g->model->setDynamicParameters(_parameters);
+        }
+
+        _current.store(g.get());
+        std::unique_ptr<Generation> previous = std::move(_generation);
+        _generation = std::move(g);
+        _reloads++;
+
+        synchronize();
+
+        previous.reset(); // closes the previous library
+    }
+
+    /**
+     * Provides the number of times the library was successfully replaced.
+     */
+    inline size_t getReloadCount() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _reloads;
+    }
+
+    const std::string& getName() const override {
+        return _name;
+    }
+
+    const std::vector<std::string>& getAtomicFunctionNames() override {
+        return _atomicNames; // all libraries must have the same names
+    }
+
+    bool addAtomicFunction(atomic_base<Base>& atomic) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _atomics.push_back(&atomic);
+        return _generation->model->addAtomicFunction(atomic);
+    }
+
+    bool addAtomicFunction(ArrayViewAtomicFun<Base>& atomic) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _arrayViewAtomics.push_back(&atomic);
+        return _generation->model->addAtomicFunction(atomic);
+    }
+
+    bool addExternalModel(GenericModel<Base>& atomic) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _externalModels.push_back(&atomic);
+        return _generation->model->addExternalModel(atomic);
+    }
+
+    size_t Domain() const override {
+        return _domain;
+    }
+
+    size_t Range() const override {
+        return _range;
+    }
+
+    size_t DynamicParameterSize() const override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _generation->model->DynamicParameterSize();
+    }
+
+    /**
+     * Defines the values of the dynamic parameters of the current model.
+     * The values are also provided to the models of the libraries loaded
+     * later.
+     * It must not be called while there are evaluations in progress.
+     */
+    void setDynamicParameters(ArrayView<const Base> p) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _generation->model->setDynamicParameters(p);
+        _parameters.assign(p.begin(), p.end());
+    }
+
+    bool isJacobianSinglePrecision() const override {
+        ActiveCall call(const_cast<ReloadableGenericModel&>(*this));
+        return call->isJacobianSinglePrecision();
+    }
+
+    bool isHessianSinglePrecision() const override {
+        ActiveCall call(const_cast<ReloadableGenericModel&>(*this));
+        return call->isHessianSinglePrecision();
+    }
+
+    // Jacobian sparsity
+    bool isJacobianSparsityAvailable() override {
+        ActiveCall call(*this);
+        return call->isJacobianSparsityAvailable();
+    }
+
+    std::vector<std::set<size_t> > JacobianSparsitySet() override {
+        ActiveCall call(*this);
+        return call->JacobianSparsitySet();
+    }
+
+    std::vector<bool> JacobianSparsityBool() override {
+        ActiveCall call(*this);
+        return call->JacobianSparsityBool();
+    }
+
+    void JacobianSparsity(std::vector<size_t>& equations,
+                          std::vector<size_t>& variables) override {
+        ActiveCall call(*this);
+        call->JacobianSparsity(equations, variables);
+    }
+
+    // Hessian sparsity
+    bool isHessianSparsityAvailable() override {
+        ActiveCall call(*this);
+        return call->isHessianSparsityAvailable();
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet() override {
+        ActiveCall call(*this);
+        return call->HessianSparsitySet();
+    }
+
+    std::vector<bool> HessianSparsityBool() override {
+        ActiveCall call(*this);
+        return call->HessianSparsityBool();
+    }
+
+    void HessianSparsity(std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        ActiveCall call(*this);
+        call->HessianSparsity(rows, cols);
+    }
+
+    bool isEquationHessianSparsityAvailable() override {
+        ActiveCall call(*this);
+        return call->isEquationHessianSparsityAvailable();
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet(size_t i) override {
+        ActiveCall call(*this);
+        return call->HessianSparsitySet(i);
+    }
+
+    std::vector<bool> HessianSparsityBool(size_t i) override {
+        ActiveCall call(*this);
+        return call->HessianSparsityBool(i);
+    }
+
+    void HessianSparsity(size_t i,
+                         std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        ActiveCall call(*this);
+        call->HessianSparsity(i, rows, cols);
+    }
+
+    // zero order forward mode
+    bool isForwardZeroAvailable() override {
+        ActiveCall call(*this);
+        return call->isForwardZeroAvailable();
+    }
+
+    using GenericModel<Base>::ForwardZero;
+
+    void ForwardZero(const CppAD::vector<bool>& vx,
+                     CppAD::vector<bool>& vy,
+                     ArrayView<const Base> tx,
+                     ArrayView<Base> ty) override {
+        ActiveCall call(*this);
+        call->ForwardZero(vx, vy, tx, ty);
+    }
+
+    void ForwardZero(ArrayView<const Base> x,
+                     ArrayView<Base> dep) override {
+        ActiveCall call(*this);
+        call->ForwardZero(x, dep);
+    }
+
+    void ForwardZero(const std::vector<const Base*>& x,
+                     ArrayView<Base> dep) override {
+        ActiveCall call(*this);
+        call->ForwardZero(x, dep);
+    }
+
+    // dense Jacobian and Hessian
+    bool isJacobianAvailable() override {
+        ActiveCall call(*this);
+        return call->isJacobianAvailable();
+    }
+
+    void Jacobian(ArrayView<const Base> x,
+                  ArrayView<Base> jac) override {
+        ActiveCall call(*this);
+        call->Jacobian(x, jac);
+    }
+
+    bool isHessianAvailable() override {
+        ActiveCall call(*this);
+        return call->isHessianAvailable();
+    }
+
+    void Hessian(ArrayView<const Base> x,
+                 ArrayView<const Base> w,
+                 ArrayView<Base> hess) override {
+        ActiveCall call(*this);
+        call->Hessian(x, w, hess);
+    }
+
+    // directional derivatives
+    bool isForwardOneAvailable() override {
+        ActiveCall call(*this);
+        return call->isForwardOneAvailable();
+    }
+
+    void ForwardOne(ArrayView<const Base> tx,
+                    ArrayView<Base> ty) override {
+        ActiveCall call(*this);
+        call->ForwardOne(tx, ty);
+    }
+
+    bool isSparseForwardOneAvailable() override {
+        ActiveCall call(*this);
+        return call->isSparseForwardOneAvailable();
+    }
+
+    void ForwardOne(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> ty1) override {
+        ActiveCall call(*this);
+        call->ForwardOne(x, tx1Nnz, idx, tx1, ty1);
+    }
+
+    bool isReverseOneAvailable() override {
+        ActiveCall call(*this);
+        return call->isReverseOneAvailable();
+    }
+
+    void ReverseOne(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        ActiveCall call(*this);
+        call->ReverseOne(tx, ty, px, py);
+    }
+
+    bool isSparseReverseOneAvailable() override {
+        ActiveCall call(*this);
+        return call->isSparseReverseOneAvailable();
+    }
+
+    void ReverseOne(ArrayView<const Base> x,
+                    ArrayView<Base> px,
+                    size_t pyNnz, const size_t idx[], const Base py[]) override {
+        ActiveCall call(*this);
+        call->ReverseOne(x, px, pyNnz, idx, py);
+    }
+
+    bool isReverseTwoAvailable() override {
+        ActiveCall call(*this);
+        return call->isReverseTwoAvailable();
+    }
+
+    void ReverseTwo(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        ActiveCall call(*this);
+        call->ReverseTwo(tx, ty, px, py);
+    }
+
+    bool isSparseReverseTwoAvailable() override {
+        ActiveCall call(*this);
+        return call->isSparseReverseTwoAvailable();
+    }
+
+    void ReverseTwo(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> px2,
+                    ArrayView<const Base> py2) override {
+        ActiveCall call(*this);
+        call->ReverseTwo(x, tx1Nnz, idx, tx1, px2, py2);
+    }
+
+    // sparse Jacobian
+    bool isSparseJacobianAvailable() override {
+        ActiveCall call(*this);
+        return call->isSparseJacobianAvailable();
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac) override {
+        ActiveCall call(*this);
+        call->SparseJacobian(x, jac);
+    }
+
+    void SparseJacobian(const std::vector<Base>& x,
+                        std::vector<Base>& jac,
+                        std::vector<size_t>& row,
+                        std::vector<size_t>& col) override {
+        ActiveCall call(*this);
+        call->SparseJacobian(x, jac, row, col);
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        ActiveCall call(*this);
+        call->SparseJacobian(x, jac, row, col);
+    }
+
+    void SparseJacobian(const std::vector<const Base*>& x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        ActiveCall call(*this);
+        call->SparseJacobian(x, jac, row, col);
+    }
+
+    // sparse Hessian
+    bool isSparseHessianAvailable() override {
+        ActiveCall call(*this);
+        return call->isSparseHessianAvailable();
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess) override {
+        ActiveCall call(*this);
+        call->SparseHessian(x, w, hess);
+    }
+
+    void SparseHessian(const std::vector<Base>& x,
+                       const std::vector<Base>& w,
+                       std::vector<Base>& hess,
+                       std::vector<size_t>& row,
+                       std::vector<size_t>& col) override {
+        ActiveCall call(*this);
+        call->SparseHessian(x, w, hess, row, col);
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        ActiveCall call(*this);
+        call->SparseHessian(x, w, hess, row, col);
+    }
+
+    void SparseHessian(const std::vector<const Base*>& x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        ActiveCall call(*this);
+        call->SparseHessian(x, w, hess, row, col);
+    }
+
+    // sparse lower Hessian
+    bool isSparseHessianLowerAvailable() override {
+        ActiveCall call(*this);
+        return call->isSparseHessianLowerAvailable();
+    }
+
+    void SparseHessianLower(ArrayView<const Base> x,
+                            ArrayView<const Base> w,
+                            ArrayView<Base> hess) override {
+        ActiveCall call(*this);
+        call->SparseHessianLower(x, w, hess);
+    }
+
+    // forward Taylor
+    bool isForwardTaylorAvailable() override {
+        ActiveCall call(*this);
+        return call->isForwardTaylorAvailable();
+    }
+
+    size_t ForwardTaylorOrder() override {
+        ActiveCall call(*this);
+        return call->ForwardTaylorOrder();
+    }
+
+    void ForwardTaylor(ArrayView<const Base> tx,
+                       ArrayView<Base> ty) override {
+        ActiveCall call(*this);
+        call->ForwardTaylor(tx, ty);
+    }
+
+    // Hessian-vector product
+    bool isHessianVectorProductAvailable() override {
+        ActiveCall call(*this);
+        return call->isHessianVectorProductAvailable();
+    }
+
+    size_t HessianVectorDirections() override {
+        ActiveCall call(*this);
+        return call->HessianVectorDirections();
+    }
+
+    void HessianVectorProduct(ArrayView<const Base> x,
+                              ArrayView<const Base> w,
+                              ArrayView<const Base> v,
+                              ArrayView<Base> hv) override {
+        ActiveCall call(*this);
+        call->HessianVectorProduct(x, w, v, hv);
+    }
+
+protected:
+
+    /**
+     * Creates the model from a new library.
+     */
+    inline std::unique_ptr<Generation> load(std::unique_ptr<ModelLibrary<Base> > library) const {
+        CPPADCG_ASSERT_KNOWN(library != nullptr, "A model library must be provided")
+
+        std::unique_ptr<Generation> g(new Generation());
+        g->library = std::move(library);
+        g->model = g->library->model(_name);
+        if (g->model == nullptr) {
+            throw CGException("Model '", _name, "' not found in the model library");
+        }
+        return g;
+    }
+
+    /**
+     * Checks whether or not a new library can replace the current one.
+     *
+     * @throws CGException if the new library is not compatible
+     */
+    virtual void validate(const Generation& g) {
+        GenericModel<Base>& model = *g.model;
+        if (model.Domain() != _domain || model.Range() != _range) {
+            throw CGException("The model '", _name, "' in the new library has different dimensions (",
+                              model.Domain(), "x", model.Range(), " instead of ", _domain, "x", _range, ")");
+        }
+
+        if (model.DynamicParameterSize() != _generation->model->DynamicParameterSize()) {
+            throw CGException("The model '", _name, "' in the new library has a different number of dynamic parameters");
+        }
+
+        if (model.getAtomicFunctionNames() != _atomicNames) {
+            throw CGException("The model '", _name, "' in the new library uses different atomic functions");
+        }
+
+        auto* newLib = dynamic_cast<FunctorModelLibrary<Base>*>(g.library.get());
+        auto* oldLib = dynamic_cast<FunctorModelLibrary<Base>*>(_generation->library.get());
+        if (newLib != nullptr && oldLib != nullptr && newLib->getAPIVersion() != oldLib->getAPIVersion()) {
+            throw CGException("The API version of the new library (", newLib->getAPIVersion(),
+                              ") is different from the current version (", oldLib->getAPIVersion(), ")");
+        }
+    }
+
+    inline void addAtomics(GenericModel<Base>& model) {
+        for (atomic_base<Base>* a : _atomics) {
+            model.addAtomicFunction(*a);
+        }
+        for (ArrayViewAtomicFun<Base>* a : _arrayViewAtomics) {
+            model.addAtomicFunction(*a);
+        }
+        for (GenericModel<Base>* m : _externalModels) {
+            model.addExternalModel(*m);
+        }
+    }
+
+    /**
+     * Waits until all evaluations which could be using a previous
+     * generation have finished.
+     * The epoch is changed before waiting for the counter of each parity
+     * so that new evaluations do not prevent the counter from reaching
+     * zero.
+     */
+    inline void synchronize() {
+        for (size_t k = 0; k < 2; k++) {
+            size_t e = _epoch.fetch_add(1);
+            while (_calls[e & 1].load() != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
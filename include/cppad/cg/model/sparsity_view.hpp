@@ -0,0 +1,83 @@
+#ifndef CPPAD_CG_SPARSITY_VIEW_INCLUDED
+#define CPPAD_CG_SPARSITY_VIEW_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A read-only view of a sparsity pattern in the coordinate format (COO).
+ * The element e is located at (rows[e], cols[e]) and the elements are in
+ * the same order as the values of the sparse Jacobian/Hessian.
+ *
+ * The arrays are not owned by this object (they usually point to static
+ * arrays in a compiled model library).
+ *
+ * @author Joao Leal
+ */
+class CooSparsityView {
+public:
+    ArrayView<const unsigned long> rows;
+    ArrayView<const unsigned long> cols;
+public:
+
+    /**
+     * @return the number of non-zero elements
+     */
+    inline size_t nnz() const {
+        return rows.size();
+    }
+};
+
+/**
+ * A read-only view of a sparsity pattern in the compressed sparse row
+ * format (CSR).
+ * The columns of the elements in row i are
+ * cols[rowPtr[i]], ..., cols[rowPtr[i + 1] - 1] (in ascending order) and
+ * elements[e] is the position of element e in the coordinate format
+ * (which is the order of the values of the sparse Jacobian/Hessian).
+ *
+ * The arrays are not owned by this object (they usually point to static
+ * arrays in a compiled model library).
+ *
+ * @author Joao Leal
+ */
+class CsrSparsityView {
+public:
+    ArrayView<const unsigned long> rowPtr;
+    ArrayView<const unsigned long> cols;
+    ArrayView<const unsigned long> elements;
+public:
+
+    /**
+     * @return the number of rows
+     */
+    inline size_t nRows() const {
+        return rowPtr.empty() ? 0 : rowPtr.size() - 1;
+    }
+
+    /**
+     * @return the number of non-zero elements
+     */
+    inline size_t nnz() const {
+        return cols.size();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,655 @@
+#ifndef CPPAD_CG_TIERED_GENERIC_MODEL_INCLUDED
+#define CPPAD_CG_TIERED_GENERIC_MODEL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A model which is immediately evaluated using a lower tier model (e.g. a
+ * BytecodeGenericModel) while an optimized model library is created in a
+ * background thread.
+ * Once the model from the new library is loaded and its results are
+ * validated against the lower tier, all following evaluations are
+ * performed by the new model.
+ * The validation is performed by the thread using this model (in the
+ * first evaluation after the library is loaded or in waitForUpperTier())
+ * so that the lower tier and the atomic functions are never used
+ * simultaneously by different threads.
+ *
+ * The lower tier model is kept until this object is deleted so that
+ * evaluations which started before the switch can finish safely.
+ * Like other models, this class is not thread-safe and it should not be
+ * used simultaneously in different threads.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class TieredGenericModel : public GenericModel<Base> {
+public:
+    /**
+     * Creates the model library for the upper tier (it is called in a
+     * background thread)
+     */
+    using LibraryFactory = std::function<std::unique_ptr<ModelLibrary<Base> >()>;
+protected:
+    // the model used before the upper tier is ready
+    const std::unique_ptr<GenericModel<Base> > _lowerTier;
+    // the library which provides the upper tier model
+    std::unique_ptr<ModelLibrary<Base> > _upperLibrary;
+    // the upper tier model (must be deleted before its library)
+    std::unique_ptr<GenericModel<Base> > _upperTier;
+    // the model currently used for evaluations
+    std::atomic<GenericModel<Base>*> _active;
+    // creates the library
+    LibraryFactory _libraryFactory;
+    // the independent variable values used for validation
+    const std::vector<Base> _x;
+    // the maximum relative and absolute errors allowed during validation
+    const Base _epsilonR;
+    const Base _epsilonA;
+    const size_t _nRange;
+    // protects the atomic functions and the upper tier state
+    mutable std::mutex _mutex;
+    std::vector<atomic_base<Base>*> _atomics;
+    std::vector<ArrayViewAtomicFun<Base>*> _arrayViewAtomics;
+    std::vector<GenericModel<Base>*> _externalModels;
+    std::vector<Base> _parameters;
+    bool _upperTierFailed;
+    std::string _upperTierError;
+    // the upper tier created by the background thread which was not validated yet
+    std::unique_ptr<ModelLibrary<Base> > _pendingLibrary;
+    std::unique_ptr<GenericModel<Base> > _pendingModel;
+    std::atomic<bool> _upperTierPending;
+    // creates the upper tier
+    std::thread _worker;
+public:
+
+    /**
+     * Creates a new tiered model and starts the creation of the upper tier
+     * model library in a background thread.
+     *
+     * @param lowerTier the model used until the upper tier is ready
+     * @param libraryFactory creates the library containing a model with
+     *                       the same name as the lower tier model
+     *                       (it is called in a different thread and
+     *                       therefore it must not share state with the
+     *                       calling thread)
+     * @param x independent variable values used to validate the upper tier
+     * @param epsilonR the maximum relative error allowed during validation
+     * @param epsilonA the maximum absolute error allowed during validation
+     */
+    TieredGenericModel(std::unique_ptr<GenericModel<Base> > lowerTier,
+                       LibraryFactory libraryFactory,
+                       std::vector<Base> x,
+                       Base epsilonR = Base(1e-10),
+                       Base epsilonA = Base(1e-10)) :
+            _lowerTier(std::move(lowerTier)),
+            _active(_lowerTier.get()),
+            _libraryFactory(std::move(libraryFactory)),
+            _x(std::move(x)),
+            _epsilonR(epsilonR),
+            _epsilonA(epsilonA),
+            _nRange(_lowerTier != nullptr ? _lowerTier->Range() : 0),
+            _upperTierFailed(false),
+            _upperTierPending(false) {
+        CPPADCG_ASSERT_KNOWN(_lowerTier != nullptr, "A lower tier model must be provided")
+        CPPADCG_ASSERT_KNOWN(_x.size() == _lowerTier->Domain(), "Invalid independent array size")
+
+        _worker = std::thread(&TieredGenericModel::createUpperTier, this);
+    }
+
+    TieredGenericModel(const TieredGenericModel&) = delete;
+    TieredGenericModel& operator=(const TieredGenericModel&) = delete;
+
+    virtual ~TieredGenericModel() {
+        // the compilation cannot be interrupted
+        if (_worker.joinable()) {
+            _worker.join();
+        }
+    }
+
+    /**
+     * Waits until the creation of the upper tier model has finished
+     * (successfully or not) and validates it.
+     */
+    inline void waitForUpperTier() {
+        if (_worker.joinable()) {
+            _worker.join();
+        }
+        activateUpperTier();
+    }
+
+    /**
+     * Whether or not evaluations are performed by the upper tier model.
+     */
+    inline bool isUpperTierActive() const {
+        return _active.load(std::memory_order_acquire) != _lowerTier.get();
+    }
+
+    /**
+     * Whether or not it was not possible to create or validate the upper
+     * tier model (evaluations will always use the lower tier).
+     */
+    inline bool isUpperTierFailed() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _upperTierFailed;
+    }
+
+    /**
+     * Provides the reason for the upper tier failure.
+     */
+    inline std::string getUpperTierError() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _upperTierError;
+    }
+
+    inline GenericModel<Base>& getLowerTier() {
+        return *_lowerTier;
+    }
+
+    const std::string& getName() const override {
+        return _lowerTier->getName();
+    }
+
+    const std::vector<std::string>& getAtomicFunctionNames() override {
+        return active().getAtomicFunctionNames();
+    }
+
+    bool addAtomicFunction(atomic_base<Base>& atomic) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _atomics.push_back(&atomic);
+        bool added = _lowerTier->addAtomicFunction(atomic);
+        if (_upperTier != nullptr) {
+            added = _upperTier->addAtomicFunction(atomic) || added;
+        }
+        return added;
+    }
+
+    bool addAtomicFunction(ArrayViewAtomicFun<Base>& atomic) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _arrayViewAtomics.push_back(&atomic);
+        bool added = _lowerTier->addAtomicFunction(atomic);
+        if (_upperTier != nullptr) {
+            added = _upperTier->addAtomicFunction(atomic) || added;
+        }
+        return added;
+    }
+
+    bool addExternalModel(GenericModel<Base>& atomic) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _externalModels.push_back(&atomic);
+        bool added = _lowerTier->addExternalModel(atomic);
+        if (_upperTier != nullptr) {
+            added = _upperTier->addExternalModel(atomic) || added;
+        }
+        return added;
+    }
+
+    size_t Domain() const override {
+        return _lowerTier->Domain();
+    }
+
+    size_t Range() const override {
+        return _lowerTier->Range();
+    }
+
+    size_t DynamicParameterSize() const override {
+        return _lowerTier->DynamicParameterSize();
+    }
+
+    void setDynamicParameters(ArrayView<const Base> p) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _lowerTier->setDynamicParameters(p);
+        if (_upperTier != nullptr) {
+            _upperTier->setDynamicParameters(p);
+        }
+        _parameters.assign(p.begin(), p.end());
+    }
+
+    bool isJacobianSinglePrecision() const override {
+        return _active.load(std::memory_order_acquire)->isJacobianSinglePrecision();
+    }
+
+    bool isHessianSinglePrecision() const override {
+        return _active.load(std::memory_order_acquire)->isHessianSinglePrecision();
+    }
+
+    // Jacobian sparsity
+    bool isJacobianSparsityAvailable() override {
+        return active().isJacobianSparsityAvailable();
+    }
+
+    std::vector<std::set<size_t> > JacobianSparsitySet() override {
+        return active().JacobianSparsitySet();
+    }
+
+    std::vector<bool> JacobianSparsityBool() override {
+        return active().JacobianSparsityBool();
+    }
+
+    void JacobianSparsity(std::vector<size_t>& equations,
+                          std::vector<size_t>& variables) override {
+        active().JacobianSparsity(equations, variables);
+    }
+
+    // Hessian sparsity
+    bool isHessianSparsityAvailable() override {
+        return active().isHessianSparsityAvailable();
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet() override {
+        return active().HessianSparsitySet();
+    }
+
+    std::vector<bool> HessianSparsityBool() override {
+        return active().HessianSparsityBool();
+    }
+
+    void HessianSparsity(std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        active().HessianSparsity(rows, cols);
+    }
+
+    bool isEquationHessianSparsityAvailable() override {
+        return active().isEquationHessianSparsityAvailable();
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet(size_t i) override {
+        return active().HessianSparsitySet(i);
+    }
+
+    std::vector<bool> HessianSparsityBool(size_t i) override {
+        return active().HessianSparsityBool(i);
+    }
+
+    void HessianSparsity(size_t i,
+                         std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        active().HessianSparsity(i, rows, cols);
+    }
+
+    // zero order forward mode
+    bool isForwardZeroAvailable() override {
+        return active().isForwardZeroAvailable();
+    }
+
+    using GenericModel<Base>::ForwardZero;
+
+    void ForwardZero(const CppAD::vector<bool>& vx,
+                     CppAD::vector<bool>& vy,
+                     ArrayView<const Base> tx,
+                     ArrayView<Base> ty) override {
+        active().ForwardZero(vx, vy, tx, ty);
+    }
+
+    void ForwardZero(ArrayView<const Base> x,
+                     ArrayView<Base> dep) override {
+        active().ForwardZero(x, dep);
+    }
+
+    void ForwardZero(const std::vector<const Base*>& x,
+                     ArrayView<Base> dep) override {
+        active().ForwardZero(x, dep);
+    }
+
+    // dense Jacobian and Hessian
+    bool isJacobianAvailable() override {
+        return active().isJacobianAvailable();
+    }
+
+    void Jacobian(ArrayView<const Base> x,
+                  ArrayView<Base> jac) override {
+        active().Jacobian(x, jac);
+    }
+
+    bool isHessianAvailable() override {
+        return active().isHessianAvailable();
+    }
+
+    void Hessian(ArrayView<const Base> x,
+                 ArrayView<const Base> w,
+                 ArrayView<Base> hess) override {
+        active().Hessian(x, w, hess);
+    }
+
+    // directional derivatives
+    bool isForwardOneAvailable() override {
+        return active().isForwardOneAvailable();
+    }
+
+    void ForwardOne(ArrayView<const Base> tx,
+                    ArrayView<Base> ty) override {
+        active().ForwardOne(tx, ty);
+    }
+
+    bool isSparseForwardOneAvailable() override {
+        return active().isSparseForwardOneAvailable();
+    }
+
+    void ForwardOne(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> ty1) override {
+        active().ForwardOne(x, tx1Nnz, idx, tx1, ty1);
+    }
+
+    bool isReverseOneAvailable() override {
+        return active().isReverseOneAvailable();
+    }
+
+    void ReverseOne(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        active().ReverseOne(tx, ty, px, py);
+    }
+
+    bool isSparseReverseOneAvailable() override {
+        return active().isSparseReverseOneAvailable();
+    }
+
+    void ReverseOne(ArrayView<const Base> x,
+                    ArrayView<Base> px,
+                    size_t pyNnz, const size_t idx[], const Base py[]) override {
+        active().ReverseOne(x, px, pyNnz, idx, py);
+    }
+
+    bool isReverseTwoAvailable() override {
+        return active().isReverseTwoAvailable();
+    }
+
+    void ReverseTwo(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        active().ReverseTwo(tx, ty, px, py);
+    }
+
+    bool isSparseReverseTwoAvailable() override {
+        return active().isSparseReverseTwoAvailable();
+    }
+
+    void ReverseTwo(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> px2,
+                    ArrayView<const Base> py2) override {
+        active().ReverseTwo(x, tx1Nnz, idx, tx1, px2, py2);
+    }
+
+    // sparse Jacobian
+    bool isSparseJacobianAvailable() override {
+        return active().isSparseJacobianAvailable();
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac) override {
+        active().SparseJacobian(x, jac);
+    }
+
+    void SparseJacobian(const std::vector<Base>& x,
+                        std::vector<Base>& jac,
+                        std::vector<size_t>& row,
+                        std::vector<size_t>& col) override {
+        active().SparseJacobian(x, jac, row, col);
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        active().SparseJacobian(x, jac, row, col);
+    }
+
+    void SparseJacobian(const std::vector<const Base*>& x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        active().SparseJacobian(x, jac, row, col);
+    }
+
+    // sparse Hessian
+    bool isSparseHessianAvailable() override {
+        return active().isSparseHessianAvailable();
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess) override {
+        active().SparseHessian(x, w, hess);
+    }
+
+    void SparseHessian(const std::vector<Base>& x,
+                       const std::vector<Base>& w,
+                       std::vector<Base>& hess,
+                       std::vector<size_t>& row,
+                       std::vector<size_t>& col) override {
+        active().SparseHessian(x, w, hess, row, col);
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        active().SparseHessian(x, w, hess, row, col);
+    }
+
+    void SparseHessian(const std::vector<const Base*>& x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        active().SparseHessian(x, w, hess, row, col);
+    }
+
+    // sparse lower Hessian
+    bool isSparseHessianLowerAvailable() override {
+        return active().isSparseHessianLowerAvailable();
+    }
+
+    void SparseHessianLower(ArrayView<const Base> x,
+                            ArrayView<const Base> w,
+                            ArrayView<Base> hess) override {
+        active().SparseHessianLower(x, w, hess);
+    }
+
+    // forward Taylor
+    bool isForwardTaylorAvailable() override {
+        return active().isForwardTaylorAvailable();
+    }
+
+    size_t ForwardTaylorOrder() override {
+        return active().ForwardTaylorOrder();
+    }
+
+    void ForwardTaylor(ArrayView<const Base> tx,
+                       ArrayView<Base> ty) override {
+        active().ForwardTaylor(tx, ty);
+    }
+
+    // Hessian-vector product
+    bool isHessianVectorProductAvailable() override {
+        return active().isHessianVectorProductAvailable();
+    }
+
+    size_t HessianVectorDirections() override {
+        return active().HessianVectorDirections();
+    }
+
+    void HessianVectorProduct(ArrayView<const Base> x,
+                              ArrayView<const Base> w,
+                              ArrayView<const Base> v,
+                              ArrayView<Base> hv) override {
+        active().HessianVectorProduct(x, w, v, hv);
+    }
+
+protected:
+
+    inline GenericModel<Base>& active() {
+        if (_upperTierPending.load(std::memory_order_acquire)) {
+            activateUpperTier();
+        }
+        return *_active.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Creates the upper tier model (runs in the background thread).
+     * It must not use the lower tier nor the atomic functions.
+     */
+    virtual void createUpperTier() {
+        try {
+            std::unique_ptr<ModelLibrary<Base> > library = _libraryFactory();
+            if (library == nullptr) {
+                throw CGException("No model library was created");
+            }
+
+            std::unique_ptr<GenericModel<Base> > model = library->model(getName());
+            if (model == nullptr) {
+                throw CGException("Model '", getName(), "' not found in the upper tier model library");
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pendingModel = std::move(model);
+            _pendingLibrary = std::move(library);
+            _upperTierPending.store(true, std::memory_order_release);
+
+        } catch (const std::exception& e) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _upperTierFailed = true;
+            _upperTierError = e.what();
+        }
+    }
+
+    /**
+     * Validates and activates the upper tier model created by the
+     * background thread (runs in the thread using this model).
+     */
+    inline void activateUpperTier() {
+        std::unique_ptr<ModelLibrary<Base> > library;
+        std::unique_ptr<GenericModel<Base> > model; // deleted before its library
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_upperTierPending.load(std::memory_order_acquire))
+                return;
+            _upperTierPending.store(false, std::memory_order_release);
+            library = std::move(_pendingLibrary);
+            model = std::move(_pendingModel);
+
+            addAtomics(*model);
+            if (!_parameters.empty()) {
+                model->setDynamicParameters(_parameters);
+            }
+        }
+
+        try {
+            validate(*model);
+        } catch (const std::exception& e) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _upperTierFailed = true;
+            _upperTierError = e.what();
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _upperTier = std::move(model);
+        _upperLibrary = std::move(library);
+        _active.store(_upperTier.get(), std::memory_order_release);
+    }
+
+    inline void addAtomics(GenericModel<Base>& model) {
+        for (atomic_base<Base>* a : _atomics) {
+            model.addAtomicFunction(*a);
+        }
+        for (ArrayViewAtomicFun<Base>* a : _arrayViewAtomics) {
+            model.addAtomicFunction(*a);
+        }
+        for (GenericModel<Base>* m : _externalModels) {
+            model.addExternalModel(*m);
+        }
+    }
+
+    /**
+     * Compares the results of the upper tier model with the lower tier.
+     *
+     * @throws CGException if the results differ
+     */
+    virtual void validate(GenericModel<Base>& upper) {
+        GenericModel<Base>& lower = *_lowerTier;
+
+        if (upper.Domain() != _x.size() || upper.Range() != _nRange) {
+            throw CGException("The upper tier model has different dimensions");
+        }
+        if (upper.DynamicParameterSize() != _lowerTier->DynamicParameterSize()) {
+            throw CGException("The upper tier model has a different number of dynamic parameters");
+        }
+
+        if (lower.isForwardZeroAvailable()) {
+            if (!upper.isForwardZeroAvailable()) {
+                throw CGException("Zero order forward mode not available in the upper tier model");
+            }
+            std::vector<Base> refDep(_nRange), dep(_nRange);
+            lower.ForwardZero(_x, refDep);
+            upper.ForwardZero(_x, dep);
+            compare(refDep, dep, "zero order forward mode");
+        }
+
+        if (lower.isSparseJacobianAvailable()) {
+            if (!upper.isSparseJacobianAvailable()) {
+                throw CGException("Sparse Jacobian not available in the upper tier model");
+            }
+            std::vector<Base> refJac, jac;
+            std::vector<size_t> refRow, refCol, row, col;
+            lower.SparseJacobian(_x, refJac, refRow, refCol);
+            upper.SparseJacobian(_x, jac, row, col);
+            if (row != refRow || col != refCol) {
+                throw CGException("The upper tier model has a different Jacobian sparsity");
+            }
+            compare(refJac, jac, "sparse Jacobian");
+        }
+
+        if (lower.isSparseHessianAvailable()) {
+            if (!upper.isSparseHessianAvailable()) {
+                throw CGException("Sparse Hessian not available in the upper tier model");
+            }
+            std::vector<Base> w(_nRange, Base(1.0));
+            std::vector<Base> refHess, hess;
+            std::vector<size_t> refRow, refCol, row, col;
+            lower.SparseHessian(_x, w, refHess, refRow, refCol);
+            upper.SparseHessian(_x, w, hess, row, col);
+            if (row != refRow || col != refCol) {
+                throw CGException("The upper tier model has a different Hessian sparsity");
+            }
+            compare(refHess, hess, "sparse Hessian");
+        }
+    }
+
+    inline void compare(const std::vector<Base>& expected,
+                        const std::vector<Base>& value,
+                        const char* name) const {
+        for (size_t i = 0; i < expected.size(); i++) {
+            if (!CppAD::NearEqual(value[i], expected[i], _epsilonR, _epsilonA)) {
+                throw CGException("Upper tier model validation failed for the ", name,
+                                  " (element ", i, ": ", value[i], " != ", expected[i], ")");
+            }
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
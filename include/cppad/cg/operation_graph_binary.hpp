@@ -0,0 +1,737 @@
+#ifndef CPPAD_CG_OPERATION_GRAPH_BINARY_INCLUDED
+#define CPPAD_CG_OPERATION_GRAPH_BINARY_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A binary representation of an operation graph (independent variables,
+ * operation nodes, dependent variables and references to atomic functions)
+ * created by a CodeHandler.
+ *
+ * The binary data is composed by a header followed by fixed size tables
+ * (all aligned to 8 bytes) which are accessed directly without any
+ * parsing. Therefore, it can be saved to a file and later used through a
+ * memory mapped file:
+ *  - header
+ *  - nodes (topologically sorted, independent variables first)
+ *  - arguments (node index or parameter index)
+ *  - operation information
+ *  - parameter values
+ *  - dependents (node index or parameter index)
+ *  - atomic functions (ID and name)
+ *  - names (node names and atomic function names)
+ *
+ * The data is saved using the native byte order and Base representation
+ * which are validated when the data is used.
+ *
+ * The graph must be saved before source code generation since it modifies
+ * the operation graph (e.g., loops and temporary variables).
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class OperationGraphBinary {
+    static_assert(std::is_trivially_copyable<Base>::value,
+                  "OperationGraphBinary requires a trivially copyable Base type");
+public:
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+    using CGB = CG<Base>;
+
+    static const uint32_t VERSION = 1;
+    static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t baseSize;
+        uint32_t reserved;
+        uint64_t nIndependents;
+        uint64_t nDependents;
+        uint64_t nNodes; // includes the independent variables
+        uint64_t nArguments;
+        uint64_t nInfo;
+        uint64_t nParameters;
+        uint64_t nAtomics;
+        uint64_t nameSize;
+        uint64_t nodesOffset;
+        uint64_t argumentsOffset;
+        uint64_t infoOffset;
+        uint64_t parametersOffset;
+        uint64_t dependentsOffset;
+        uint64_t atomicsOffset;
+        uint64_t namesOffset;
+        uint64_t totalSize;
+    };
+
+    struct NodeEntry {
+        uint32_t op;
+        uint32_t nArguments;
+        uint32_t nInfo;
+        uint32_t hasName;
+        uint64_t argumentsStart;
+        uint64_t infoStart;
+        uint64_t nameStart;
+        uint64_t nameSize;
+    };
+
+    struct AtomicEntry {
+        uint64_t id;
+        uint64_t nameStart;
+        uint64_t nameSize;
+    };
+
+protected:
+    static const uint64_t PARAMETER_FLAG = 1;
+protected:
+    /**
+     * owned data (empty when the data is provided by the user)
+     * (uint64_t is used to guarantee the alignment)
+     */
+    std::vector<uint64_t> buffer_;
+    const char* data_;
+    size_t size_;
+public:
+
+    /**
+     * Creates the binary representation of an operation graph.
+     *
+     * @param handler the source code handler with the independent variables
+     * @param dependents the dependent variables
+     * @throws CGException if the graph contains operations which are not
+     *                     supported (such as loops)
+     */
+    inline OperationGraphBinary(CodeHandler<Base>& handler,
+                                ArrayView<const CGB> dependents) :
+            data_(nullptr),
+            size_(0) {
+        serialize(handler, dependents);
+    }
+
+    /**
+     * Uses existing binary data (e.g. a memory mapped file) which is not
+     * copied and must remain valid while this object is used.
+     *
+     * @param data the binary data (aligned to 8 bytes)
+     * @param size the data size in bytes
+     * @throws CGException if the data is not valid
+     */
+    inline OperationGraphBinary(const void* data,
+                                size_t size) :
+            data_(static_cast<const char*>(data)),
+            size_(size) {
+        validate();
+    }
+
+    OperationGraphBinary(const OperationGraphBinary&) = delete;
+    OperationGraphBinary& operator=(const OperationGraphBinary&) = delete;
+
+    inline OperationGraphBinary(OperationGraphBinary&& orig) noexcept = default; // the vector storage is kept
+
+    /**
+     * Reads binary data from a stream (the data is copied).
+     *
+     * @throws CGException if the data is not valid
+     */
+    static inline std::unique_ptr<OperationGraphBinary> read(std::istream& in) {
+        std::unique_ptr<OperationGraphBinary> g(new OperationGraphBinary());
+
+        Header header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(Header));
+        if (!in || header.totalSize < sizeof(Header) || header.totalSize % 8 != 0) {
+            throw CGException("Failed to read operation graph header");
+        }
+
+        /**
+         * the size in the header is only used to allocate memory once it is
+         * known that the stream provides that much data
+         */
+        const uint64_t dataSize = header.totalSize - sizeof(Header);
+        const std::istream::pos_type start = in.tellg();
+        if (start != std::istream::pos_type(-1)) {
+            in.seekg(0, std::ios::end);
+            const std::istream::pos_type end = in.tellg();
+            in.seekg(start);
+            if (!in || end == std::istream::pos_type(-1) || uint64_t(end - start) < dataSize) {
+                throw CGException("Failed to read operation graph data: the header size (", header.totalSize,
+                                  " bytes) is larger than the available data");
+            }
+
+            g->buffer_.resize(header.totalSize / 8);
+            char* data = reinterpret_cast<char*>(g->buffer_.data());
+            in.read(data + sizeof(Header), dataSize);
+        } else {
+            // the stream length is unknown: the buffer only grows with the data which is read
+            const uint64_t chunk = uint64_t(1) << 20; // 8 MB
+            g->buffer_.resize(sizeof(Header) / 8);
+            while (in && g->buffer_.size() < header.totalSize / 8) {
+                size_t offset = g->buffer_.size();
+                g->buffer_.resize(offset + size_t(std::min(chunk, header.totalSize / 8 - offset)));
+                in.read(reinterpret_cast<char*>(g->buffer_.data() + offset), (g->buffer_.size() - offset) * 8);
+            }
+        }
+        if (!in) {
+            throw CGException("Failed to read operation graph data");
+        }
+        char* data = reinterpret_cast<char*>(g->buffer_.data());
+        std::memcpy(data, &header, sizeof(Header));
+
+        g->data_ = data;
+        g->size_ = header.totalSize;
+        g->validate();
+        return g;
+    }
+
+    /**
+     * Reads binary data from a file (the data is copied).
+     */
+    static inline std::unique_ptr<OperationGraphBinary> read(const std::string& fileName) {
+        std::ifstream in(fileName, std::ios::binary);
+        if (!in.is_open()) {
+            throw CGException("Failed to open file '", fileName, "'");
+        }
+        return read(in);
+    }
+
+    inline void write(std::ostream& out) const {
+        out.write(data_, size_);
+    }
+
+    inline void write(const std::string& fileName) const {
+        std::ofstream out(fileName, std::ios::binary);
+        write(out);
+        if (!out) {
+            throw CGException("Failed to write file '", fileName, "'");
+        }
+    }
+
+    inline const void* data() const {
+        return data_;
+    }
+
+    inline size_t size() const {
+        return size_;
+    }
+
+    inline const Header& getHeader() const {
+        return *reinterpret_cast<const Header*>(data_);
+    }
+
+    inline size_t getIndependentCount() const {
+        return getHeader().nIndependents;
+    }
+
+    inline size_t getDependentCount() const {
+        return getHeader().nDependents;
+    }
+
+    inline size_t getNodeCount() const {
+        return getHeader().nNodes;
+    }
+
+    inline ArrayView<const NodeEntry> getNodes() const {
+        return section<NodeEntry>(getHeader().nodesOffset, getHeader().nNodes);
+    }
+
+    inline ArrayView<const uint64_t> getArguments() const {
+        return section<uint64_t>(getHeader().argumentsOffset, getHeader().nArguments);
+    }
+
+    inline ArrayView<const uint64_t> getInfo() const {
+        return section<uint64_t>(getHeader().infoOffset, getHeader().nInfo);
+    }
+
+    inline ArrayView<const Base> getParameters() const {
+        return section<Base>(getHeader().parametersOffset, getHeader().nParameters);
+    }
+
+    inline ArrayView<const uint64_t> getDependents() const {
+        return section<uint64_t>(getHeader().dependentsOffset, getHeader().nDependents);
+    }
+
+    inline ArrayView<const AtomicEntry> getAtomics() const {
+        return section<AtomicEntry>(getHeader().atomicsOffset, getHeader().nAtomics);
+    }
+
+    inline std::string getAtomicName(const AtomicEntry& a) const {
+        return std::string(data_ + getHeader().namesOffset + a.nameStart, a.nameSize);
+    }
+
+    /**
+     * Recreates the operation graph in a source code handler.
+     *
+     * @param handler the source code handler where the operation nodes are
+     *                created (it must not have independent variables)
+     * @param independents the new independent variables
+     * @param atomics atomic functions used by the operation graph which are
+     *                matched by name (they are required for source code
+     *                generation)
+     * @return the new dependent variables
+     */
+    inline std::vector<CGB> load(CodeHandler<Base>& handler,
+                                 std::vector<CGB>& independents,
+                                 const std::vector<CGAbstractAtomicFun<Base>*>& atomics = {}) const {
+        CPPADCG_ASSERT_KNOWN(handler.getIndependentVariableSize() == 0,
+                             "The code handler must not have independent variables")
+
+        std::map<size_t, size_t> atomicIds;
+        for (const AtomicEntry& a : getAtomics()) {
+            std::string name = getAtomicName(a);
+            for (CGAbstractAtomicFun<Base>* atomic : atomics) {
+                if (atomic->atomic_name() == name) {
+                    atomicIds[a.id] = atomic->getId();
+                    handler.registerAtomicFunction(*atomic);
+                    break;
+                }
+            }
+        }
+
+        return loadNodes(handler, independents, atomicIds, true);
+    }
+
+    /**
+     * Records a new tape from the operation graph without the need for the
+     * original model code.
+     * The returned function can be used, for instance, with a
+     * ModelCSourceGen.
+     *
+     * @param atomics atomic functions used by the operation graph which are
+     *                matched by name
+     */
+    inline std::unique_ptr<ADFun<CGB> > createADFun(const std::vector<CGAbstractAtomicFun<Base>*>& atomics = {}) const {
+        CodeHandler<Base> handler;
+        std::vector<CGB> indep;
+        std::vector<CGB> dep = loadNodes(handler, indep, std::map<size_t, size_t>(), false); // the evaluator maps the atomic IDs
+
+        Evaluator<Base, CGB, AD<CGB> > evaluator(handler);
+        for (const AtomicEntry& a : getAtomics()) {
+            std::string name = getAtomicName(a);
+            for (CGAbstractAtomicFun<Base>* atomic : atomics) {
+                if (atomic->atomic_name() == name) {
+                    evaluator.addAtomicFunction(a.id, *atomic);
+                    break;
+                }
+            }
+        }
+
+        std::vector<AD<CGB> > x(indep.size());
+        CppAD::Independent(x);
+
+        std::vector<AD<CGB> > y = evaluator.evaluate(x, dep);
+
+        std::unique_ptr<ADFun<CGB> > fun(new ADFun<CGB>());
+        fun->Dependent(x, y);
+        return fun;
+    }
+
+protected:
+
+    inline OperationGraphBinary() :
+            data_(nullptr),
+            size_(0) {
+    }
+
+    /**
+     * Whether or not an operation type can be saved and loaded
+     * (operations created during source code generation, such as loops
+     * and temporary variables, are not supported).
+     */
+    static inline bool isSupported(CGOpCode op) {
+        switch (op) {
+            case CGOpCode::Pri:
+            case CGOpCode::IndexDeclaration:
+            case CGOpCode::Index:
+            case CGOpCode::IndexAssign:
+            case CGOpCode::LoopStart:
+            case CGOpCode::LoopIndexedIndep:
+            case CGOpCode::LoopIndexedDep:
+            case CGOpCode::LoopIndexedTmp:
+            case CGOpCode::LoopEnd:
+            case CGOpCode::TmpDcl:
+            case CGOpCode::Tmp:
+            case CGOpCode::IndexCondExpr:
+                return false;
+            default:
+                return true;
+        }
+    }
+
+    static inline size_t align(size_t bytes) {
+        return (bytes + 7) & ~size_t(7);
+    }
+
+    template<class T>
+    inline ArrayView<const T> section(uint64_t offset,
+                                      uint64_t size) const {
+        return ArrayView<const T>(reinterpret_cast<const T*>(data_ + offset), size);
+    }
+
+    inline void validate() const {
+        if (size_ < sizeof(Header)) {
+            throw CGException("Invalid operation graph: too small");
+        }
+        if (reinterpret_cast<std::uintptr_t>(data_) % 8 != 0) {
+            throw CGException("Invalid operation graph: data is not aligned to 8 bytes");
+        }
+
+        const Header& h = getHeader();
+        if (std::memcmp(h.magic, "CPPADCG", 8) != 0) {
+            throw CGException("Invalid operation graph: not a CppADCodeGen operation graph");
+        }
+        if (h.version != VERSION) {
+            throw CGException("Unsupported operation graph version (", h.version, ")");
+        }
+        if (h.byteOrder != BYTE_ORDER_MARK) {
+            throw CGException("Invalid operation graph: different byte order");
+        }
+        if (h.baseSize != sizeof(Base)) {
+            throw CGException("Invalid operation graph: different base type size (", h.baseSize, ")");
+        }
+        if (h.totalSize != size_ || h.nIndependents > h.nNodes) {
+            throw CGException("Invalid operation graph: inconsistent sizes");
+        }
+
+        validateSection(h.nodesOffset, h.nNodes, sizeof(NodeEntry));
+        validateSection(h.argumentsOffset, h.nArguments, sizeof(uint64_t));
+        validateSection(h.infoOffset, h.nInfo, sizeof(uint64_t));
+        validateSection(h.parametersOffset, h.nParameters, sizeof(Base));
+        validateSection(h.dependentsOffset, h.nDependents, sizeof(uint64_t));
+        validateSection(h.atomicsOffset, h.nAtomics, sizeof(AtomicEntry));
+        validateSection(h.namesOffset, h.nameSize, 1);
+
+        for (const AtomicEntry& a : getAtomics()) {
+            if (a.nameSize > h.nameSize || a.nameStart > h.nameSize - a.nameSize)
+                throw CGException("Invalid operation graph: invalid atomic function name");
+        }
+    }
+
+    inline void validateSection(uint64_t offset,
+                                uint64_t n,
+                                size_t elementSize) const {
+        if (offset % 8 != 0 || offset > size_ || n > (size_ - offset) / elementSize) {
+            throw CGException("Invalid operation graph: invalid section");
+        }
+    }
+
+    inline Arg decodeArgument(uint64_t a,
+                              const std::vector<Node*>& nodes,
+                              size_t limit) const {
+        size_t index = a >> 1;
+        if (a & PARAMETER_FLAG) {
+            if (index >= getHeader().nParameters)
+                throw CGException("Invalid operation graph: invalid parameter index");
+            return Arg(getParameters()[index]);
+        } else {
+            if (index >= limit)
+                throw CGException("Invalid operation graph: invalid node index");
+            return Arg(*nodes[index]);
+        }
+    }
+
+    /**
+     * Creates the operation nodes in a code handler.
+     *
+     * @param atomicIds maps the atomic function IDs in the graph to the IDs
+     *                  of the atomic functions registered in the handler
+     * @param mapAtomics whether or not all the atomic function IDs must be
+     *                   replaced using atomicIds (otherwise the original IDs
+     *                   are kept)
+     */
+    inline std::vector<CGB> loadNodes(CodeHandler<Base>& handler,
+                                      std::vector<CGB>& independents,
+                                      const std::map<size_t, size_t>& atomicIds,
+                                      bool mapAtomics) const {
+        const Header& h = getHeader();
+        ArrayView<const NodeEntry> entries = getNodes();
+        ArrayView<const uint64_t> arguments = getArguments();
+        ArrayView<const uint64_t> info = getInfo();
+        const char* names = data_ + h.namesOffset;
+
+        independents.resize(h.nIndependents);
+        handler.makeVariables(independents);
+
+        std::vector<Node*> nodes(h.nNodes);
+        for (size_t j = 0; j < h.nIndependents; j++) {
+            if (entries[j].op != uint32_t(CGOpCode::Inv))
+                throw CGException("Invalid operation graph: invalid independent variable");
+            nodes[j] = independents[j].getOperationNode();
+        }
+
+        std::set<size_t> atomicTable;
+        for (const AtomicEntry& a : getAtomics()) {
+            atomicTable.insert(a.id);
+        }
+
+        for (size_t i = h.nIndependents; i < h.nNodes; i++) {
+            const NodeEntry& e = entries[i];
+            if (e.op >= uint32_t(CGOpCode::NumberOp) ||
+                !isSupported(CGOpCode(e.op)) ||
+                e.op == uint32_t(CGOpCode::Inv) || // independents are only allowed at the beginning
+                e.nArguments > h.nArguments || e.argumentsStart > h.nArguments - e.nArguments ||
+                e.nInfo > h.nInfo || e.infoStart > h.nInfo - e.nInfo) {
+                throw CGException("Invalid operation graph: invalid node ", i);
+            }
+
+            auto op = CGOpCode(e.op);
+
+            std::vector<Arg> args;
+            args.reserve(e.nArguments);
+            for (size_t a = 0; a < e.nArguments; a++) {
+                args.push_back(decodeArgument(arguments[e.argumentsStart + a], nodes, i)); // only previous nodes
+            }
+
+            std::vector<size_t> nodeInfo(info.data() + e.infoStart, info.data() + e.infoStart + e.nInfo);
+            if (op == CGOpCode::AtomicForward || op == CGOpCode::AtomicReverse) {
+                if (nodeInfo.empty() || atomicTable.find(nodeInfo[0]) == atomicTable.end())
+                    throw CGException("Invalid operation graph: invalid atomic function in node ", i);
+                if (mapAtomics) {
+                    auto it = atomicIds.find(nodeInfo[0]);
+                    if (it == atomicIds.end())
+                        throw CGException("The atomic function used by node ", i, " of the operation graph was not provided");
+                    nodeInfo[0] = it->second;
+                }
+            }
+
+            nodes[i] = handler.makeNode(op, std::move(nodeInfo), std::move(args));
+        }
+
+        for (size_t i = 0; i < h.nNodes; i++) {
+            const NodeEntry& e = entries[i];
+            if (e.hasName) {
+                if (e.nameSize > h.nameSize || e.nameStart > h.nameSize - e.nameSize)
+                    throw CGException("Invalid operation graph: invalid node name");
+                nodes[i]->setName(std::string(names + e.nameStart, e.nameSize));
+            }
+        }
+
+        ArrayView<const uint64_t> depEntries = getDependents();
+        std::vector<CGB> dependents;
+        dependents.reserve(h.nDependents);
+        for (uint64_t d : depEntries) {
+            Arg arg = decodeArgument(d, nodes, h.nNodes);
+            if (arg.getOperation() != nullptr)
+                dependents.emplace_back(*arg.getOperation());
+            else
+                dependents.emplace_back(*arg.getParameter());
+        }
+
+        return dependents;
+    }
+
+    inline void serialize(CodeHandler<Base>& handler,
+                          ArrayView<const CGB> dependents) {
+        const size_t unset = (std::numeric_limits<size_t>::max)();
+
+        /**
+         * determine the node order (depth-first without recursion)
+         */
+        std::vector<size_t> index(handler.getManagedNodesCount(), unset);
+        std::vector<const Node*> order;
+
+        for (const Node* indep : handler._independentVariables) {
+            index[indep->getHandlerPosition()] = order.size();
+            order.push_back(indep);
+        }
+
+        auto checkNode = [&](const Node& node) {
+            if (node.getCodeHandler() != &handler) {
+                throw CGException("Operation node managed by a different code handler");
+            }
+            if (!isSupported(node.getOperationType())) {
+                throw CGException("Unable to save operation graphs with operation type ", node.getOperationType());
+            }
+        };
+
+        std::vector<std::pair<const Node*, size_t> > stack;
+        for (const CGB& dep : dependents) {
+            const Node* root = dep.getOperationNode();
+            if (root == nullptr || index[root->getHandlerPosition()] != unset)
+                continue;
+
+            checkNode(*root);
+            stack.emplace_back(root, 0);
+            while (!stack.empty()) {
+                const Node& node = *stack.back().first;
+                size_t& pos = stack.back().second;
+                const std::vector<Arg>& args = node.getArguments();
+
+                if (pos < args.size()) {
+                    const Node* a = args[pos++].getOperation();
+                    if (a != nullptr && index[a->getHandlerPosition()] == unset) {
+                        checkNode(*a);
+                        stack.emplace_back(a, 0);
+                    }
+                } else {
+                    index[node.getHandlerPosition()] = order.size();
+                    order.push_back(&node);
+                    stack.pop_back();
+                }
+            }
+        }
+
+        /**
+         * table sizes
+         */
+        size_t nArgs = 0;
+        size_t nInfo = 0;
+        size_t nParams = 0;
+        size_t nameSize = 0;
+        std::set<size_t> atomicIds;
+        for (const Node* node : order) {
+            nArgs += node->getArguments().size();
+            nInfo += node->getInfo().size();
+            for (const Arg& a : node->getArguments()) {
+                if (a.getOperation() == nullptr)
+                    nParams++;
+            }
+            if (node->getName() != nullptr)
+                nameSize += node->getName()->size();
+
+            CGOpCode op = node->getOperationType();
+            if ((op == CGOpCode::AtomicForward || op == CGOpCode::AtomicReverse) && !node->getInfo().empty())
+                atomicIds.insert(node->getInfo()[0]);
+        }
+        for (const CGB& dep : dependents) {
+            if (dep.getOperationNode() == nullptr)
+                nParams++;
+        }
+
+        std::vector<std::string> atomicNames;
+        for (size_t id : atomicIds) {
+            atomicNames.push_back(handler.getAtomicFunctionName(id));
+            nameSize += atomicNames.back().size();
+        }
+
+        /**
+         * layout
+         */
+        Header h;
+        std::memset(&h, 0, sizeof(Header));
+        std::memcpy(h.magic, "CPPADCG", 8);
+        h.version = VERSION;
+        h.byteOrder = BYTE_ORDER_MARK;
+        h.baseSize = sizeof(Base);
+        h.nIndependents = handler._independentVariables.size();
+        h.nDependents = dependents.size();
+        h.nNodes = order.size();
+        h.nArguments = nArgs;
+        h.nInfo = nInfo;
+        h.nParameters = nParams;
+        h.nAtomics = atomicIds.size();
+        h.nameSize = nameSize;
+
+        size_t offset = align(sizeof(Header));
+        h.nodesOffset = offset;
+        offset = align(offset + h.nNodes * sizeof(NodeEntry));
+        h.argumentsOffset = offset;
+        offset = align(offset + h.nArguments * sizeof(uint64_t));
+        h.infoOffset = offset;
+        offset = align(offset + h.nInfo * sizeof(uint64_t));
+        h.parametersOffset = offset;
+        offset = align(offset + h.nParameters * sizeof(Base));
+        h.dependentsOffset = offset;
+        offset = align(offset + h.nDependents * sizeof(uint64_t));
+        h.atomicsOffset = offset;
+        offset = align(offset + h.nAtomics * sizeof(AtomicEntry));
+        h.namesOffset = offset;
+        offset = align(offset + h.nameSize);
+        h.totalSize = offset;
+
+        buffer_.assign(h.totalSize / 8, 0);
+        char* data = reinterpret_cast<char*>(buffer_.data());
+        data_ = data;
+        size_ = h.totalSize;
+        std::memcpy(data, &h, sizeof(Header));
+
+        auto* nodes = reinterpret_cast<NodeEntry*>(data + h.nodesOffset);
+        auto* args = reinterpret_cast<uint64_t*>(data + h.argumentsOffset);
+        auto* info = reinterpret_cast<uint64_t*>(data + h.infoOffset);
+        auto* params = reinterpret_cast<Base*>(data + h.parametersOffset);
+        auto* deps = reinterpret_cast<uint64_t*>(data + h.dependentsOffset);
+        auto* atomics = reinterpret_cast<AtomicEntry*>(data + h.atomicsOffset);
+        char* names = data + h.namesOffset;
+
+        size_t iArg = 0;
+        size_t iInfo = 0;
+        size_t iParam = 0;
+        size_t iName = 0;
+
+        auto encode = [&](const Node* node, const Base* param) -> uint64_t {
+            if (node != nullptr) {
+                return uint64_t(index[node->getHandlerPosition()]) << 1;
+            } else {
+                std::memcpy(&params[iParam], param, sizeof(Base));
+                return (uint64_t(iParam++) << 1) | PARAMETER_FLAG;
+            }
+        };
+
+        for (size_t i = 0; i < order.size(); i++) {
+            const Node& node = *order[i];
+            NodeEntry& e = nodes[i];
+            e.op = uint32_t(node.getOperationType());
+            e.nArguments = uint32_t(node.getArguments().size());
+            e.nInfo = uint32_t(node.getInfo().size());
+            e.argumentsStart = iArg;
+            e.infoStart = iInfo;
+
+            for (const Arg& a : node.getArguments()) {
+                args[iArg++] = encode(a.getOperation(), a.getParameter());
+            }
+            for (size_t v : node.getInfo()) {
+                info[iInfo++] = v;
+            }
+
+            const std::string* name = node.getName();
+            if (name != nullptr) {
+                e.hasName = 1;
+                e.nameStart = iName;
+                e.nameSize = name->size();
+                std::memcpy(names + iName, name->data(), name->size());
+                iName += name->size();
+            }
+        }
+
+        for (size_t i = 0; i < dependents.size(); i++) {
+            const CGB& dep = dependents[i];
+            if (dep.getOperationNode() != nullptr) {
+                deps[i] = encode(dep.getOperationNode(), nullptr);
+            } else {
+                Base value = dep.getValue();
+                deps[i] = encode(nullptr, &value);
+            }
+        }
+
+        size_t a = 0;
+        for (size_t id : atomicIds) {
+            const std::string& name = atomicNames[a];
+            atomics[a].id = id;
+            atomics[a].nameStart = iName;
+            atomics[a].nameSize = name.size();
+            std::memcpy(names + iName, name.data(), name.size());
+            iName += name.size();
+            a++;
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
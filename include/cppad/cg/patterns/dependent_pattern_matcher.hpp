@@ -75,6 +75,11 @@ private:
     std::vector<EquationPattern<Base>*> equations_;
     EquationPattern<Base>* eqCurr_;
     std::map<size_t, EquationPattern<Base>*> dep2Equation_;
+    /**
+     * the equation pattern of each dependent (same as dep2Equation_ but
+     * with a constant time access)
+     */
+    std::vector<EquationPattern<Base>*> depEquation_;
     std::map<EquationPattern<Base>*, Loop<Base>*> equation2Loop_;
     std::vector<Loop<Base>*> loops_;
     /**
@@ -99,6 +104,10 @@ private:
     CodeHandlerVector<Base, size_t> origShareNodeId_;
     /// used to mark visited nodes and indexed nodes
     size_t color_;
+    /// structural fingerprint of each node (indexed by handler position)
+    std::vector<size_t> fingerprint_;
+    std::vector<bool> fingerprintDefined_;
+    std::vector<std::pair<const OperationNode<Base>*, size_t> > fingerprintStack_;
 public:
 
     /**
@@ -214,9 +223,11 @@ private:
          */
         findRelatedVariables();
 
+        depEquation_.assign(dependents_.size(), nullptr);
         for (EquationPattern<Base>* eq : equations_) {
             for (size_t depIt : eq->dependents) {
                 dep2Equation_[depIt] = eq;
+                depEquation_[depIt] = eq;
             }
         }
 
@@ -283,79 +294,72 @@ private:
          * First organize pairs of equation patterns with shared variables
          * by the maximum number of shared operations among two dependent
          * variables.
+         * (each loop currently has a single equation pattern, thus only the
+         *  equation pairs with shared variables need to be visited)
          */
-        for (size_t l1 = 0; l1 < loops_.size(); l1++) {
-            Loop<Base>* loop1 = loops_[l1];
-            CPPADCG_ASSERT_UNKNOWN(loop1->equations.size() == 1)
-            EquationPattern<Base>* eq1 = *loop1->equations.begin();
-
-            for (size_t l2 = l1 + 1; l2 < loops_.size(); l2++) {
-                Loop<Base>* loop2 = loops_[l2];
-                CPPADCG_ASSERT_UNKNOWN(loop2->equations.size() == 1)
-                EquationPattern<Base>* eq2 = *loop2->equations.begin();
+        for (const auto& eqSharedIt : equationShared_) {
+            const UniqueEquationPair<Base>& eqRel = eqSharedIt.first;
+            EquationPattern<Base>* eq1 = eqRel.eq1;
+            EquationPattern<Base>* eq2 = eqRel.eq2;
+            CPPADCG_ASSERT_UNKNOWN(equation2Loop_.at(eq1)->equations.size() == 1)
+            CPPADCG_ASSERT_UNKNOWN(equation2Loop_.at(eq2)->equations.size() == 1)
 
-                UniqueEquationPair<Base> eqRel(eq1, eq2);
-                const auto eqSharedit = equationShared_.find(eqRel);
-                if (eqSharedit == equationShared_.end())
-                    continue; // nothing is shared between eq1 and eq2
-
-                const Dep1Dep2SharedType& dep1Dep2Shared = eqSharedit->second;
-
-                /**
-                 * There are shared variables among the two equation patterns
-                 */
-                auto* totalOps2validDeps = new TotalOps2validDepsType();
-                totalOps2validDepsMem.push_back(totalOps2validDeps);
-                size_t maxOps = 0; // the maximum number of shared operations between two dependents
+            const Dep1Dep2SharedType& dep1Dep2Shared = eqSharedIt.second;
 
-                bool canCombine = true;
-
-                /***************************************************
-                 * organize relations between dependents
-                 **************************************************/
-                for (const auto& itDep1Dep2 : dep1Dep2Shared) {
-                    size_t dep1 = itDep1Dep2.first;
-                    const map<size_t, map<OperationNode<Base>*, Indexed2OpCountType> >& dep2Shared = itDep1Dep2.second;
-
-                    // multiple deps2 means multiple choices for a relation (only one dep1<->dep2 can be chosen)
-                    for (const auto& itDep2 : dep2Shared) {
-                        size_t dep2 = itDep2.first;
-                        const map<OperationNode<Base>*, Indexed2OpCountType>& sharedTmps = itDep2.second;
-
-                        size_t totalOps = 0; // the total number of operations performed by shared variables with dep2
-                        for (const auto& itShared : sharedTmps) {
-                            if (itShared.second.first == INDEXED_OPERATION_TYPE::BOTH) {
-                                /**
-                                 * one equation uses this temporary shared
-                                 * variable as an indexed variable while the
-                                 * other equation does not
-                                 */
-                                canCombine = false;
-                                break;
-                            } else {
-                                totalOps += itShared.second.second;
-                            }
+            /**
+             * There are shared variables among the two equation patterns
+             */
+            auto* totalOps2validDeps = new TotalOps2validDepsType();
+            totalOps2validDepsMem.push_back(totalOps2validDeps);
+            size_t maxOps = 0; // the maximum number of shared operations between two dependents
+
+            bool canCombine = true;
+
+            /***************************************************
+             * organize relations between dependents
+             **************************************************/
+            for (const auto& itDep1Dep2 : dep1Dep2Shared) {
+                size_t dep1 = itDep1Dep2.first;
+                const map<size_t, map<OperationNode<Base>*, Indexed2OpCountType> >& dep2Shared = itDep1Dep2.second;
+
+                // multiple deps2 means multiple choices for a relation (only one dep1<->dep2 can be chosen)
+                for (const auto& itDep2 : dep2Shared) {
+                    size_t dep2 = itDep2.first;
+                    const map<OperationNode<Base>*, Indexed2OpCountType>& sharedTmps = itDep2.second;
+
+                    size_t totalOps = 0; // the total number of operations performed by shared variables with dep2
+                    for (const auto& itShared : sharedTmps) {
+                        if (itShared.second.first == INDEXED_OPERATION_TYPE::BOTH) {
+                            /**
+                             * one equation uses this temporary shared
+                             * variable as an indexed variable while the
+                             * other equation does not
+                             */
+                            canCombine = false;
+                            break;
+                        } else {
+                            totalOps += itShared.second.second;
                         }
-
-                        if (!canCombine) break;
-
-                        DepPairType depRel(dep1, dep2);
-                        (*totalOps2validDeps)[totalOps][depRel] = &sharedTmps;
-                        maxOps = std::max<size_t>(maxOps, totalOps);
                     }
 
                     if (!canCombine) break;
-                }
 
-                if (canCombine) {
-                    maxOps2Eq2totalOps2validDeps[maxOps][eqRel] = totalOps2validDeps;
-                    eq2totalOps2validDeps[eqRel] = totalOps2validDeps;
-                } else {
-                    incompatible_[eq1].insert(eq2);
-                    incompatible_[eq2].insert(eq1);
-                    totalOps2validDepsMem.pop_back();
-                    delete totalOps2validDeps;
+                    DepPairType depRel(dep1, dep2);
+                    (*totalOps2validDeps)[totalOps][depRel] = &sharedTmps;
+                    maxOps = std::max<size_t>(maxOps, totalOps);
                 }
+
+                if (!canCombine) break;
+            }
+
+            if (canCombine) {
+                maxOps2Eq2totalOps2validDeps[maxOps][eqRel] = totalOps2validDeps;
+                eq2totalOps2validDeps[eqRel] = totalOps2validDeps;
+            } else {
+                incompatible_[eq1].insert(eq2);
+                incompatible_[eq2].insert(eq1);
+                totalOps2validDepsMem.pop_back();
+                delete totalOps2validDeps;
             }
         }
 
@@ -676,7 +680,7 @@ private:
             const set<size_t>& deps = id2Deps[varId_[*shared]];
 
             for (size_t dep : deps) {
-                EquationPattern<Base>* otherEq = dep2Equation_.at(dep);
+                EquationPattern<Base>* otherEq = depEquation_[dep];
                 if (eq != otherEq) {
                     Loop<Base>* loop = equation2Loop_.at(otherEq);
                     // the original ID (saved in evaluation order) is used to sort shared variables
@@ -791,37 +795,62 @@ private:
         varColor.adjustSize();
         varColor.fill(0);
 
+        /**
+         * only dependents with the same structural fingerprint can have the
+         * same expression pattern
+         */
+        fingerprint_.assign(handler_->getManagedNodesCount(), 0);
+        fingerprintDefined_.assign(handler_->getManagedNodesCount(), false);
+
+        std::vector<bool> used(dependents_.size(), false);
+        std::unordered_map<size_t, std::vector<size_t> > fingerprint2Deps;
+        std::vector<std::pair<std::vector<size_t>*, size_t> > depPosition; // bucket and position in the bucket
+
         size_t rSize = relatedDepCandidates_.size();
         for (size_t r = 0; r < rSize; r++) {
             const std::set<size_t>& candidates = relatedDepCandidates_[r];
-            std::set<size_t> used;
+
+            fingerprint2Deps.clear();
+            for (size_t iDep : candidates) {
+                fingerprint2Deps[fingerprint(dependents_[iDep])].push_back(iDep); // sorted
+            }
+
+            depPosition.clear();
+            depPosition.reserve(candidates.size());
+            for (size_t iDep : candidates) {
+                std::vector<size_t>& bucket = fingerprint2Deps[fingerprint(dependents_[iDep])];
+                size_t pos = std::lower_bound(bucket.begin(), bucket.end(), iDep) - bucket.begin();
+                depPosition.emplace_back(&bucket, pos);
+            }
 
             eqCurr_ = nullptr;
 
-            std::set<size_t>::const_iterator itRef;
-            for (itRef = candidates.begin(); itRef != candidates.end(); ++itRef) {
+            size_t c = 0;
+            for (auto itRef = candidates.begin(); itRef != candidates.end(); ++itRef, ++c) {
                 size_t iDepRef = *itRef;
 
                 // check if it has already been used
-                if (used.find(iDepRef) != used.end()) {
+                if (used[iDepRef]) {
                     continue;
                 }
 
-                if (eqCurr_ == nullptr || !used.empty()) {
-                    eqCurr_ = new EquationPattern<Base>(dependents_[iDepRef], iDepRef);
-                    equations_.push_back(eqCurr_);
+                const std::vector<size_t>& bucket = *depPosition[c].first;
+                if (depPosition[c].second + 1 == bucket.size()) {
+                    continue; // no other candidate with the same fingerprint
                 }
 
-                auto it = itRef;
-                for (++it; it != candidates.end(); ++it) {
-                    size_t iDep = *it;
+                eqCurr_ = new EquationPattern<Base>(dependents_[iDepRef], iDepRef);
+                equations_.push_back(eqCurr_);
+
+                for (size_t b = depPosition[c].second + 1; b < bucket.size(); ++b) {
+                    size_t iDep = bucket[b];
                     // check if it has already been used
-                    if (used.find(iDep) != used.end()) {
+                    if (used[iDep]) {
                         continue;
                     }
 
                     if (eqCurr_->testAdd(iDep, dependents_[iDep], color_, varColor)) {
-                        used.insert(iDep);
+                        used[iDep] = true;
                     }
                 }
 
@@ -832,6 +861,10 @@ private:
                     equations_.pop_back();
                 }
             }
+
+            for (size_t iDep : candidates) {
+                used[iDep] = false;
+            }
         }
 
         /**
@@ -845,6 +878,79 @@ private:
         return equations_;
     }
 
+protected:
+
+    /**
+     * Determines a structural fingerprint for the expression of a dependent
+     * variable.
+     * Dependents with different fingerprints cannot have the same
+     * expression pattern (see EquationPattern::comparePath()), therefore
+     * the independent variable indexes and the parameter values are not
+     * considered.
+     * Dependents with the same fingerprint are still fully compared.
+     */
+    virtual size_t fingerprint(const CG<Base>& dep) {
+        const OperationNode<Base>* root = dep.getOperationNode();
+        if (root == nullptr)
+            return size_t(CGOpCode::NumberOp); // any parameter
+
+        if (fingerprint_.size() < handler_->getManagedNodesCount()) {
+            fingerprint_.resize(handler_->getManagedNodesCount(), 0);
+            fingerprintDefined_.resize(handler_->getManagedNodesCount(), false);
+        }
+
+        if (fingerprintDefined_[root->getHandlerPosition()])
+            return fingerprint_[root->getHandlerPosition()];
+
+        fingerprintStack_.clear();
+        fingerprintStack_.emplace_back(root, 0);
+
+        while (!fingerprintStack_.empty()) {
+            const OperationNode<Base>& node = *fingerprintStack_.back().first;
+            size_t& pos = fingerprintStack_.back().second;
+            const std::vector<Argument<Base> >& args = node.getArguments();
+
+            if (pos < args.size()) {
+                const OperationNode<Base>* a = args[pos++].getOperation();
+                if (a != nullptr && !fingerprintDefined_[a->getHandlerPosition()])
+                    fingerprintStack_.emplace_back(a, 0);
+                continue;
+            }
+
+            CGOpCode op = node.getOperationType();
+            size_t h = size_t(op);
+            if (op == CGOpCode::Alias && args[0].getOperation() != nullptr &&
+                args[0].getOperation()->getOperationType() != CGOpCode::Inv) {
+                // aliases are ignored
+                h = fingerprint_[args[0].getOperation()->getHandlerPosition()];
+            } else if (op != CGOpCode::Inv) {
+                combineFingerprint(h, args.size());
+                for (size_t v : node.getInfo())
+                    combineFingerprint(h, v);
+                for (const Argument<Base>& a : args) {
+                    const OperationNode<Base>* an = a.getOperation();
+                    if (an == nullptr)
+                        combineFingerprint(h, size_t(CGOpCode::NumberOp)); // any parameter
+                    else
+                        combineFingerprint(h, fingerprint_[an->getHandlerPosition()]);
+                }
+            }
+
+            fingerprint_[node.getHandlerPosition()] = h;
+            fingerprintDefined_[node.getHandlerPosition()] = true;
+            fingerprintStack_.pop_back();
+        }
+
+        return fingerprint_[root->getHandlerPosition()];
+    }
+
+    static inline void combineFingerprint(size_t& seed,
+                                          size_t v) {
+        seed ^= v + size_t(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2);
+    }
+
+private:
+
     /**
      * Finds nodes which can be shared with other equation patterns
      *
@@ -914,7 +1020,7 @@ private:
              */
             for (size_t otherDep : deps) {
 
-                EquationPattern<Base>* otherEquation = dep2Equation_.at(otherDep);
+                EquationPattern<Base>* otherEquation = depEquation_[otherDep];
                 if (otherEquation != eqCurr_) {
                     /**
                      * temporary variable shared with a different loop
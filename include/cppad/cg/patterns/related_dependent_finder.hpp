@@ -0,0 +1,264 @@
+#ifndef CPPAD_CG_RELATED_DEPENDENT_FINDER_INCLUDED
+#define CPPAD_CG_RELATED_DEPENDENT_FINDER_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Determines groups of dependent variables which are likely to have the same
+ * expression pattern so that they can be provided to a
+ * DependentPatternMatcher (related dependent candidates).
+ *
+ * A structural hash is computed for the expression of each dependent which
+ * considers the operation types, the operation information, and the
+ * order of the arguments but not which independent variables or
+ * parameter values are used.
+ * Dependents with the same hash are placed in the same group.
+ * Groups are only candidates since hash collisions and differences in the
+ * indexing of independent variables are handled by the pattern matcher.
+ */
+template<class Base>
+class RelatedDependentFinder {
+public:
+    using CGBase = CG<Base>;
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+private:
+    /// the minimum number of dependents in a group
+    size_t minGroupSize_;
+    /// the minimum number of operations in the expression of a dependent
+    size_t minOperations_;
+    /// the hash of each node (indexed by handler position)
+    std::vector<size_t> hash_;
+    /// whether or not the hash of a node has been determined
+    std::vector<bool> evaluated_;
+    /// whether or not a node is known to depend on at least minOperations_ operations
+    std::vector<bool> enoughOps_;
+    /// the last search which visited each node (indexed by handler position)
+    std::vector<size_t> visited_;
+    /// the current search used to count operations
+    size_t search_;
+    /// depth-first search stack
+    std::vector<std::pair<const Node*, size_t> > stack_;
+    /// stack used to count operations
+    std::vector<const Node*> countStack_;
+public:
+
+    inline RelatedDependentFinder() :
+            minGroupSize_(2),
+            minOperations_(1),
+            search_(0) {
+    }
+
+    /**
+     * The minimum number of dependents in each group of related dependents
+     * (smaller groups are discarded).
+     */
+    inline size_t getMinimumGroupSize() const {
+        return minGroupSize_;
+    }
+
+    inline void setMinimumGroupSize(size_t minGroupSize) {
+        minGroupSize_ = std::max<size_t>(minGroupSize, 2);
+    }
+
+    /**
+     * The minimum number of operations required in the expression of a
+     * dependent variable for it to be included in a group.
+     * Dependents which are parameters or independent variables are never
+     * included.
+     */
+    inline size_t getMinimumOperations() const {
+        return minOperations_;
+    }
+
+    inline void setMinimumOperations(size_t minOperations) {
+        minOperations_ = std::max<size_t>(minOperations, 1);
+    }
+
+    /**
+     * Determines groups of dependents with the same structural hash.
+     *
+     * @param dependents the dependent variables
+     * @return the groups of related dependent candidates sorted by the
+     *         lowest dependent index
+     */
+    inline std::vector<std::set<size_t> > find(const std::vector<CGBase>& dependents) {
+        std::vector<size_t> depHash(dependents.size(), 0);
+        std::vector<bool> valid(dependents.size(), false);
+
+        CodeHandler<Base>* handler = nullptr;
+        for (const CGBase& dep : dependents) {
+            if (dep.getOperationNode() != nullptr) {
+                handler = dep.getOperationNode()->getCodeHandler();
+                break;
+            }
+        }
+        if (handler == nullptr)
+            return std::vector<std::set<size_t> >(); // no variables
+
+        size_t nNodes = handler->getManagedNodesCount();
+        hash_.assign(nNodes, 0);
+        evaluated_.assign(nNodes, false);
+        enoughOps_.assign(nNodes, false);
+        visited_.assign(nNodes, 0);
+        search_ = 0;
+
+        for (size_t i = 0; i < dependents.size(); i++) {
+            const Node* node = dependents[i].getOperationNode();
+            if (node == nullptr || node->getOperationType() == CGOpCode::Inv)
+                continue;
+
+            CPPADCG_ASSERT_KNOWN(node->getCodeHandler() == handler,
+                                 "All dependent variables must belong to the same code handler")
+
+            determineHash(*node);
+            if (hasMinimumOperations(*node)) {
+                depHash[i] = hash_[node->getHandlerPosition()];
+                valid[i] = true;
+            }
+        }
+
+        /**
+         * group the dependents
+         */
+        std::unordered_map<size_t, size_t> hash2Group;
+        std::vector<std::set<size_t> > groups;
+        for (size_t i = 0; i < dependents.size(); i++) {
+            if (!valid[i])
+                continue;
+            auto it = hash2Group.emplace(depHash[i], groups.size());
+            if (it.second)
+                groups.emplace_back();
+            groups[it.first->second].insert(i);
+        }
+
+        std::vector<std::set<size_t> > related;
+        related.reserve(groups.size());
+        for (std::set<size_t>& g : groups) {
+            if (g.size() >= minGroupSize_)
+                related.push_back(std::move(g));
+        }
+
+        hash_.clear();
+        evaluated_.clear();
+        enoughOps_.clear();
+        visited_.clear();
+
+        return related;
+    }
+
+private:
+
+    static inline void combine(size_t& seed,
+                               size_t v) {
+        seed ^= v + size_t(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2);
+    }
+
+    /**
+     * Determines the structural hash of a node (without recursion).
+     */
+    inline void determineHash(const Node& root) {
+        if (evaluated_[root.getHandlerPosition()])
+            return;
+
+        stack_.clear();
+        stack_.emplace_back(&root, 0);
+
+        while (!stack_.empty()) {
+            const Node& node = *stack_.back().first;
+            size_t& pos = stack_.back().second;
+            const std::vector<Arg>& args = node.getArguments();
+
+            if (pos < args.size()) {
+                const Node* a = args[pos++].getOperation();
+                if (a != nullptr && !evaluated_[a->getHandlerPosition()]) {
+                    stack_.emplace_back(a, 0);
+                }
+                continue;
+            }
+
+            // all arguments have been processed
+            size_t h = size_t(node.getOperationType());
+            if (node.getOperationType() != CGOpCode::Inv) {
+                combine(h, args.size());
+                for (size_t v : node.getInfo())
+                    combine(h, v);
+                for (const Arg& a : args) {
+                    const Node* an = a.getOperation();
+                    if (an != nullptr) {
+                        combine(h, hash_[an->getHandlerPosition()]);
+                    } else {
+                        combine(h, size_t(CGOpCode::NumberOp)); // any parameter
+                    }
+                }
+            }
+
+            size_t p = node.getHandlerPosition();
+            hash_[p] = h;
+            evaluated_[p] = true;
+            stack_.pop_back();
+        }
+    }
+
+    /**
+     * Whether or not the expression of a node has at least minOperations_
+     * distinct operations.
+     * Shared sub-expressions are only counted once and the search stops
+     * as soon as enough operations are found. The nodes which are known
+     * to have enough operations are remembered for the other dependents.
+     */
+    inline bool hasMinimumOperations(const Node& root) {
+        size_t rootPos = root.getHandlerPosition();
+        if (enoughOps_[rootPos])
+            return true;
+
+        search_++;
+        size_t ops = 0;
+
+        countStack_.clear();
+        countStack_.push_back(&root);
+        visited_[rootPos] = search_;
+
+        while (!countStack_.empty()) {
+            const Node& node = *countStack_.back();
+            countStack_.pop_back();
+
+            if (enoughOps_[node.getHandlerPosition()] || ++ops >= minOperations_) {
+                enoughOps_[rootPos] = true;
+                return true;
+            }
+
+            for (const Arg& a : node.getArguments()) {
+                const Node* an = a.getOperation();
+                if (an != nullptr && an->getOperationType() != CGOpCode::Inv &&
+                    visited_[an->getHandlerPosition()] != search_) {
+                    visited_[an->getHandlerPosition()] = search_;
+                    countStack_.push_back(an);
+                }
+            }
+        }
+
+        return false;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
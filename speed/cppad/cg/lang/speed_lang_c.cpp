@@ -0,0 +1,138 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Measures the time required by LanguageC to print the source code of a
+ * large operation graph with many constants (the time spent creating the
+ * operation graph is not included).
+ */
+#include <cppad/cg/cppadcg.hpp>
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+using ADCGD = AD<CGD>;
+
+namespace {
+
+std::unique_ptr<ADFun<CGD> > createModel(size_t m) {
+    std::vector<ADCGD> x(4);
+    for (size_t j = 0; j < x.size(); j++)
+        x[j] = Base(j + 1);
+    Independent(x);
+
+    std::vector<ADCGD> y(m);
+    for (size_t i = 0; i < m; i++) {
+        Base c = Base(i + 1) / 7.0;
+        ADCGD v = x[i % 4] * c + 0.125;
+        v = v * x[(i + 1) % 4] - Base(i);
+        y[i] = sin(v) * 3.25e-5 + v / (x[(i + 2) % 4] + c * c);
+    }
+
+    return std::unique_ptr<ADFun<CGD> >(new ADFun<CGD>(x, y));
+}
+
+/**
+ * @return the elapsed time in seconds
+ */
+double generate(ADFun<CGD>& fun,
+                size_t& length) {
+    CodeHandler<Base> handler;
+
+    std::vector<CGD> indVars(fun.Domain());
+    handler.makeVariables(indVars);
+
+    std::vector<CGD> dep = fun.Forward(0, indVars);
+
+    LanguageC<Base> langC("double");
+    LangCDefaultVariableNameGenerator<Base> nameGen;
+
+    std::ostringstream code;
+
+    auto start = std::chrono::steady_clock::now();
+    handler.generateCode(code, langC, dep, nameGen);
+    auto end = std::chrono::steady_clock::now();
+
+    length = code.str().size();
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/**
+ * @return the value of a positive integer command line argument or zero if
+ *         it is not a positive integer
+ */
+size_t parsePositive(const std::string& value) {
+    long n = 0;
+    size_t pos = 0;
+    try {
+        n = std::stol(value, &pos);
+    } catch (const std::exception&) {
+        return 0; // not a number
+    }
+    if (pos != value.size() || n < 1)
+        return 0;
+    return size_t(n);
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes{1000, 10000, 100000};
+    size_t nExec = 5;
+
+    for (int a = 1; a + 1 < argc; a += 2) {
+        std::string arg = argv[a];
+        std::string value = argv[a + 1];
+        if (arg == "-n") {
+            nExec = parsePositive(value);
+            if (nExec == 0) {
+                std::cerr << "Invalid number of executions " << value << " (must be at least 1)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-m") {
+            size_t m = parsePositive(value);
+            if (m == 0) {
+                std::cerr << "Invalid number of equations " << value << " (must be at least 1)" << std::endl;
+                return 1;
+            }
+            sizes = {m};
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "equations  characters  best time (s)  time per equation (us)" << std::endl;
+
+    for (size_t m : sizes) {
+        std::unique_ptr<ADFun<CGD> > fun = createModel(m);
+
+        size_t length = 0;
+        double best = std::numeric_limits<double>::max();
+        for (size_t e = 0; e < nExec; e++) {
+            best = std::min(best, generate(*fun, length));
+        }
+
+        std::cout << std::setw(9) << m << "  "
+                  << std::setw(10) << length << "  "
+                  << std::setw(13) << best << "  "
+                  << std::setw(22) << best * 1e6 / m << std::endl;
+    }
+
+    return 0;
+}
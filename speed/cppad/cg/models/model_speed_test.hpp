@@ -0,0 +1,492 @@
+#ifndef CPPAD_CG_MODELSPEEDTEST_INCLUDED
+#define CPPAD_CG_MODELSPEEDTEST_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/cppadcg.hpp>
+#ifdef CPPAD_CG_BENCHMARK_LLVM
+#include <cppad/cg/model/llvm/llvm.hpp>
+#endif
+#include "../patterns/job_speed_listener.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * The compiler used to create a model library
+ */
+enum class ModelSpeedBackend {
+    GCC,
+    CLANG,
+    LLVM // JIT
+};
+
+inline const char* toString(ModelSpeedBackend backend) {
+    switch (backend) {
+        case ModelSpeedBackend::GCC:
+            return "GCC";
+        case ModelSpeedBackend::CLANG:
+            return "CLANG";
+        default:
+            return "LLVM";
+    }
+}
+
+inline const char* toString(MultiThreadingType type) {
+    switch (type) {
+        case MultiThreadingType::NONE:
+            return "NONE";
+        case MultiThreadingType::OPENMP:
+            return "OPENMP";
+        default:
+            return "PTHREADS";
+    }
+}
+
+/**
+ * A model which can be benchmarked for several sizes
+ */
+class ModelSpeedCase {
+public:
+    using Base = double;
+    using CGD = CppAD::cg::CG<Base>;
+    using ADCGD = CppAD::AD<CGD>;
+public:
+    /// the model name
+    std::string name;
+    /// the model size (e.g. number of repetitions or discretization elements)
+    size_t size;
+    /// typical independent variable values (also used in the evaluations)
+    std::vector<Base> x;
+    /// groups of related equations (loops are used when not empty)
+    std::vector<std::set<size_t> > relatedDependents;
+    /// models used as atomic functions
+    std::vector<GenericModel<Base>*> externalModels;
+    /// records the model operations
+    std::function<std::vector<ADCGD>(const std::vector<ADCGD>&)> model;
+};
+
+/**
+ * Measures the time required to tape a model, generate its source code,
+ * compile it, load it, and evaluate each of the generated functions.
+ * The results are written in the JSON format.
+ */
+class ModelSpeedTest {
+public:
+    using Base = double;
+    using CGD = CppAD::cg::CG<Base>;
+    using ADCGD = CppAD::AD<CGD>;
+    using duration = std::chrono::steady_clock::duration;
+protected:
+    std::ostream& out_;
+    std::vector<std::string> compileFlags_;
+    std::string clangPath_;
+    size_t nTimes_;
+    duration minThroughputTime_;
+    bool verbose_;
+    bool firstResult_;
+    JobSpeedListener listener_;
+public:
+
+    /**
+     * @param out where the JSON document is written
+     */
+    inline explicit ModelSpeedTest(std::ostream& out,
+                                   bool verbose = false) :
+            out_(out),
+            clangPath_("/usr/bin/clang"),
+            nTimes_(50),
+            minThroughputTime_(std::chrono::milliseconds(200)),
+            verbose_(verbose),
+            firstResult_(true) {
+    }
+
+    ModelSpeedTest(const ModelSpeedTest&) = delete;
+    ModelSpeedTest& operator=(const ModelSpeedTest&) = delete;
+
+    /**
+     * Defines the number of evaluations used to determine the latency of
+     * each function (at least one).
+     */
+    inline void setNumberOfExecutions(size_t nTimes) {
+        if (nTimes == 0)
+            throw CGException("The number of executions must be at least 1");
+        nTimes_ = nTimes;
+    }
+
+    /**
+     * Defines the minimum amount of time used to determine the throughput
+     * of each function.
+     */
+    inline void setMinThroughputTime(duration time) {
+        minThroughputTime_ = time;
+    }
+
+    inline void setCompileFlags(const std::vector<std::string>& compileFlags) {
+        compileFlags_ = compileFlags;
+    }
+
+    inline void setClangPath(const std::string& clangPath) {
+        clangPath_ = clangPath;
+    }
+
+    /**
+     * Starts the JSON document (must be called once before any benchmark).
+     */
+    inline void begin() {
+        out_ << "{\n"
+                "  \"benchmark\": \"cppadcg_models\",\n"
+                "  \"version\": 1,\n"
+                "  \"results\": [";
+        firstResult_ = true;
+    }
+
+    /**
+     * Terminates the JSON document.
+     */
+    inline void end() {
+        out_ << "\n  ]\n}" << std::endl;
+    }
+
+    /**
+     * Benchmarks a model for a given backend and threading type and writes
+     * one entry in the results.
+     * Errors are saved in the results instead of being thrown.
+     */
+    inline void measureSpeed(ModelSpeedCase& c,
+                             ModelSpeedBackend backend,
+                             MultiThreadingType threading) {
+        using namespace std::chrono;
+
+        std::string libName = c.name + "_" + std::to_string(c.size) + "_" + toString(backend) + "_" + toString(threading);
+
+        std::vector<std::pair<std::string, duration> > phases;
+        std::vector<std::pair<std::string, std::vector<duration> > > latencies;
+        std::vector<std::pair<std::string, double> > throughputs;
+        size_t n = c.x.size();
+        size_t m = 0;
+        std::string error;
+
+        if (verbose_) {
+            std::cerr << libName << std::endl;
+        }
+
+        try {
+            /**
+             * tape
+             */
+            auto t0 = steady_clock::now();
+            std::unique_ptr<ADFun<CGD> > fun = tapeModel(c);
+            phases.emplace_back("tape", steady_clock::now() - t0);
+            m = fun->Range();
+
+            /**
+             * source code generation
+             */
+            listener_.reset();
+            ModelCSourceGen<Base> modelSourceGen(*fun, libName);
+            modelSourceGen.setCreateForwardZero(true);
+            modelSourceGen.setCreateSparseJacobian(true);
+            modelSourceGen.setCreateSparseHessian(true);
+            modelSourceGen.setCreateForwardOne(true);
+            modelSourceGen.setCreateReverseOne(true);
+            modelSourceGen.setCreateReverseTwo(true);
+            modelSourceGen.setTypicalIndependentValues(c.x);
+            if (!c.relatedDependents.empty())
+                modelSourceGen.setRelatedDependents(c.relatedDependents);
+
+            ModelLibraryCSourceGen<Base> libSourceGen(modelSourceGen);
+            libSourceGen.setMultiThreading(threading);
+            libSourceGen.addListener(listener_);
+
+            t0 = steady_clock::now();
+            libSourceGen.getLibrarySources(); // also generates the model sources
+            phases.emplace_back("source_generation", steady_clock::now() - t0);
+            if (!c.relatedDependents.empty())
+                phases.emplace_back("loop_detection", listener_.patternDection);
+
+            /**
+             * compilation and loading
+             */
+            std::unique_ptr<ModelLibrary<Base> > lib;
+            std::unique_ptr<GenericModel<Base> > model;
+
+            if (backend == ModelSpeedBackend::LLVM) {
+#ifdef CPPAD_CG_BENCHMARK_LLVM
+                t0 = steady_clock::now();
+                lib = LlvmModelLibraryProcessor<Base>::create(libSourceGen);
+                phases.emplace_back("compilation", steady_clock::now() - t0);
+#else
+                throw CGException("LLVM is not available");
+#endif
+            } else {
+                std::unique_ptr<AbstractCCompiler<Base> > compiler;
+                if (backend == ModelSpeedBackend::GCC)
+                    compiler.reset(new GccCompiler<Base>());
+                else
+                    compiler.reset(new ClangCompiler<Base>(clangPath_));
+
+                if (!compileFlags_.empty())
+                    compiler->setCompileFlags(compileFlags_);
+
+                DynamicModelLibraryProcessor<Base> p(libSourceGen, "lib" + libName);
+                if (threading == MultiThreadingType::OPENMP) {
+                    compiler->addCompileFlag("-fopenmp");
+                    compiler->addCompileFlag("-pthread");
+                    compiler->addCompileLibFlag("-fopenmp");
+#ifdef CPPAD_CG_SYSTEM_LINUX
+                    // the OpenMP implementation in GCC causes a segmentation fault on dlclose
+                    p.getOptions()["dlOpenMode"] = std::to_string(RTLD_NOW | RTLD_NODELETE);
+#endif
+                } else if (threading == MultiThreadingType::PTHREADS) {
+                    compiler->addCompileFlag("-pthread");
+                }
+
+                t0 = steady_clock::now();
+                p.createDynamicLibrary(*compiler, false);
+                phases.emplace_back("compilation", steady_clock::now() - t0);
+
+                t0 = steady_clock::now();
+                lib = p.loadDynamicLibrary();
+                phases.emplace_back("load", steady_clock::now() - t0);
+            }
+
+            t0 = steady_clock::now();
+            model = lib->model(libName);
+            phases.emplace_back("model_load", steady_clock::now() - t0);
+            if (model == nullptr)
+                throw CGException("Failed to load model ", libName);
+
+            for (GenericModel<Base>* e : c.externalModels)
+                model->addExternalModel(*e);
+
+            /**
+             * evaluation
+             */
+            measureCalls(*model, c.x, latencies, throughputs);
+
+            model.reset(); // must be deleted before the library
+            lib.reset();
+
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+
+        printResult(c, backend, threading, n, m, phases, latencies, throughputs, error);
+    }
+
+protected:
+
+    inline std::unique_ptr<ADFun<CGD> > tapeModel(ModelSpeedCase& c) {
+        std::vector<ADCGD> x(c.x.size());
+        for (size_t j = 0; j < x.size(); j++)
+            x[j] = c.x[j];
+        CppAD::Independent(x);
+
+        std::vector<ADCGD> y = c.model(x);
+
+        std::unique_ptr<ADFun<CGD> > fun(new ADFun<CGD>());
+        fun->Dependent(y);
+        return fun;
+    }
+
+    /**
+     * Determines the latency and the throughput of a function.
+     */
+    template<class Function>
+    inline void measure(const std::string& name,
+                        Function f,
+                        std::vector<std::pair<std::string, std::vector<duration> > >& latencies,
+                        std::vector<std::pair<std::string, double> >& throughputs) {
+        using namespace std::chrono;
+
+        f(); // warm up
+
+        std::vector<duration> dt(nTimes_);
+        for (size_t i = 0; i < nTimes_; i++) {
+            auto t0 = steady_clock::now();
+            f();
+            dt[i] = steady_clock::now() - t0;
+        }
+        latencies.emplace_back(name, std::move(dt));
+
+        size_t calls = 0;
+        auto t0 = steady_clock::now();
+        duration elapsed;
+        do {
+            for (size_t i = 0; i < 16; i++)
+                f();
+            calls += 16;
+            elapsed = steady_clock::now() - t0;
+        } while (elapsed < minThroughputTime_);
+        throughputs.emplace_back(name, double(calls) / duration_cast<std::chrono::duration<double> >(elapsed).count());
+    }
+
+    inline void measureCalls(GenericModel<Base>& model,
+                             const std::vector<Base>& x,
+                             std::vector<std::pair<std::string, std::vector<duration> > >& latencies,
+                             std::vector<std::pair<std::string, double> >& throughputs) {
+        size_t n = model.Domain();
+        size_t m = model.Range();
+
+        std::vector<Base> y(m);
+        std::vector<Base> w(m, 1.0);
+
+        if (model.isForwardZeroAvailable()) {
+            measure("ForwardZero", [&]() { model.ForwardZero(x, y); }, latencies, throughputs);
+        }
+
+        if (model.isSparseJacobianAvailable()) {
+            std::vector<Base> jac;
+            std::vector<size_t> rows, cols;
+            measure("SparseJacobian", [&]() { model.SparseJacobian(x, jac, rows, cols); }, latencies, throughputs);
+        }
+
+        if (model.isSparseHessianAvailable()) {
+            std::vector<Base> hess;
+            std::vector<size_t> rows, cols;
+            measure("SparseHessian", [&]() { model.SparseHessian(x, w, hess, rows, cols); }, latencies, throughputs);
+        }
+
+        if (model.isForwardOneAvailable()) {
+            std::vector<Base> tx(2 * n);
+            for (size_t j = 0; j < n; j++)
+                tx[j * 2] = x[j];
+            tx[1] = 1.0; // direction
+            std::vector<Base> ty(2 * m);
+            measure("ForwardOne", [&]() { model.ForwardOne(tx, ty); }, latencies, throughputs);
+        }
+
+        if (model.isReverseOneAvailable()) {
+            std::vector<Base> py(m, 1.0);
+            std::vector<Base> px(n);
+            measure("ReverseOne", [&]() { model.ReverseOne(x, y, px, py); }, latencies, throughputs);
+        }
+
+        if (model.isReverseTwoAvailable()) {
+            std::vector<Base> tx(2 * n);
+            for (size_t j = 0; j < n; j++)
+                tx[j * 2] = x[j];
+            tx[1] = 1.0; // direction
+            std::vector<Base> ty(2 * m);
+            std::vector<Base> py(2 * m);
+            for (size_t i = 0; i < m; i++)
+                py[i * 2 + 1] = 1.0;
+            std::vector<Base> px(2 * n);
+            measure("ReverseTwo", [&]() { model.ReverseTwo(tx, ty, px, py); }, latencies, throughputs);
+        }
+    }
+
+    inline void printResult(const ModelSpeedCase& c,
+                            ModelSpeedBackend backend,
+                            MultiThreadingType threading,
+                            size_t n,
+                            size_t m,
+                            const std::vector<std::pair<std::string, duration> >& phases,
+                            const std::vector<std::pair<std::string, std::vector<duration> > >& latencies,
+                            const std::vector<std::pair<std::string, double> >& throughputs,
+                            const std::string& error) {
+        OStreamConfigRestore osr(out_);
+        out_ << std::setprecision(9);
+
+        out_ << (firstResult_ ? "\n" : ",\n");
+        firstResult_ = false;
+
+        out_ << "    {\n"
+                "      \"model\": \"" << c.name << "\",\n"
+                "      \"size\": " << c.size << ",\n"
+                "      \"n\": " << n << ",\n"
+                "      \"m\": " << m << ",\n"
+                "      \"loops\": " << (c.relatedDependents.empty() ? "false" : "true") << ",\n"
+                "      \"backend\": \"" << toString(backend) << "\",\n"
+                "      \"threading\": \"" << toString(threading) << "\",\n";
+
+        // times in seconds
+        out_ << "      \"phases\": {";
+        for (size_t i = 0; i < phases.size(); i++) {
+            out_ << (i == 0 ? "\n" : ",\n")
+                 << "        \"" << phases[i].first << "\": " << seconds(phases[i].second);
+        }
+        out_ << "\n      },\n";
+
+        out_ << "      \"calls\": {";
+        for (size_t i = 0; i < latencies.size(); i++) {
+            std::vector<double> times(latencies[i].second.size());
+            for (size_t k = 0; k < times.size(); k++)
+                times[k] = seconds(latencies[i].second[k]);
+            std::sort(times.begin(), times.end());
+
+            out_ << (i == 0 ? "\n" : ",\n")
+                 << "        \"" << latencies[i].first << "\": {"
+                 << "\"repetitions\": " << times.size() << ", "
+                 << "\"mean\": " << mean(times) << ", "
+                 << "\"std_dev\": " << stdDev(times) << ", "
+                 << "\"min\": " << times.front() << ", "
+                 << "\"median\": " << times[times.size() / 2] << ", "
+                 << "\"max\": " << times.back() << ", "
+                 << "\"throughput\": " << throughputs[i].second << "}";
+        }
+        out_ << "\n      }";
+
+        if (!error.empty()) {
+            out_ << ",\n      \"error\": \"" << escape(error) << "\"";
+        }
+
+        out_ << "\n    }";
+        out_.flush();
+    }
+
+    static inline double seconds(duration d) {
+        return std::chrono::duration<double>(d).count();
+    }
+
+    static inline double mean(const std::vector<double>& v) {
+        double sum = 0;
+        for (double t : v)
+            sum += t;
+        return v.empty() ? 0.0 : sum / v.size();
+    }
+
+    static inline double stdDev(const std::vector<double>& v) {
+        if (v.size() < 2)
+            return 0.0;
+        double avg = mean(v);
+        double sum = 0;
+        for (double t : v)
+            sum += (t - avg) * (t - avg);
+        return std::sqrt(sum / (v.size() - 1));
+    }
+
+    static inline std::string escape(const std::string& s) {
+        std::string r;
+        r.reserve(s.size());
+        for (char ch : s) {
+            if (ch == '"' || ch == '\\') {
+                r += '\\';
+                r += ch;
+            } else if (ch == '\n') {
+                r += "\\n";
+            } else if (static_cast<unsigned char>(ch) >= 0x20) {
+                r += ch;
+            }
+        }
+        return r;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
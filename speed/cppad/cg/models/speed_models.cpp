@@ -0,0 +1,392 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <fstream>
+#include "model_speed_test.hpp"
+#include "../../../../test/cppad/cg/models/cstr.hpp"
+#include "../../../../test/cppad/cg/models/distillation.hpp"
+#include "../../../../test/cppad/cg/models/tank_battery.hpp"
+#include "../../../../test/cppad/cg/models/plug_flow.hpp"
+#include "../../../../test/cppad/cg/models/collocation.hpp"
+
+namespace CppAD {
+namespace cg {
+
+using Base = double;
+using CGD = CppAD::cg::CG<Base>;
+using ADCGD = CppAD::AD<CGD>;
+using ModelFunction = std::function<std::vector<ADCGD>(const std::vector<ADCGD>&)>;
+
+/**
+ * Collocation model using the Plugflow model
+ */
+template<class T>
+class PlugFlowCollocationModel : public CollocationModel<T> {
+protected:
+    size_t nEls_; // number of plugflow discretization elements
+public:
+
+    explicit PlugFlowCollocationModel(size_t nEls) :
+        CollocationModel<T>(PlugFlowModel<AD<double>>::N_EL_STATES * nEls, // ns
+                            PlugFlowModel<AD<double>>::N_CONTROLS, // nm
+                            PlugFlowModel<AD<double>>::N_PAR), // npar
+        nEls_(nEls) {
+    }
+
+protected:
+
+    void atomicFunction(const std::vector<AD<CG<double> > >& x,
+                        std::vector<AD<CG<double> > >& y) override {
+        PlugFlowModel<CG<double> > m;
+        y = m.model2(x, nEls_);
+    }
+
+    void atomicFunction(const std::vector<AD<double> >& x,
+                        std::vector<AD<double> >& y) override {
+        PlugFlowModel<double> m;
+        y = m.model2(x, nEls_);
+    }
+
+    std::string getAtomicLibName() override {
+        return "plugflow_" + std::to_string(nEls_);
+    }
+};
+
+/**
+ * Creates a model with several independent copies of a small model so that
+ * it can be benchmarked for different sizes.
+ */
+inline ModelSpeedCase createReplicatedCase(const std::string& name,
+                                           size_t size,
+                                           const std::vector<Base>& xBlock,
+                                           size_t mBlock,
+                                           ModelFunction blockModel) {
+    size_t nBlock = xBlock.size();
+
+    ModelSpeedCase c;
+    c.name = name;
+    c.size = size;
+    c.x.resize(nBlock * size);
+    for (size_t b = 0; b < size; b++)
+        std::copy(xBlock.begin(), xBlock.end(), c.x.begin() + b * nBlock);
+
+    // the same equation in each copy is related
+    c.relatedDependents.resize(mBlock);
+    for (size_t i = 0; i < mBlock; i++) {
+        for (size_t b = 0; b < size; b++)
+            c.relatedDependents[i].insert(b * mBlock + i);
+    }
+
+    c.model = [=](const std::vector<ADCGD>& x) {
+        std::vector<ADCGD> y;
+        y.reserve(mBlock * size);
+        std::vector<ADCGD> xb(nBlock);
+        for (size_t b = 0; b < size; b++) {
+            std::copy(x.begin() + b * nBlock, x.begin() + (b + 1) * nBlock, xb.begin());
+            std::vector<ADCGD> yb = blockModel(xb);
+            y.insert(y.end(), yb.begin(), yb.end());
+        }
+        return y;
+    };
+
+    return c;
+}
+
+inline ModelSpeedCase createCstrCase(size_t size) {
+    std::vector<Base> x(28);
+    x[0] = 0.3; // h
+    x[1] = 7.82e3; // Ca
+    x[2] = 304.65; // Tr
+    x[3] = 301.15; // Tj
+    x[4] = 2.3333e-04; // u1
+    x[5] = 6.6667e-05; // u2
+    x[6] = 6.2e14;
+    x[7] = 10080;
+    x[8] = 2e3;
+    x[9] = 10e3;
+    x[10] = 1e-11;
+    x[11] = 6.6667e-05;
+    x[12] = 294.15;
+    x[13] = 294.15;
+    x[14] = 1000;
+    x[15] = 4184; // Cp
+    x[16] = -33488; // deltaH
+    x[17] = 299.15; // Tj0
+    x[18] = 302.65; // Tj2
+    x[19] = 7e5; // cwallj
+    x[20] = 1203; // csteam
+    x[21] = 3.22; // dsteam
+    x[22] = 950.0; // Ug
+    x[23] = 0.48649427192323; // vc6in
+    x[24] = 1000; // rhoj
+    x[25] = 4184; // Cpj
+    x[26] = 0.014; // Vj
+    x[27] = 1e-7; // cwallr
+
+    return createReplicatedCase("cstr", size, x, 4, &CstrFunc<CGD>);
+}
+
+inline ModelSpeedCase createDistillationCase(size_t size) {
+    const size_t nStage = 8;
+    std::vector<Base> x(nStage * 6 + 8);
+
+    size_t j = 0;
+    for (size_t i = 0; i < nStage; i++, j++) x[j] = 12000 + 1; // mWater
+    for (size_t i = 0; i < nStage; i++, j++) x[j] = 12000 + 1; // mEthanol[i]
+    for (size_t i = 0; i < nStage; i++, j++) x[j] = 360 + (i + 1); // T[i]
+    for (size_t i = 0; i < nStage; i++, j++) x[j] = 0.3 + 0.05 * i; // yWater[i]
+    for (size_t i = 0; i < nStage; i++, j++) x[j] = 0.7 - 0.05 * i; // yEthanol[i]
+    for (size_t i = 0; i < nStage - 1; i++, j++) x[j] = 8 + 0.1 * i; // V[i]
+    x[j++] = 150e3; // Qc
+
+    x[j++] = 250e3; // Qsteam
+    x[j++] = 0.1; // Fdistillate
+    x[j++] = 2.5; // reflux
+    x[j++] = 4; // Frectifier
+
+    x[j++] = 30; // feed
+    x[j++] = 1.01325e5; // P
+    x[j++] = 0.7; // xFWater
+    x[j++] = 366; // Tfeed
+
+    return createReplicatedCase("distillation", size, x, nStage * 6, &distillationFunc<CGD>);
+}
+
+inline ModelSpeedCase createTankBatteryCase(size_t size) {
+    std::vector<Base> x(8, 1.0);
+
+    return createReplicatedCase("tank_battery", size, x, 6, &tankBatteryFunc<CGD>);
+}
+
+inline ModelSpeedCase createPlugFlowCase(size_t size) {
+    ModelSpeedCase c;
+    c.name = "plug_flow";
+    c.size = size;
+    c.x = PlugFlowModel<CGD>::getTypicalValues(size);
+    c.relatedDependents = PlugFlowModel<CGD>::getRelatedCandidates(size);
+    c.model = [size](const std::vector<ADCGD>& x) {
+        PlugFlowModel<CGD> m;
+        return m.model2(x, size);
+    };
+    return c;
+}
+
+/**
+ * Collocation (K = 3) of a plugflow model with 10 elements which is used as
+ * an atomic function; the size is the number of time intervals.
+ */
+inline ModelSpeedCase createCollocationCase(size_t size,
+                                            PlugFlowCollocationModel<CGD>& collocation,
+                                            GenericModel<Base>& atomic) {
+    const size_t K = 3;
+    const size_t nEls = 10;
+    size_t m = K * PlugFlowModel<CGD>::N_EL_STATES * nEls;
+
+    ModelSpeedCase c;
+    c.name = "collocation";
+    c.size = size;
+    c.x = collocation.getTypicalValues(size);
+    c.externalModels.push_back(&atomic);
+
+    c.relatedDependents.resize(m);
+    for (size_t i = 0; i < size; i++) {
+        for (size_t ii = 0; ii < m; ii++)
+            c.relatedDependents[ii].insert(i * m + ii);
+    }
+
+    c.model = [size, &collocation](const std::vector<ADCGD>& x) {
+        return collocation.evaluateModel(x, size);
+    };
+    return c;
+}
+
+inline std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> r;
+    std::istringstream is(s);
+    std::string v;
+    while (std::getline(is, v, ',')) {
+        if (!v.empty())
+            r.push_back(v);
+    }
+    return r;
+}
+
+inline bool contains(const std::vector<std::string>& v,
+                     const std::string& s) {
+    return std::find(v.begin(), v.end(), s) != v.end();
+}
+
+/**
+ * @return the value of a positive integer command line argument or zero if
+ *         it is not a positive integer
+ */
+inline size_t parsePositive(const std::string& value) {
+    long n = 0;
+    size_t pos = 0;
+    try {
+        n = std::stol(value, &pos);
+    } catch (const std::exception&) {
+        return 0; // not a number
+    }
+    if (pos != value.size() || n < 1)
+        return 0;
+    return size_t(n);
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * Usage:
+ *   speed_models [-o file.json] [-sizes 1,5,10] [-models cstr,plug_flow]
+ *                [-backends GCC,CLANG,LLVM] [-threading NONE,OPENMP,PTHREADS]
+ *                [-n executions] [-clang /usr/bin/clang] [-v]
+ */
+int main(int argc, char** argv) {
+    std::string outFile;
+    std::vector<size_t> sizes{1, 10, 50};
+    std::vector<std::string> models{"cstr", "distillation", "tank_battery", "plug_flow", "collocation"};
+    std::vector<std::string> backends{"GCC", "CLANG"};
+#ifdef CPPAD_CG_BENCHMARK_LLVM
+    backends.push_back("LLVM");
+#endif
+    std::vector<std::string> threading{"NONE", "OPENMP", "PTHREADS"};
+    size_t nExec = 50;
+    std::string clangPath;
+    bool verbose = false;
+
+    for (int a = 1; a < argc; a++) {
+        std::string arg = argv[a];
+        if (arg == "-v") {
+            verbose = true;
+            continue;
+        }
+        if (a + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        }
+        std::string value = argv[++a];
+        if (arg == "-o") outFile = value;
+        else if (arg == "-sizes") {
+            sizes.clear();
+            for (const std::string& s : split(value)) {
+                size_t size = parsePositive(s);
+                if (size == 0) {
+                    std::cerr << "Invalid model size " << s << " (must be at least 1)" << std::endl;
+                    return 1;
+                }
+                sizes.push_back(size);
+            }
+        }
+        else if (arg == "-models") models = split(value);
+        else if (arg == "-backends") backends = split(value);
+        else if (arg == "-threading") threading = split(value);
+        else if (arg == "-n") {
+            nExec = parsePositive(value);
+            if (nExec == 0) {
+                std::cerr << "Invalid number of executions " << value << " (must be at least 1)" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "-clang") clangPath = value;
+        else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!outFile.empty()) {
+        file.open(outFile);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open " << outFile << std::endl;
+            return 1;
+        }
+    }
+
+    ModelSpeedTest speed(outFile.empty() ? std::cout : file, verbose);
+    speed.setNumberOfExecutions(nExec);
+    if (!clangPath.empty())
+        speed.setClangPath(clangPath);
+
+    /**
+     * the atomic model used by the collocation model
+     */
+    const size_t nEls = 10;
+    std::unique_ptr<PlugFlowCollocationModel<CGD> > collocation;
+    std::unique_ptr<PlugFlowCollocationModel<Base> > collocationAtomic;
+    if (contains(models, "collocation")) {
+        collocation.reset(new PlugFlowCollocationModel<CGD>(nEls));
+        collocationAtomic.reset(new PlugFlowCollocationModel<Base>(nEls));
+
+        std::vector<double> xAtom = PlugFlowModel<CGD>::getTypicalValues(nEls);
+        collocation->setTypicalAtomModelValues(xAtom);
+        collocationAtomic->setTypicalAtomModelValues(xAtom);
+
+        collocation->createAtomicLib();
+        collocationAtomic->createAtomicLib();
+    }
+
+    speed.begin();
+
+    for (const std::string& name : models) {
+        for (size_t size : sizes) {
+            ModelSpeedCase c;
+            if (name == "cstr") c = createCstrCase(size);
+            else if (name == "distillation") c = createDistillationCase(size);
+            else if (name == "tank_battery") c = createTankBatteryCase(size);
+            else if (name == "plug_flow") c = createPlugFlowCase(size);
+            else if (name == "collocation") c = createCollocationCase(size, *collocation, *collocationAtomic->getGenericModel());
+            else {
+                std::cerr << "Unknown model " << name << std::endl;
+                return 1;
+            }
+
+            for (const std::string& t : threading) {
+                MultiThreadingType type;
+                if (t == "NONE") type = MultiThreadingType::NONE;
+                else if (t == "OPENMP") type = MultiThreadingType::OPENMP;
+                else if (t == "PTHREADS") type = MultiThreadingType::PTHREADS;
+                else {
+                    std::cerr << "Unknown threading type " << t << std::endl;
+                    return 1;
+                }
+
+                for (const std::string& b : backends) {
+                    ModelSpeedBackend backend;
+                    if (b == "GCC") backend = ModelSpeedBackend::GCC;
+                    else if (b == "CLANG") backend = ModelSpeedBackend::CLANG;
+                    else if (b == "LLVM") backend = ModelSpeedBackend::LLVM;
+                    else {
+                        std::cerr << "Unknown backend " << b << std::endl;
+                        return 1;
+                    }
+
+                    if (backend == ModelSpeedBackend::LLVM && type == MultiThreadingType::OPENMP)
+                        continue; // OpenMP is not supported by the JIT
+
+                    speed.measureSpeed(c, backend, type);
+                }
+            }
+        }
+    }
+
+    speed.end();
+
+    return 0;
+}
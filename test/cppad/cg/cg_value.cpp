@@ -0,0 +1,214 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGTest, ValueParameterCopyMove) {
+    CGD p(2.5);
+    ASSERT_TRUE(p.isParameter());
+    ASSERT_TRUE(p.isValueDefined());
+    ASSERT_EQ(p.getValue(), 2.5);
+
+    CGD copy(p);
+    ASSERT_TRUE(copy.isParameter());
+    ASSERT_EQ(copy.getValue(), 2.5);
+    ASSERT_EQ(p.getValue(), 2.5);
+
+    CGD moved(std::move(copy));
+    ASSERT_TRUE(moved.isParameter());
+    ASSERT_EQ(moved.getValue(), 2.5);
+    ASSERT_FALSE(copy.isValueDefined());
+    ASSERT_THROW(copy.getValue(), CGException);
+
+    CGD assigned;
+    assigned = p;
+    ASSERT_TRUE(assigned.isParameter());
+    ASSERT_EQ(assigned.getValue(), 2.5);
+
+    CGD moveAssigned;
+    moveAssigned = std::move(assigned);
+    ASSERT_TRUE(moveAssigned.isParameter());
+    ASSERT_EQ(moveAssigned.getValue(), 2.5);
+    ASSERT_FALSE(assigned.isValueDefined());
+    ASSERT_THROW(assigned.getValue(), CGException);
+
+    moveAssigned = 4.0;
+    ASSERT_TRUE(moveAssigned.isParameter());
+    ASSERT_EQ(moveAssigned.getValue(), 4.0);
+}
+
+TEST_F(CppADCGTest, ValueVariableCopyMove) {
+    CodeHandler<double> handler;
+
+    CGD x;
+    handler.makeVariable(x);
+    ASSERT_TRUE(x.isVariable());
+    ASSERT_FALSE(x.isValueDefined());
+    ASSERT_THROW(x.getValue(), CGException);
+
+    CGD copy(x);
+    ASSERT_TRUE(copy.isVariable());
+    ASSERT_EQ(copy.getOperationNode(), x.getOperationNode());
+    ASSERT_FALSE(copy.isValueDefined());
+
+    x.setValue(3.0);
+    ASSERT_TRUE(x.isVariable());
+    ASSERT_EQ(x.getValue(), 3.0);
+
+    CGD moved(std::move(x));
+    ASSERT_TRUE(moved.isVariable());
+    ASSERT_EQ(moved.getValue(), 3.0);
+    ASSERT_FALSE(x.isValueDefined());
+
+    // a variable without a value must not keep the value of a parameter
+    CGD p(1.5);
+    p = copy;
+    ASSERT_TRUE(p.isVariable());
+    ASSERT_FALSE(p.isValueDefined());
+    ASSERT_THROW(p.getValue(), CGException);
+
+    // a parameter must replace the variable
+    p = CGD(2.0);
+    ASSERT_TRUE(p.isParameter());
+    ASSERT_EQ(p.getValue(), 2.0);
+
+    p = std::move(moved);
+    ASSERT_TRUE(p.isVariable());
+    ASSERT_EQ(p.getValue(), 3.0);
+}
+
+TEST_F(CppADCGTest, ValueCompoundAssignment) {
+    CodeHandler<double> handler;
+
+    CGD x;
+    handler.makeVariable(x);
+
+    CGD xv;
+    handler.makeVariable(xv);
+    xv.setValue(2.0);
+
+    // parameter and parameter
+    CGD p(3.0);
+    p += CGD(1.0);
+    ASSERT_TRUE(p.isParameter());
+    ASSERT_EQ(p.getValue(), 4.0);
+    p -= 1.0;
+    ASSERT_EQ(p.getValue(), 3.0);
+    p *= 2.0;
+    ASSERT_EQ(p.getValue(), 6.0);
+    p /= 3.0;
+    ASSERT_TRUE(p.isParameter());
+    ASSERT_EQ(p.getValue(), 2.0);
+
+    // parameter and variable with a value
+    CGD a(3.0);
+    a += xv;
+    ASSERT_TRUE(a.isVariable());
+    ASSERT_EQ(a.getValue(), 5.0);
+    a -= xv;
+    ASSERT_TRUE(a.isVariable());
+    ASSERT_EQ(a.getValue(), 3.0);
+    a *= xv;
+    ASSERT_EQ(a.getValue(), 6.0);
+    a /= xv;
+    ASSERT_EQ(a.getValue(), 3.0);
+
+    // parameter and variable without a value
+    CGD b(3.0);
+    b *= x;
+    ASSERT_TRUE(b.isVariable());
+    ASSERT_FALSE(b.isValueDefined());
+    ASSERT_THROW(b.getValue(), CGException);
+
+    // the value must not be defined by a parameter on the right hand side
+    b += 1.0;
+    ASSERT_TRUE(b.isVariable());
+    ASSERT_FALSE(b.isValueDefined());
+
+    // operations which become a copy of the right hand side
+    CGD zero(0.0);
+    zero += x;
+    ASSERT_TRUE(zero.isVariable());
+    ASSERT_EQ(zero.getOperationNode(), x.getOperationNode());
+    ASSERT_FALSE(zero.isValueDefined());
+
+    CGD one(1.0);
+    one *= xv;
+    ASSERT_TRUE(one.isVariable());
+    ASSERT_EQ(one.getOperationNode(), xv.getOperationNode());
+    ASSERT_EQ(one.getValue(), 2.0);
+
+    // operations which become a parameter
+    CGD c(x);
+    c *= 0.0;
+    ASSERT_TRUE(c.isParameter());
+    ASSERT_EQ(c.getValue(), 0.0);
+
+    // operations which do not change the left hand side
+    CGD d(xv);
+    d -= 0.0;
+    d /= 1.0;
+    ASSERT_TRUE(d.isVariable());
+    ASSERT_EQ(d.getOperationNode(), xv.getOperationNode());
+    ASSERT_EQ(d.getValue(), 2.0);
+}
+
+TEST_F(CppADCGTest, ValueArgument) {
+    CodeHandler<double> handler;
+
+    CGD x;
+    handler.makeVariable(x);
+
+    Argument<double> pArg(2.5);
+    ASSERT_TRUE(pArg.getOperation() == nullptr);
+    ASSERT_TRUE(pArg.getParameter() != nullptr);
+    ASSERT_EQ(*pArg.getParameter(), 2.5);
+
+    Argument<double> copy(pArg);
+    ASSERT_TRUE(copy.getParameter() != nullptr);
+    ASSERT_EQ(*copy.getParameter(), 2.5);
+
+    Argument<double> moved(std::move(copy));
+    ASSERT_TRUE(moved.getParameter() != nullptr);
+    ASSERT_EQ(*moved.getParameter(), 2.5);
+    ASSERT_TRUE(copy.getParameter() == nullptr);
+
+    Argument<double> vArg = x.argument();
+    ASSERT_TRUE(vArg.getOperation() == x.getOperationNode());
+    ASSERT_TRUE(vArg.getParameter() == nullptr);
+
+    // a variable argument must not keep the value of a parameter
+    Argument<double> assigned(1.0);
+    assigned = vArg;
+    ASSERT_TRUE(assigned.getOperation() == x.getOperationNode());
+    ASSERT_TRUE(assigned.getParameter() == nullptr);
+
+    assigned = pArg;
+    ASSERT_TRUE(assigned.getOperation() == nullptr);
+    ASSERT_EQ(*assigned.getParameter(), 2.5);
+
+    Argument<double> moveAssigned(x.argument());
+    moveAssigned = std::move(moved);
+    ASSERT_TRUE(moveAssigned.getOperation() == nullptr);
+    ASSERT_EQ(*moveAssigned.getParameter(), 2.5);
+    ASSERT_TRUE(moved.getParameter() == nullptr);
+
+    // arguments of a parameter
+    CGD p(4.0);
+    ASSERT_TRUE(p.argument().getParameter() != nullptr);
+    ASSERT_EQ(*p.argument().getParameter(), 4.0);
+}
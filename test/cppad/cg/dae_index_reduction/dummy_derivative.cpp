@@ -17,6 +17,7 @@
 
 #include "CppADCGIndexReductionTest.hpp"
 #include "model/pendulum.hpp"
+#include "model/nonlinear_coupling.hpp"
 
 using namespace CppAD;
 using namespace CppAD::cg;
@@ -183,3 +184,67 @@ TEST_F(IndexReductionTest, DummyDerivPendulum3D) {
 
     delete fun;
 }
+
+/**
+ * @test the elimination of time derivatives must undo an assignment which
+ *       leaves another time derivative without any equation to solve it
+ */
+TEST_F(IndexReductionTest, DummyDerivUndoAssignment) {
+    using namespace std;
+
+    std::vector<DaeVarInfo> daeVar;
+    std::vector<std::string> eqName;
+
+    // create f: U -> Z and vectors used for derivative calculations
+    ADFun<CGD>* fun = NonlinearCoupling<CGD> (daeVar, eqName);
+
+    std::vector<double> x(daeVar.size());
+    std::vector<double> normVar(daeVar.size(), 1.0);
+    std::vector<double> normEq(6, 1.0);
+
+    x[7] = 0.3; // dx1dt
+    x[8] = std::asin(0.2); // dx2dt
+    x[9] = 0.0; // dx3dt
+
+    x[0] = 0.5; // x1
+    x[1] = x[7]; // x2
+    x[2] = 2.0; // x3
+    x[3] = x[9]; // w
+    x[4] = x[8] + std::sin(x[7]); // y1
+    x[5] = x[8] + std::cos(x[7]); // y2
+    x[6] = 0.0; // time
+
+    Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+    DummyDerivatives<double> dummyD(pantelides, x, normVar, normEq);
+    dummyD.setGenerateSemiExplicitDae(true);
+    dummyD.setReduceEquations(true);
+
+    std::ostringstream log;
+    dummyD.setLog(log);
+    dummyD.setVerbosity(Verbosity::High);
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> newEqInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun;
+    ASSERT_NO_THROW(reducedFun = dummyD.reduceIndex(newDaeVar, newEqInfo));
+
+    ASSERT_TRUE(reducedFun != nullptr);
+
+    ASSERT_EQ(size_t(2), pantelides.getStructuralIndex());
+
+    for (const DaeVarInfo& v : newDaeVar) {
+        if (v.getName() == "x3") {
+            ASSERT_TRUE(v.getDerivative() < 0);
+        }
+        ASSERT_TRUE(v.getName() != "dx3dt");
+    }
+
+    // the same selection as with the dense Jacobian sparsity
+    std::string out = log.str();
+    ASSERT_NE(out.find("Undoing the assignment of dx1dt to A (dx2dt would not be solvable)"), std::string::npos);
+    ASSERT_NE(out.find("## Variable dx1dt assigned to equation B"), std::string::npos);
+    ASSERT_NE(out.find("## Variable dx2dt assigned to equation C"), std::string::npos);
+    ASSERT_NE(out.find("## Variable dx3dt assigned to equation E"), std::string::npos);
+
+    delete fun;
+}
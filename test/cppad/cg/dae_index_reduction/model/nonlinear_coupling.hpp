@@ -0,0 +1,79 @@
+#ifndef CPPAD_CG_TEST_NONLINEAR_COUPLING_INCLUDED
+#define CPPAD_CG_TEST_NONLINEAR_COUPLING_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * An index 2 DAE where using the first equation (A) to solve for dx1dt
+ * prevents dx2dt from being solved by any other equation, while using the
+ * second equation (B) does not.
+ */
+template<class Base>
+inline CppAD::ADFun<Base>* NonlinearCoupling(std::vector<DaeVarInfo>& daeVar,
+                                             std::vector<std::string>& eqName) {
+    using namespace CppAD;
+    using namespace std;
+    using ADB = CppAD::AD<Base>;
+
+    std::vector<ADB> U(10);
+    Independent(U);
+
+    ADB x1 = U[0];
+    ADB x2 = U[1];
+    ADB x3 = U[2];
+    ADB w = U[3];
+    ADB y1 = U[4];
+    ADB y2 = U[5];
+    ADB t = U[6]; // time (not really used)
+
+    ADB dx1dt = U[7];
+    ADB dx2dt = U[8];
+    ADB dx3dt = U[9];
+
+    daeVar.resize(U.size());
+    daeVar[0] = DaeVarInfo("x1");
+    daeVar[1] = DaeVarInfo("x2");
+    daeVar[2] = DaeVarInfo("x3");
+    daeVar[3] = DaeVarInfo("w");
+    daeVar[4] = DaeVarInfo("y1");
+    daeVar[5] = DaeVarInfo("y2");
+    daeVar[6] = DaeVarInfo("t");
+    daeVar[6].makeIntegratedVariable();
+    daeVar[7] = 0;
+    daeVar[8] = 1;
+    daeVar[9] = 2;
+
+    eqName = {"A", "B", "C", "D", "E", "G"};
+
+    // dependent variable vector
+    std::vector<ADB> Z(6);
+    Z[0] = dx1dt + sin(dx2dt) - x1;
+    Z[1] = dx1dt - x2;
+    Z[2] = dx2dt + sin(dx1dt) - y1;
+    Z[3] = dx2dt + cos(dx1dt) - y2;
+    Z[4] = dx3dt - w;
+    Z[5] = x3 - 2;
+
+    // create f: U -> Z and vectors used for derivative calculations
+    return new ADFun<Base> (U, Z);
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
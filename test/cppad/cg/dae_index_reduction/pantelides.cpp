@@ -14,6 +14,7 @@
  */
 //#define CPPAD_CG_DAE_VERBOSE
 #include <cppad/cg/dae_index_reduction/pantelides.hpp>
+#include <cppad/cg/dae_index_reduction/augment_path_bfs.hpp>
 
 #include "CppADCGIndexReductionTest.hpp"
 #include "model/pendulum.hpp"
@@ -143,3 +144,104 @@ TEST_F(IndexReductionTest, PantelidesPendulum3D) {
 
     delete fun;
 }
+
+TEST_F(IndexReductionTest, PantelidesPendulum2DBfs) {
+    using CGD = CG<double>;
+
+    std::vector<DaeVarInfo> daeVar;
+    // create f: U -> Z and vectors used for derivative calculations
+    ADFun<CGD>* fun = Pendulum2D<CGD> (daeVar);
+
+    std::vector<double> x(daeVar.size());
+    x[0] = -1.0; // x
+    x[1] = 0.0; // y
+    x[2] = 0.0; // vx
+    x[3] = 0.0; // vy
+    x[4] = 1.0; // Tension
+    x[5] = 1.0; // length
+
+    x[6] = 0.0; // time
+
+    x[7] = 0.0; // dxdt
+    x[8] = 0.0; // dydt
+    x[9] = -1.0; // dvxdt
+    x[10] = 9.80665; // dvydt
+
+    std::vector<std::string> eqName; // empty
+
+    AugmentPathBfs<double> augment;
+
+    Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+    pantelides.setAugmentPath(augment);
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> equationInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun;
+    ASSERT_NO_THROW(reducedFun = pantelides.reduceIndex(newDaeVar, equationInfo));
+
+    ASSERT_TRUE(reducedFun != nullptr);
+
+    ASSERT_EQ(size_t(3), pantelides.getStructuralIndex());
+
+    delete fun;
+}
+
+TEST_F(IndexReductionTest, BfsAugmentPath) {
+    /**
+     * Eq0: V0, V1
+     * Eq1: V0
+     * Eq2: V1, V2
+     * Eq3: V2
+     * (the maximum matching has 3 assignments)
+     */
+    std::vector<std::unique_ptr<Vnode<double> > > vnodes;
+    for (size_t j = 0; j < 3; j++) {
+        vnodes.emplace_back(new Vnode<double>(j, int(j), "V" + std::to_string(j)));
+    }
+
+    std::vector<std::unique_ptr<Enode<double> > > enodes;
+    for (size_t i = 0; i < 4; i++) {
+        enodes.emplace_back(new Enode<double>(i));
+    }
+
+    const std::vector<std::vector<size_t> > edges{{0, 1}, {0}, {1, 2}, {2}};
+    for (size_t i = 0; i < edges.size(); i++) {
+        for (size_t j : edges[i]) {
+            enodes[i]->addVariable(vnodes[j].get());
+        }
+    }
+
+    auto uncolor = [&]() {
+        for (const auto& i : enodes)
+            i->uncolor();
+        for (const auto& j : vnodes)
+            j->uncolor();
+    };
+
+    vnodes[0]->setAssignmentEquation(*enodes[0]);
+
+    AugmentPathBfs<double> augment;
+
+    // the existing assignment must be changed
+    ASSERT_TRUE(augment.augmentPath(*enodes[1]));
+    ASSERT_EQ(vnodes[0]->assignmentEquation(), enodes[1].get());
+    ASSERT_EQ(vnodes[1]->assignmentEquation(), enodes[0].get());
+
+    uncolor();
+    ASSERT_TRUE(augment.augmentPath(*enodes[2]));
+    ASSERT_EQ(vnodes[2]->assignmentEquation(), enodes[2].get());
+
+    // no augmenting path: the visited equations are colored
+    uncolor();
+    ASSERT_FALSE(augment.augmentPath(*enodes[3]));
+    ASSERT_TRUE(enodes[3]->isColored());
+    ASSERT_TRUE(enodes[2]->isColored());
+    ASSERT_TRUE(enodes[0]->isColored());
+    ASSERT_TRUE(enodes[1]->isColored());
+
+    for (const auto& i : enodes) {
+        if (i->assignmentVariable() != nullptr) {
+            ASSERT_EQ(i->assignmentVariable()->assignmentEquation(), i.get());
+        }
+    }
+}
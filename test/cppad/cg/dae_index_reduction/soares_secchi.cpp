@@ -14,6 +14,7 @@
  */
 //#define CPPAD_CG_DAE_VERBOSE
 #include <cppad/cg/dae_index_reduction/soares_secchi.hpp>
+#include <cppad/cg/dae_index_reduction/augment_path_bfs_a.hpp>
 
 #include "CppADCGIndexReductionTest.hpp"
 #include "model/pendulum.hpp"
@@ -141,3 +142,46 @@ TEST_F(IndexReductionTest, SoaresSecchiPendulum3D) {
 
     delete fun;
 }
+
+TEST_F(IndexReductionTest, SoaresSecchiPendulum2DBfs) {
+    using CGD = CG<double>;
+
+    std::vector<DaeVarInfo> daeVar;
+    // create f: U -> Z and vectors used for derivative calculations
+    ADFun<CGD>* fun = Pendulum2D<CGD> (daeVar);
+
+    std::vector<double> x(daeVar.size());
+    x[0] = -1.0; // x
+    x[1] = 0.0; // y
+    x[2] = 0.0; // vx
+    x[3] = 0.0; // vy
+    x[4] = 1.0; // Tension
+    x[5] = 1.0; // length
+
+    x[6] = 0.0; // time
+
+    x[7] = 0.0; // dxdt
+    x[8] = 0.0; // dydt
+    x[9] = -1.0; // dvxdt
+    x[10] = 9.80665; // dvydt
+
+    std::vector<std::string> eqName; // empty
+
+    AugmentPathBfs<double> augment;
+    AugmentPathBfsA<double> augmentA;
+
+    SoaresSecchi<double> soaresSecchi(*fun, daeVar, eqName, x);
+    soaresSecchi.setAugmentPath(augment);
+    soaresSecchi.setAugmentPathA(augmentA);
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> equationInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun;
+    ASSERT_NO_THROW(reducedFun = soaresSecchi.reduceIndex(newDaeVar, equationInfo));
+
+    ASSERT_TRUE(reducedFun != nullptr);
+
+    ASSERT_EQ(size_t(3), soaresSecchi.getStructuralIndex());
+
+    delete fun;
+}
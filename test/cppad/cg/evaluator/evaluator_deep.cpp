@@ -0,0 +1,58 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGEvaluatorTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * A graph deep enough to exhaust the stack of a recursive evaluation
+ */
+TEST_F(CppADCGEvaluatorTest, Deep) {
+    const size_t depth = 100000;
+
+    CodeHandler<double> handlerOrig;
+
+    std::vector<CGD> xOrig(2);
+    handlerOrig.makeVariables(xOrig);
+    xOrig[0].setValue(0.5);
+    xOrig[1].setValue(1.5);
+
+    std::vector<CGD> yOrig(2);
+    yOrig[0] = xOrig[0];
+    for (size_t i = 0; i < depth; i++) {
+        yOrig[0] = yOrig[0] * xOrig[1] - xOrig[0] * yOrig[0];
+    }
+    yOrig[1] = yOrig[0] + xOrig[1];
+
+    Evaluator<Base, Base, CGD> evaluator(handlerOrig);
+
+    // the same evaluator is reused
+    for (double x1 : {1.5, 1.25}) {
+        std::vector<CGD> xNew{0.5, x1};
+
+        std::vector<CGD> yNew = evaluator.evaluate(xNew, yOrig);
+
+        double y = 0.5;
+        for (size_t i = 0; i < depth; i++) {
+            y = y * x1 - 0.5 * y;
+        }
+
+        ASSERT_EQ(yNew.size(), yOrig.size());
+        ASSERT_TRUE(yNew[0].isParameter());
+        ASSERT_EQ(yNew[0].getValue(), y);
+        ASSERT_EQ(yNew[1].getValue(), y + x1);
+    }
+}
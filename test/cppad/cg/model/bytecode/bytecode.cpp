@@ -0,0 +1,138 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGModelTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGBytecodeTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    std::vector<double> _xTape;
+    std::vector<double> _xRun;
+    std::unique_ptr<ADFun<CGD> > _fun;
+public:
+
+    explicit CppADCGBytecodeTest(bool verbose = false,
+                                 bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("bytecode"),
+            _xTape{1.0, 2.0, 0.5},
+            _xRun{1.5, 0.5, 2.0} {
+    }
+
+    void SetUp() override {
+        std::vector<ADCG> ax(_xTape.size());
+        for (size_t j = 0; j < ax.size(); j++) {
+            ax[j] = _xTape[j];
+        }
+        CppAD::Independent(ax);
+
+        std::vector<ADCG> ay(5);
+        ay[0] = ax[0] * sin(ax[1]) + pow(ax[2], 2.5);
+        ay[1] = CondExpGt(ax[0], ax[1], exp(ax[0]) * ax[2], log(ax[1]));
+        ay[2] = ax[1]; // same as an independent variable
+        ay[3] = 3.0; // constant
+        ay[4] = -ax[0] / (1.0 + ax[2] * ax[2]) + sqrt(ax[1]) * ax[0];
+
+        _fun.reset(new ADFun<CGD>());
+        _fun->Dependent(ay);
+    }
+
+    void TearDown() override {
+        _fun.reset();
+    }
+
+    std::unique_ptr<BytecodeGenericModel<double> > createModel() {
+        ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateSparseJacobian(true);
+        modelSourceGen.setCreateSparseHessian(true);
+
+        return std::unique_ptr<BytecodeGenericModel<double> >(new BytecodeGenericModel<double>(modelSourceGen));
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGBytecodeTest, ForwardZero) {
+    std::unique_ptr<BytecodeGenericModel<double> > model = createModel();
+
+    ASSERT_TRUE(model->isForwardZeroAvailable());
+    ASSERT_EQ(model->getName(), _modelName);
+
+    testForwardZeroResults(*model, *_fun, nullptr, _xRun);
+    // registers are reused between evaluations
+    testForwardZeroResults(*model, *_fun, nullptr, _xTape);
+}
+
+TEST_F(CppADCGBytecodeTest, SparseJacobian) {
+    std::unique_ptr<BytecodeGenericModel<double> > model = createModel();
+
+    ASSERT_TRUE(model->isSparseJacobianAvailable());
+
+    testSparseJacobianResults(2, *model, *_fun, nullptr, _xRun, false);
+}
+
+TEST_F(CppADCGBytecodeTest, SparseHessian) {
+    std::unique_ptr<BytecodeGenericModel<double> > model = createModel();
+
+    ASSERT_TRUE(model->isSparseHessianAvailable());
+
+    testSparseHessianResults(2, *model, *_fun, nullptr, _xRun, false);
+}
+
+TEST_F(CppADCGBytecodeTest, RegisterReuse) {
+    std::unique_ptr<BytecodeGenericModel<double> > model = createModel();
+
+    const BytecodeProgram<double>* program = model->getSparseHessianProgram();
+    ASSERT_TRUE(program != nullptr);
+    ASSERT_EQ(program->getIndependentCount(), _fun->Domain() + _fun->Range());
+    ASSERT_GT(program->getInstructionCount(), 0u);
+
+    // temporary variables share registers
+    size_t nVarRegisters = program->getRegisterCount() - program->getConstants().size();
+    ASSERT_LT(nVarRegisters, 1 + program->getIndependentCount() + program->getDependentCount() + program->getInstructionCount());
+}
+
+TEST_F(CppADCGBytecodeTest, SignedZeroConstants) {
+    CodeHandler<double> handler;
+    std::vector<CGD> x(1);
+    handler.makeVariables(x);
+
+    std::vector<CGD> dep{CGD(0.0), CGD(-0.0), x[0] + 1.0};
+
+    LanguageBytecode<double> langBytecode;
+    LangCDefaultVariableNameGenerator<double> nameGen;
+    std::ostringstream code;
+    handler.generateCode(code, langBytecode, dep, nameGen);
+
+    const BytecodeProgram<double>& program = langBytecode.getProgram();
+    std::vector<double> reg;
+    program.initializeRegisters(reg);
+
+    std::vector<double> xv{2.0};
+    std::vector<double> y(dep.size());
+    program.evaluate(reg, xv, y);
+
+    // 0.0 and -0.0 must not share the same constant register
+    ASSERT_FALSE(std::signbit(y[0]));
+    ASSERT_TRUE(std::signbit(y[1]));
+    ASSERT_EQ(y[2], 3.0);
+}
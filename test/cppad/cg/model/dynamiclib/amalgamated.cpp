@@ -0,0 +1,136 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGModelTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGAmalgamatedTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    const std::vector<double> _x;
+    std::unique_ptr<ADFun<CGD> > _fun;
+public:
+
+    explicit CppADCGAmalgamatedTest(bool verbose = false,
+                                    bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("amalgamated"),
+            _x{1.0, 2.0, 0.5, 1.5} {
+    }
+
+    void SetUp() override {
+        std::vector<ADCG> ax(_x.size());
+        for (size_t j = 0; j < ax.size(); j++) {
+            ax[j] = _x[j];
+        }
+        CppAD::Independent(ax);
+
+        std::vector<ADCG> ay(3);
+        ay[0] = ax[0] * sin(ax[1]) + ax[2] * ax[3];
+        ay[1] = exp(ax[1] * ax[2]) - ax[0] / ax[3];
+        ay[2] = ax[3] * ax[3] * cos(ax[0]);
+
+        _fun.reset(new ADFun<CGD>());
+        _fun->Dependent(ay);
+    }
+
+    void TearDown() override {
+        _fun.reset();
+    }
+
+    void testTranslationUnits(const std::string& libName,
+                              size_t translationUnits,
+                              bool lto,
+                              MultiThreadingType multiThreading = MultiThreadingType::NONE) {
+        ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateSparseJacobian(true);
+        modelSourceGen.setCreateSparseHessian(true);
+        modelSourceGen.setMaxAssignmentsPerFunc(2); // several local functions
+        modelSourceGen.setMultiThreading(multiThreading != MultiThreadingType::NONE);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+        libSourceGen.setMultiThreading(multiThreading);
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+        compiler.setLinkTimeOptimization(lto);
+        if (multiThreading == MultiThreadingType::PTHREADS) {
+            compiler.addCompileFlag("-pthread");
+        }
+
+        DynamicModelLibraryProcessor<double> p(libSourceGen, libName);
+        p.setTranslationUnits(translationUnits);
+
+        std::unique_ptr<DynamicLib<double> > lib = p.createDynamicLibrary(compiler);
+        std::unique_ptr<GenericModel<double> > model = lib->model(_modelName);
+        ASSERT_TRUE(model != nullptr);
+
+        std::vector<CGD> xOrig(_x.begin(), _x.end());
+
+        // zero order forward mode
+        std::vector<double> dep(model->Range());
+        model->ForwardZero(_x, dep);
+        std::vector<CGD> depOrig = _fun->Forward(0, xOrig);
+        ASSERT_TRUE(compareValues<double>(dep, depOrig));
+
+        // sparse Jacobian
+        std::vector<double> jac;
+        std::vector<size_t> row, col;
+        model->SparseJacobian(_x, jac, row, col);
+        std::vector<CGD> jacOrig = _fun->Jacobian(xOrig);
+        std::vector<double> jacDense(jacOrig.size(), 0.0);
+        for (size_t e = 0; e < jac.size(); e++) {
+            jacDense[row[e] * _x.size() + col[e]] = jac[e];
+        }
+        ASSERT_TRUE(compareValues<double>(jacDense, jacOrig));
+
+        // sparse Hessian
+        std::vector<double> w(model->Range(), 1.0);
+        std::vector<double> hess;
+        model->SparseHessian(_x, w, hess, row, col);
+        std::vector<CGD> wOrig(w.begin(), w.end());
+        std::vector<CGD> hessOrig = _fun->Hessian(xOrig, wOrig);
+        std::vector<double> hessDense(hessOrig.size(), 0.0);
+        for (size_t e = 0; e < hess.size(); e++) {
+            hessDense[row[e] * _x.size() + col[e]] = hess[e];
+        }
+        ASSERT_TRUE(compareValues<double>(hessDense, hessOrig));
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGAmalgamatedTest, SingleTranslationUnit) {
+    testTranslationUnits("cppad_cg_amalgamated_1", 1, false);
+}
+
+TEST_F(CppADCGAmalgamatedTest, SeveralTranslationUnits) {
+    testTranslationUnits("cppad_cg_amalgamated_3", 3, false);
+}
+
+TEST_F(CppADCGAmalgamatedTest, LinkTimeOptimization) {
+    testTranslationUnits("cppad_cg_amalgamated_lto", 2, true);
+}
+
+TEST_F(CppADCGAmalgamatedTest, PThreads) {
+    testTranslationUnits("cppad_cg_amalgamated_pthreads", 1, false, MultiThreadingType::PTHREADS);
+}
@@ -0,0 +1,188 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGModelTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * y = [x0 * x1, sin(x0)]
+ */
+void arrayViewAtomicModel(const std::vector<AD<double> >& ax, std::vector<AD<double> >& ay) {
+    ay[0] = ax[0] * ax[1];
+    ay[1] = sin(ax[0]);
+}
+
+/**
+ * The same function as arrayViewAtomicModel() with hand-coded derivatives
+ */
+class ArrayViewAtomicModel : public ArrayViewAtomicFun<double> {
+public:
+    const std::string name;
+    size_t calls;
+public:
+    explicit ArrayViewAtomicModel(std::string name) :
+            name(std::move(name)),
+            calls(0) {
+    }
+
+    const std::string& getName() const override {
+        return name;
+    }
+
+    bool ForwardZero(ArrayView<const double> x,
+                     ArrayView<double> y) override {
+        calls++;
+        y[0] = x[0] * x[1];
+        y[1] = std::sin(x[0]);
+        return true;
+    }
+
+    bool ForwardOne(ArrayView<const double> x,
+                    size_t tx1Nnz, const size_t idx[], const double tx1[],
+                    ArrayView<double> ty1) override {
+        calls++;
+        ty1.fill(0);
+        for (size_t e = 0; e < tx1Nnz; e++) {
+            if (idx[e] == 0) {
+                ty1[0] += x[1] * tx1[e];
+                ty1[1] += std::cos(x[0]) * tx1[e];
+            } else {
+                ty1[0] += x[0] * tx1[e];
+            }
+        }
+        return true;
+    }
+
+    bool ReverseOne(ArrayView<const double> x,
+                    ArrayView<double> px,
+                    size_t pyNnz, const size_t idx[], const double py[]) override {
+        calls++;
+        px.fill(0);
+        for (size_t e = 0; e < pyNnz; e++) {
+            if (idx[e] == 0) {
+                px[0] += x[1] * py[e];
+                px[1] += x[0] * py[e];
+            } else {
+                px[0] += std::cos(x[0]) * py[e];
+            }
+        }
+        return true;
+    }
+
+    bool ReverseTwo(ArrayView<const double> x,
+                    size_t tx1Nnz, const size_t idx[], const double tx1[],
+                    ArrayView<double> px2,
+                    ArrayView<const double> py2) override {
+        calls++;
+        px2.fill(0);
+        for (size_t e = 0; e < tx1Nnz; e++) {
+            if (idx[e] == 0) {
+                px2[0] -= py2[1] * std::sin(x[0]) * tx1[e];
+                px2[1] += py2[0] * tx1[e];
+            } else {
+                px2[0] += py2[0] * tx1[e];
+            }
+        }
+        return true;
+    }
+};
+
+class CppADCGArrayViewAtomicTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    const std::vector<double> _x;
+    std::unique_ptr<checkpoint<double> > _atomicFun;
+    std::unique_ptr<CGAtomicFun<double> > _cgAtomicFun;
+    std::unique_ptr<ADFun<CGD> > _fun;
+    std::unique_ptr<DynamicLib<double> > _dynamicLib;
+    std::unique_ptr<GenericModel<double> > _model;
+public:
+
+    explicit CppADCGArrayViewAtomicTest(bool verbose = false,
+                                        bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("array_view_atomic"),
+            _x{1.0, 2.0, 0.5} {
+    }
+
+    void SetUp() override {
+        std::vector<double> xAtomic{_x[0], _x[1] * _x[2]};
+        std::vector<AD<double> > ax(xAtomic.begin(), xAtomic.end()), ay(2);
+        _atomicFun.reset(new checkpoint<double>("atomic", arrayViewAtomicModel, ax, ay));
+        _cgAtomicFun.reset(new CGAtomicFun<double>(*_atomicFun, xAtomic, true));
+
+        std::vector<ADCG> u(_x.size());
+        for (size_t j = 0; j < u.size(); j++) {
+            u[j] = _x[j];
+        }
+        CppAD::Independent(u);
+
+        std::vector<ADCG> au{u[0], u[1] * u[2]}, aw(2);
+        (*_cgAtomicFun)(au, aw);
+
+        std::vector<ADCG> Z(2);
+        Z[0] = aw[0] + u[2] * u[2];
+        Z[1] = aw[1] * u[2];
+
+        _fun.reset(new ADFun<CGD>(u, Z));
+
+        ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateSparseJacobian(true);
+        modelSourceGen.setCreateSparseHessian(true);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+
+        DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_array_view_atomic");
+        _dynamicLib = p.createDynamicLibrary(compiler);
+        // the atomic functions are provided through the GenericModel interface
+        _model = _dynamicLib->model(_modelName);
+    }
+
+    void TearDown() override {
+        _model.reset();
+        _dynamicLib.reset();
+        _fun.reset();
+        _cgAtomicFun.reset();
+        _atomicFun.reset();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGArrayViewAtomicTest, ZeroCopy) {
+    ArrayViewAtomicModel atomic("atomic");
+    ASSERT_TRUE(_model->addAtomicFunction(atomic));
+
+    testForwardZeroResults(*_model, *_fun, nullptr, _x);
+    testSparseJacobianResults(1, *_model, *_fun, nullptr, _x, false);
+    testSparseHessianResults(1, *_model, *_fun, nullptr, _x, false);
+
+    ASSERT_GT(atomic.calls, 0u);
+}
+
+TEST_F(CppADCGArrayViewAtomicTest, UnknownName) {
+    ArrayViewAtomicModel atomic("other");
+    ASSERT_FALSE(_model->addAtomicFunction(atomic));
+}
@@ -0,0 +1,172 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGModelTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * y = [p0 * x0 * x1 + sin(x1) * p1,
+ *      x0 * x0 * p1 + p0 * p1]
+ */
+template<class T>
+void dynamicParameterModel(const std::vector<T>& x,
+                           const std::vector<T>& p,
+                           std::vector<T>& y) {
+    y[0] = p[0] * x[0] * x[1] + sin(x[1]) * p[1];
+    y[1] = x[0] * x[0] * p[1] + p[0] * p[1];
+}
+
+class CppADCGDynamicParametersTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    const std::vector<double> _x;
+    const std::vector<double> _p;
+    std::unique_ptr<ADFun<CGD> > _fun;
+    std::unique_ptr<ADFun<double> > _funOrig;
+public:
+
+    explicit CppADCGDynamicParametersTest(bool verbose = false,
+                                          bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("dynamic_parameters"),
+            _x{1.0, 2.0},
+            _p{0.5, 3.0} {
+    }
+
+    void SetUp() override {
+        std::vector<ADCG> ax(_x.begin(), _x.end()), ap(_p.begin(), _p.end()), ay(2);
+        CppAD::Independent(ax, ap);
+        dynamicParameterModel(ax, ap, ay);
+        _fun.reset(new ADFun<CGD>(ax, ay));
+
+        std::vector<AD<double> > axo(_x.begin(), _x.end()), apo(_p.begin(), _p.end()), ayo(2);
+        CppAD::Independent(axo, apo);
+        dynamicParameterModel(axo, apo, ayo);
+        _funOrig.reset(new ADFun<double>(axo, ayo));
+    }
+
+    void TearDown() override {
+        _fun.reset();
+        _funOrig.reset();
+    }
+
+    void testResults(GenericModel<double>& model,
+                     const std::vector<double>& p) {
+        model.setDynamicParameters(p);
+        _funOrig->new_dynamic(p);
+
+        size_t n = _x.size();
+
+        // zero order forward mode
+        std::vector<double> dep = model.ForwardZero(_x);
+        std::vector<double> depOrig = _funOrig->Forward(0, _x);
+        ASSERT_TRUE(compareValues<double>(dep, depOrig));
+
+        // sparse Jacobian
+        std::vector<double> jac;
+        std::vector<size_t> row, col;
+        model.SparseJacobian(_x, jac, row, col);
+        std::vector<double> jacOrig = _funOrig->Jacobian(_x);
+        std::vector<double> jacDense(jacOrig.size(), 0.0);
+        for (size_t e = 0; e < jac.size(); e++) {
+            jacDense[row[e] * n + col[e]] = jac[e];
+        }
+        ASSERT_TRUE(compareValues<double>(jacDense, jacOrig));
+
+        // sparse Hessian
+        std::vector<double> w{1.0, 2.0};
+        std::vector<double> hess;
+        model.SparseHessian(_x, w, hess, row, col);
+        std::vector<double> hessOrig = _funOrig->Hessian(_x, w);
+        std::vector<double> hessDense(hessOrig.size(), 0.0);
+        for (size_t e = 0; e < hess.size(); e++) {
+            hessDense[row[e] * n + col[e]] = hess[e];
+        }
+        ASSERT_TRUE(compareValues<double>(hessDense, hessOrig));
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicParametersTest, SeveralParameterSets) {
+    ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+    modelSourceGen.setCreateForwardZero(true);
+    modelSourceGen.setCreateSparseJacobian(true);
+    modelSourceGen.setCreateSparseHessian(true);
+    modelSourceGen.setCreateForwardOne(true);
+    modelSourceGen.setCreateReverseTwo(true);
+    modelSourceGen.setTypicalDynamicParameterValues(_p);
+    ASSERT_EQ(modelSourceGen.getDynamicParameterSize(), _p.size());
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_dynamic_parameters");
+    std::unique_ptr<DynamicLib<double> > lib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double> > model = lib->model(_modelName);
+    ASSERT_TRUE(model != nullptr);
+    ASSERT_EQ(model->DynamicParameterSize(), _p.size());
+
+    // the typical values are used until new values are defined
+    std::vector<double> dep = model->ForwardZero(_x);
+    ASSERT_TRUE(compareValues<double>(dep, _funOrig->Forward(0, _x)));
+
+    // a single compiled model for all the parameter values
+    testResults(*model, _p);
+    testResults(*model, std::vector<double>{-1.0, 0.25});
+    testResults(*model, std::vector<double>{2.0, 0.0});
+}
+
+TEST_F(CppADCGDynamicParametersTest, Loops) {
+    GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+    prepareTestCompilerFlags(compiler);
+
+    // the automatic detection of loops is not used
+    ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+    modelSourceGen.setCreateForwardZero(true);
+    modelSourceGen.setCreateSparseJacobian(true);
+    modelSourceGen.setCreateSparseHessian(true);
+    modelSourceGen.setTypicalDynamicParameterValues(_p);
+    modelSourceGen.setAutomaticRelatedDependents(true);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_dynamic_parameters_auto_loops");
+    std::unique_ptr<DynamicLib<double> > lib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double> > model = lib->model(_modelName);
+    ASSERT_TRUE(model != nullptr);
+    ASSERT_TRUE(modelSourceGen.getRelatedDependents().empty());
+
+    testResults(*model, _p);
+
+    // loops which were explicitly requested
+    ModelCSourceGen<double> modelSourceGen2(*_fun, _modelName);
+    modelSourceGen2.setCreateForwardZero(true);
+    modelSourceGen2.setTypicalDynamicParameterValues(_p);
+    modelSourceGen2.setRelatedDependents(std::vector<std::set<size_t> >{std::set<size_t>{0, 1}});
+
+    ModelLibraryCSourceGen<double> libSourceGen2(modelSourceGen2);
+
+    DynamicModelLibraryProcessor<double> p2(libSourceGen2, "cppad_cg_dynamic_parameters_loops");
+    ASSERT_THROW(p2.createDynamicLibrary(compiler), CGException);
+}
@@ -0,0 +1,119 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGModelTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+template<class T>
+void forwardTaylorModel(const std::vector<T>& x,
+                        std::vector<T>& y) {
+    y[0] = x[0] * x[1];
+    y[1] = exp(x[0]) - sin(x[1]) * x[2];
+    y[2] = x[2] / x[0] + sqrt(x[1]);
+}
+
+class CppADCGForwardTaylorTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    const std::vector<double> _x;
+    std::unique_ptr<ADFun<CGD> > _fun;
+public:
+
+    explicit CppADCGForwardTaylorTest(bool verbose = false,
+                                      bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("forward_taylor"),
+            _x{1.0, 2.0, 0.5} {
+    }
+
+    void SetUp() override {
+        std::vector<ADCG> ax(_x.begin(), _x.end()), ay(3);
+        CppAD::Independent(ax);
+        forwardTaylorModel(ax, ay);
+        _fun.reset(new ADFun<CGD>(ax, ay));
+    }
+
+    void TearDown() override {
+        _fun.reset();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGForwardTaylorTest, Order3) {
+    const size_t p = 3;
+    size_t n = _x.size();
+
+    ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+    modelSourceGen.setCreateForwardZero(true);
+    modelSourceGen.setCreateForwardTaylor(p);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> proc(libSourceGen, "cppad_cg_forward_taylor");
+    std::unique_ptr<DynamicLib<double> > lib = proc.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double> > model = lib->model(_modelName);
+    ASSERT_TRUE(model != nullptr);
+
+    ASSERT_TRUE(model->isForwardTaylorAvailable());
+    ASSERT_EQ(model->ForwardTaylorOrder(), p);
+
+    std::vector<double> tx(n * (p + 1));
+    for (size_t j = 0; j < n; j++) {
+        tx[j * (p + 1)] = _x[j];
+        for (size_t k = 1; k <= p; k++) {
+            tx[j * (p + 1) + k] = 0.1 * (j + 1) / k;
+        }
+    }
+
+    // reference values
+    std::vector<AD<double> > ax(_x.begin(), _x.end()), ay(3);
+    CppAD::Independent(ax);
+    forwardTaylorModel(ax, ay);
+    ADFun<double> fun(ax, ay);
+    std::vector<double> tyOrig = fun.Forward(p, tx);
+
+    std::vector<double> ty(tyOrig.size());
+    model->ForwardTaylor(tx, ty);
+
+    ASSERT_TRUE(compareValues(ty, tyOrig));
+}
+
+TEST_F(CppADCGForwardTaylorTest, Disabled) {
+    ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+    modelSourceGen.setCreateForwardZero(true);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> proc(libSourceGen, "cppad_cg_no_forward_taylor");
+    std::unique_ptr<DynamicLib<double> > lib = proc.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double> > model = lib->model(_modelName);
+    ASSERT_TRUE(model != nullptr);
+
+    ASSERT_FALSE(model->isForwardTaylorAvailable());
+    ASSERT_EQ(model->ForwardTaylorOrder(), 0u);
+}
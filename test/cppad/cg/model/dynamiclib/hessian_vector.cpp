@@ -0,0 +1,116 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGModelTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+template<class T>
+void hessianVectorModel(const std::vector<T>& x,
+                        std::vector<T>& y) {
+    y[0] = exp(x[0]) * x[1] + x[2] * x[2];
+    y[1] = sin(x[1]) * x[2] - x[0] * x[0] * x[0];
+}
+
+class CppADCGHessianVectorTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    const std::vector<double> _x;
+    const std::vector<double> _w;
+    std::unique_ptr<ADFun<CGD> > _fun;
+public:
+
+    explicit CppADCGHessianVectorTest(bool verbose = false,
+                                      bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("hessian_vector"),
+            _x{1.0, 2.0, 0.5},
+            _w{0.5, 1.5} {
+    }
+
+    void SetUp() override {
+        std::vector<ADCG> ax(_x.begin(), _x.end()), ay(2);
+        CppAD::Independent(ax);
+        hessianVectorModel(ax, ay);
+        _fun.reset(new ADFun<CGD>(ax, ay));
+    }
+
+    void TearDown() override {
+        _fun.reset();
+    }
+
+    void testProduct(size_t nDir,
+                     const std::string& libName) {
+        size_t n = _x.size();
+
+        ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateHessianVectorProduct(nDir);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+
+        DynamicModelLibraryProcessor<double> p(libSourceGen, libName);
+        std::unique_ptr<DynamicLib<double> > lib = p.createDynamicLibrary(compiler);
+        std::unique_ptr<GenericModel<double> > model = lib->model(_modelName);
+        ASSERT_TRUE(model != nullptr);
+
+        ASSERT_TRUE(model->isHessianVectorProductAvailable());
+        ASSERT_EQ(model->HessianVectorDirections(), nDir);
+
+        std::vector<double> v(nDir * n);
+        for (size_t e = 0; e < v.size(); e++) {
+            v[e] = 0.25 * (e + 1);
+        }
+
+        // reference values
+        std::vector<AD<double> > ax(_x.begin(), _x.end()), ay(2);
+        CppAD::Independent(ax);
+        hessianVectorModel(ax, ay);
+        ADFun<double> fun(ax, ay);
+        std::vector<double> hess = fun.Hessian(_x, _w);
+
+        std::vector<double> hvOrig(nDir * n, 0.0);
+        for (size_t k = 0; k < nDir; k++) {
+            for (size_t i = 0; i < n; i++) {
+                for (size_t j = 0; j < n; j++) {
+                    hvOrig[k * n + i] += hess[i * n + j] * v[k * n + j];
+                }
+            }
+        }
+
+        std::vector<double> hv(nDir * n);
+        model->HessianVectorProduct(_x, _w, v, hv);
+
+        ASSERT_TRUE(compareValues(hv, hvOrig));
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGHessianVectorTest, SingleDirection) {
+    testProduct(1, "cppad_cg_hessian_vector");
+}
+
+TEST_F(CppADCGHessianVectorTest, Block) {
+    testProduct(3, "cppad_cg_hessian_vector_block");
+}
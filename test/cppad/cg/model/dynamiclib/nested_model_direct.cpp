@@ -0,0 +1,166 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGModelTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * y = [x0 * x1, sin(x0)]
+ */
+template<class T>
+void nestedInnerModel(const std::vector<T>& ax, std::vector<T>& ay) {
+    ay[0] = ax[0] * ax[1];
+    ay[1] = sin(ax[0]);
+}
+
+class CppADCGNestedModelDirectTest : public CppADCGModelTest {
+protected:
+    const std::string _innerName;
+    const std::string _outerName;
+    const std::vector<double> _x;
+    std::unique_ptr<checkpoint<double> > _atomicFun;
+    std::unique_ptr<CGAtomicFun<double> > _cgAtomicFun;
+    std::unique_ptr<ADFun<CGD> > _innerFun;
+    std::unique_ptr<ADFun<CGD> > _outerFun;
+public:
+
+    explicit CppADCGNestedModelDirectTest(bool verbose = false,
+                                          bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _innerName("inner"),
+            _outerName("outer"),
+            _x{1.0, 2.0, 0.5} {
+    }
+
+    void SetUp() override {
+        std::vector<double> xInner{_x[0], _x[1] * _x[2]};
+
+        /**
+         * the inner model (taped directly)
+         */
+        std::vector<ADCG> ax(xInner.begin(), xInner.end()), ay(2);
+        CppAD::Independent(ax);
+        nestedInnerModel(ax, ay);
+        _innerFun.reset(new ADFun<CGD>(ax, ay));
+
+        /**
+         * the outer model (uses an atomic function with the name of the
+         * inner model)
+         */
+        std::vector<AD<double> > axa(xInner.begin(), xInner.end()), aya(2);
+        _atomicFun.reset(new checkpoint<double>(_innerName, nestedInnerModel<AD<double> >, axa, aya));
+        _cgAtomicFun.reset(new CGAtomicFun<double>(*_atomicFun, xInner, true));
+
+        std::vector<ADCG> u(_x.begin(), _x.end());
+        CppAD::Independent(u);
+
+        std::vector<ADCG> au{u[0], u[1] * u[2]}, aw(2);
+        (*_cgAtomicFun)(au, aw);
+
+        std::vector<ADCG> Z(2);
+        Z[0] = aw[0] + u[2] * u[2];
+        Z[1] = aw[1] * u[2];
+
+        _outerFun.reset(new ADFun<CGD>(u, Z));
+    }
+
+    void TearDown() override {
+        _outerFun.reset();
+        _innerFun.reset();
+        _cgAtomicFun.reset();
+        _atomicFun.reset();
+    }
+
+    void testLinked(const std::string& libName,
+                    bool derivatives) {
+        ModelCSourceGen<double> innerSourceGen(*_innerFun, _innerName);
+        innerSourceGen.setCreateForwardZero(true);
+        innerSourceGen.setCreateForwardOne(derivatives);
+        innerSourceGen.setCreateReverseOne(derivatives);
+        innerSourceGen.setCreateReverseTwo(derivatives);
+
+        ModelCSourceGen<double> outerSourceGen(*_outerFun, _outerName);
+        outerSourceGen.setCreateForwardZero(true);
+        outerSourceGen.setCreateSparseJacobian(derivatives);
+        outerSourceGen.setCreateSparseHessian(derivatives);
+
+        ModelLibraryCSourceGen<double> libSourceGen(innerSourceGen, outerSourceGen);
+        ASSERT_EQ(libSourceGen.getLinkedModels(), std::set<std::string>{_innerName});
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+
+        DynamicModelLibraryProcessor<double> p(libSourceGen, libName);
+        std::unique_ptr<DynamicLib<double> > lib = p.createDynamicLibrary(compiler);
+
+        // no external models are required
+        std::unique_ptr<GenericModel<double> > outer = lib->model(_outerName);
+
+        testForwardZeroResults(*outer, *_outerFun, nullptr, _x);
+        if (derivatives) {
+            testSparseJacobianResults(1, *outer, *_outerFun, nullptr, _x, false);
+            testSparseHessianResults(1, *outer, *_outerFun, nullptr, _x, false);
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGNestedModelDirectTest, AllModes) {
+    testLinked("cppad_cg_nested_direct", true);
+}
+
+TEST_F(CppADCGNestedModelDirectTest, ForwardZeroOnly) {
+    testLinked("cppad_cg_nested_direct_zero", false);
+}
+
+TEST_F(CppADCGNestedModelDirectTest, MissingModes) {
+    // the sparse Jacobian and Hessian of the outer model require derivatives from the inner model
+    ModelCSourceGen<double> innerSourceGen(*_innerFun, _innerName);
+    innerSourceGen.setCreateForwardZero(true);
+
+    ModelCSourceGen<double> outerSourceGen(*_outerFun, _outerName);
+    outerSourceGen.setCreateForwardZero(true);
+    outerSourceGen.setCreateSparseJacobian(true);
+    outerSourceGen.setCreateSparseHessian(true);
+
+    ModelLibraryCSourceGen<double> libSourceGen(innerSourceGen, outerSourceGen);
+    ASSERT_TRUE(libSourceGen.getLinkedModels().empty());
+
+    // only the first order forward mode is missing
+    innerSourceGen.setCreateReverseOne(true);
+    innerSourceGen.setCreateReverseTwo(true);
+
+    ModelLibraryCSourceGen<double> libSourceGen2(innerSourceGen, outerSourceGen);
+    ASSERT_TRUE(libSourceGen2.getLinkedModels().empty());
+}
+
+TEST_F(CppADCGNestedModelDirectTest, Disabled) {
+    ModelCSourceGen<double> innerSourceGen(*_innerFun, _innerName);
+    innerSourceGen.setCreateForwardZero(true);
+
+    ModelCSourceGen<double> outerSourceGen(*_outerFun, _outerName);
+    outerSourceGen.setCreateForwardZero(true);
+
+    ModelLibraryCSourceGen<double> libSourceGen(innerSourceGen, outerSourceGen);
+    libSourceGen.setLinkNestedModels(false);
+    ASSERT_TRUE(libSourceGen.getLinkedModels().empty());
+}
@@ -0,0 +1,135 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <dirent.h>
+
+#include "CppADCGModelTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGObjectCacheTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    const std::string _cacheFolder;
+    const std::vector<double> _x;
+public:
+
+    explicit CppADCGObjectCacheTest(bool verbose = false,
+                                    bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("object_cache"),
+            _cacheFolder("cppadcg_object_cache"),
+            _x{1.0, 2.0, 0.5} {
+    }
+
+    void SetUp() override {
+        // object files cached by previous runs must not be reused
+        removeFolder(_cacheFolder);
+    }
+
+    /**
+     * Compiles a model where the last equation depends on a factor.
+     *
+     * @param hits the number of sources which were not compiled
+     * @param misses the number of sources which were compiled
+     */
+    void createLibrary(const std::string& libName,
+                       double factor,
+                       std::vector<double>& dep,
+                       size_t& hits,
+                       size_t& misses) {
+        std::vector<ADCG> ax(_x.size());
+        for (size_t j = 0; j < ax.size(); j++) {
+            ax[j] = _x[j];
+        }
+        CppAD::Independent(ax);
+
+        std::vector<ADCG> ay(2);
+        ay[0] = ax[0] * sin(ax[1]) + ax[2];
+        ay[1] = factor * ax[1] * ax[2];
+
+        ADFun<CGD> fun;
+        fun.Dependent(ay);
+
+        ModelCSourceGen<double> modelSourceGen(fun, _modelName);
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateSparseJacobian(true);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+        compiler.setObjectCacheEnabled(true);
+        compiler.setObjectCacheFolder(_cacheFolder);
+
+        DynamicModelLibraryProcessor<double> p(libSourceGen, libName);
+        std::unique_ptr<DynamicLib<double> > lib = p.createDynamicLibrary(compiler);
+        std::unique_ptr<GenericModel<double> > model = lib->model(_modelName);
+
+        dep.resize(model->Range());
+        model->ForwardZero(_x, dep);
+
+        hits = compiler.getObjectCacheHits();
+        misses = compiler.getObjectCacheMisses();
+    }
+
+    static void removeFolder(const std::string& folder) {
+        DIR* dir = opendir(folder.c_str());
+        if (dir == nullptr)
+            return;
+
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name != "." && name != "..") {
+                std::remove(system::createPath(folder, name).c_str());
+            }
+        }
+        closedir(dir);
+
+        std::remove(folder.c_str());
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGObjectCacheTest, ReuseObjectFiles) {
+    std::vector<double> dep;
+    size_t hits, misses;
+
+    // empty cache: everything is compiled
+    createLibrary("cppad_cg_object_cache_1", 1.0, dep, hits, misses);
+    ASSERT_EQ(hits, 0u);
+    ASSERT_GT(misses, 0u);
+    ASSERT_TRUE(nearEqual(dep[1], _x[1] * _x[2]));
+    const size_t nSources = misses;
+
+    // same model: nothing is compiled again
+    createLibrary("cppad_cg_object_cache_2", 1.0, dep, hits, misses);
+    ASSERT_EQ(hits, nSources);
+    ASSERT_EQ(misses, 0u);
+    ASSERT_TRUE(nearEqual(dep[1], _x[1] * _x[2]));
+
+    // changed model: only the zero order forward mode and the Jacobian are compiled again
+    createLibrary("cppad_cg_object_cache_3", 3.0, dep, hits, misses);
+    ASSERT_EQ(hits, nSources - 2);
+    ASSERT_EQ(misses, 2u);
+    ASSERT_TRUE(nearEqual(dep[0], _x[0] * std::sin(_x[1]) + _x[2]));
+    ASSERT_TRUE(nearEqual(dep[1], 3.0 * _x[1] * _x[2]));
+}
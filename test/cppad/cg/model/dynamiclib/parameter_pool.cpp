@@ -0,0 +1,110 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGModelTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A polynomial correlation with tabulated coefficients (several repeated
+ * values)
+ */
+template<class T>
+void parameterPoolModel(const std::vector<T>& x,
+                        std::vector<T>& y) {
+    for (size_t i = 0; i < y.size(); i++) {
+        double c0 = 1.0 / (3.0 + i % 5);
+        double c1 = -0.1 * (1 + i % 3);
+        double c2 = 2.5e-7 / 3.0;
+        y[i] = c0 + x[i % x.size()] * (c1 + x[(i + 1) % x.size()] * c2) + 2.0 * x[0];
+    }
+}
+
+class CppADCGParameterPoolTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    const std::vector<double> _x;
+    std::unique_ptr<ADFun<CGD> > _fun;
+public:
+
+    explicit CppADCGParameterPoolTest(bool verbose = false,
+                                      bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("parameter_pool"),
+            _x{1.0, 2.0, 0.5} {
+    }
+
+    void SetUp() override {
+        std::vector<ADCG> ax(_x.begin(), _x.end()), ay(20);
+        CppAD::Independent(ax);
+        parameterPoolModel(ax, ay);
+        _fun.reset(new ADFun<CGD>(ax, ay));
+    }
+
+    void TearDown() override {
+        _fun.reset();
+    }
+
+    void test(const std::string& libName,
+              size_t maxAssignPerFunc,
+              const std::string& zeroFile) {
+        ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateSparseJacobian(true);
+        modelSourceGen.setCreateSparseHessian(true);
+        modelSourceGen.setMaxAssignmentsPerFunc(maxAssignPerFunc);
+        modelSourceGen.setParameterPool(true);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+        std::string folder = "sources_" + libName;
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+        compiler.setSourcesFolder(folder);
+        compiler.setSaveToDiskFirst(true);
+
+        DynamicModelLibraryProcessor<double> p(libSourceGen, libName);
+        std::unique_ptr<DynamicLib<double> > lib = p.createDynamicLibrary(compiler);
+        std::unique_ptr<GenericModel<double> > model = lib->model(_modelName);
+        ASSERT_TRUE(model != nullptr);
+
+        // the constants must be declared only once in the static array
+        std::ifstream file(folder + "/" + zeroFile);
+        ASSERT_TRUE(file.is_open());
+        std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        ASSERT_NE(source.find("static const double cst["), std::string::npos);
+        ASSERT_NE(source.find("0x1.5555555555555p-2"), std::string::npos); // 1/3
+        ASSERT_EQ(source.find("0.333333"), std::string::npos);
+
+        testForwardZeroResults(*model, *_fun, nullptr, _x);
+        testSparseJacobianResults(1, *model, *_fun, nullptr, _x, false);
+        testSparseHessianResults(1, *model, *_fun, nullptr, _x, false);
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGParameterPoolTest, SingleFunction) {
+    test("cppad_cg_parameter_pool", 20000, _modelName + "_forward_zero.c");
+}
+
+TEST_F(CppADCGParameterPoolTest, LocalFunctions) {
+    test("cppad_cg_parameter_pool_local", 10, _modelName + "_forward_zero__1.c");
+}
@@ -0,0 +1,154 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGModelTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGReloadableTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    const std::vector<double> _x;
+public:
+
+    explicit CppADCGReloadableTest(bool verbose = false,
+                                   bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("reloadable"),
+            _x{1.0, 2.0, 0.5} {
+    }
+
+    /**
+     * Creates a library with a model whose dependents are multiplied by
+     * a factor (different versions of the same model).
+     */
+    std::unique_ptr<ModelLibrary<double> > createLibrary(const std::string& libName,
+                                                         double factor,
+                                                         size_t m = 2) {
+        std::vector<ADCG> ax(_x.size());
+        for (size_t j = 0; j < ax.size(); j++) {
+            ax[j] = _x[j];
+        }
+        CppAD::Independent(ax);
+
+        std::vector<ADCG> ay(m);
+        for (size_t i = 0; i < m; i++) {
+            ay[i] = factor * (ax[i % ax.size()] * sin(ax[2]) + ax[1]);
+        }
+
+        ADFun<CGD> fun;
+        fun.Dependent(ay);
+
+        ModelCSourceGen<double> modelSourceGen(fun, _modelName);
+        modelSourceGen.setCreateForwardZero(true);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+
+        // each version must have a different file name
+        DynamicModelLibraryProcessor<double> p(libSourceGen, libName);
+        return p.createDynamicLibrary(compiler);
+    }
+
+    std::vector<double> expected(double factor) const {
+        return {factor * (_x[0] * std::sin(_x[2]) + _x[1]),
+                factor * (_x[1] * std::sin(_x[2]) + _x[1])};
+    }
+
+    void testResults(GenericModel<double>& model,
+                     double factor) {
+        std::vector<double> dep(model.Range());
+        model.ForwardZero(_x, dep);
+        std::vector<double> depExpected = expected(factor);
+        ASSERT_EQ(dep.size(), depExpected.size());
+        for (size_t i = 0; i < dep.size(); i++) {
+            ASSERT_TRUE(nearEqual(dep[i], depExpected[i]));
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGReloadableTest, Reload) {
+    ReloadableGenericModel<double> model(createLibrary("cppad_cg_reloadable_v1", 1.0), _modelName);
+
+    ASSERT_EQ(model.getName(), _modelName);
+    ASSERT_EQ(model.Domain(), _x.size());
+    ASSERT_EQ(model.Range(), 2u);
+    testResults(model, 1.0);
+
+    model.reload(createLibrary("cppad_cg_reloadable_v2", 2.0));
+
+    ASSERT_EQ(model.getReloadCount(), 1u);
+    testResults(model, 2.0);
+}
+
+TEST_F(CppADCGReloadableTest, IncompatibleLibrary) {
+    ReloadableGenericModel<double> model(createLibrary("cppad_cg_reloadable_v1", 1.0), _modelName);
+
+    ASSERT_THROW(model.reload(createLibrary("cppad_cg_reloadable_v2", 2.0, 3)), CGException);
+
+    ASSERT_EQ(model.getReloadCount(), 0u);
+    testResults(model, 1.0);
+}
+
+TEST_F(CppADCGReloadableTest, ReloadDuringEvaluations) {
+    ReloadableGenericModel<double> model(createLibrary("cppad_cg_reloadable_v1", 1.0), _modelName);
+    std::unique_ptr<ModelLibrary<double> > v2 = createLibrary("cppad_cg_reloadable_v2", 2.0);
+
+    std::vector<double> v1Dep = expected(1.0);
+    std::vector<double> v2Dep = expected(2.0);
+
+    std::atomic<bool> stop(false);
+    std::atomic<bool> failed(false);
+    std::atomic<size_t> evaluations(0);
+
+    // only this thread evaluates the model
+    std::thread worker([&]() {
+        std::vector<double> dep(2);
+        while (!stop.load()) {
+            model.ForwardZero(_x, dep);
+            bool ok1 = nearEqual(dep[0], v1Dep[0]) && nearEqual(dep[1], v1Dep[1]);
+            bool ok2 = nearEqual(dep[0], v2Dep[0]) && nearEqual(dep[1], v2Dep[1]);
+            if (!ok1 && !ok2)
+                failed = true;
+            evaluations++;
+        }
+    });
+
+    while (evaluations.load() < 100) {
+        std::this_thread::yield();
+    }
+
+    model.reload(std::move(v2));
+
+    size_t after = evaluations.load();
+    while (evaluations.load() < after + 100) {
+        std::this_thread::yield();
+    }
+
+    stop = true;
+    worker.join();
+
+    ASSERT_FALSE(failed.load());
+    testResults(model, 2.0);
+}
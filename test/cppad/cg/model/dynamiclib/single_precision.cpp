@@ -0,0 +1,145 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGModelTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+template<class T>
+void singlePrecisionModel(const std::vector<T>& x,
+                          std::vector<T>& y) {
+    y[0] = exp(x[0]) * x[1] + 1.0 / 3.0;
+    y[1] = sin(x[1]) * pow(x[2], 2.5) - 0.1 * x[0];
+    y[2] = sqrt(x[0] * x[2]) + log(x[1]);
+}
+
+class CppADCGSinglePrecisionTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    const std::vector<double> _x;
+    std::unique_ptr<ADFun<CGD> > _fun;
+public:
+
+    explicit CppADCGSinglePrecisionTest(bool verbose = false,
+                                        bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("single_precision"),
+            _x{1.0, 2.0, 0.5} {
+    }
+
+    void SetUp() override {
+        std::vector<ADCG> ax(_x.begin(), _x.end()), ay(3);
+        CppAD::Independent(ax);
+        singlePrecisionModel(ax, ay);
+        _fun.reset(new ADFun<CGD>(ax, ay));
+    }
+
+    void TearDown() override {
+        _fun.reset();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGSinglePrecisionTest, JacobianAndHessian) {
+    ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+    modelSourceGen.setCreateForwardZero(true);
+    modelSourceGen.setCreateSparseJacobian(true);
+    modelSourceGen.setCreateSparseHessian(true);
+    modelSourceGen.setJacobianSinglePrecision(true);
+    modelSourceGen.setHessianSinglePrecision(true);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_single_precision");
+    std::unique_ptr<DynamicLib<double> > lib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double> > model = lib->model(_modelName);
+    ASSERT_TRUE(model != nullptr);
+
+    ASSERT_TRUE(model->isJacobianSinglePrecision());
+    ASSERT_TRUE(model->isHessianSinglePrecision());
+
+    // the residuals keep the double precision
+    testForwardZeroResults(*model, *_fun, nullptr, _x);
+    // the derivatives only have the accuracy of a float
+    testSparseJacobianResults(1, *model, *_fun, nullptr, _x, false, 1e-5, 1e-5);
+    testSparseHessianResults(1, *model, *_fun, nullptr, _x, false, 1e-5, 1e-5);
+}
+
+TEST_F(CppADCGSinglePrecisionTest, Disabled) {
+    ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+    modelSourceGen.setCreateForwardZero(true);
+    modelSourceGen.setCreateSparseJacobian(true);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_double_precision");
+    std::unique_ptr<DynamicLib<double> > lib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double> > model = lib->model(_modelName);
+    ASSERT_TRUE(model != nullptr);
+
+    ASSERT_FALSE(model->isJacobianSinglePrecision());
+    ASSERT_FALSE(model->isHessianSinglePrecision());
+
+    testSparseJacobianResults(1, *model, *_fun, nullptr, _x, false);
+}
+
+TEST_F(CppADCGSinglePrecisionTest, Loops) {
+    // equations with the same pattern
+    std::vector<double> x{1.0, 2.0, 0.5, 1.5};
+    std::vector<ADCG> ax(x.begin(), x.end()), ay(3);
+    CppAD::Independent(ax);
+    for (size_t i = 0; i < ay.size(); i++) {
+        ay[i] = exp(ax[i]) * ax[i + 1];
+    }
+    ADFun<CGD> fun(ax, ay);
+
+    ModelCSourceGen<double> modelSourceGen(fun, "single_precision_loops");
+    modelSourceGen.setCreateForwardZero(true);
+    modelSourceGen.setCreateSparseJacobian(true);
+    modelSourceGen.setCreateSparseHessian(true);
+    modelSourceGen.setJacobianSinglePrecision(true);
+    modelSourceGen.setHessianSinglePrecision(true);
+    modelSourceGen.setRelatedDependents(std::vector<std::set<size_t> >{std::set<size_t>{0, 1, 2}});
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_single_precision_loops");
+    std::unique_ptr<DynamicLib<double> > lib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double> > model = lib->model("single_precision_loops");
+    ASSERT_TRUE(model != nullptr);
+
+    // the functions generated for loops do not use single precision
+    ASSERT_FALSE(model->isJacobianSinglePrecision());
+    ASSERT_FALSE(model->isHessianSinglePrecision());
+
+    testForwardZeroResults(*model, fun, nullptr, x);
+    testSparseJacobianResults(1, *model, fun, nullptr, x, false);
+    testSparseHessianResults(1, *model, fun, nullptr, x, false);
+}
@@ -0,0 +1,136 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGModelTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+template<class T>
+void sparseHessianLowerModel(const std::vector<T>& x,
+                             std::vector<T>& y) {
+    y[0] = exp(x[0]) * x[1];
+    y[1] = x[2] * x[2] + sin(x[1]);
+    y[2] = x[0] * x[3];
+}
+
+class CppADCGSparseHessianLowerTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    const std::vector<double> _x;
+    const std::vector<double> _w;
+    std::unique_ptr<ADFun<CGD> > _fun;
+    std::vector<double> _denseHess;
+public:
+
+    explicit CppADCGSparseHessianLowerTest(bool verbose = false,
+                                           bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("sparse_hessian_lower"),
+            _x{1.0, 2.0, 0.5, 1.5},
+            _w{0.5, 1.5, 2.0} {
+    }
+
+    void SetUp() override {
+        std::vector<ADCG> ax(_x.begin(), _x.end()), ay(3);
+        CppAD::Independent(ax);
+        sparseHessianLowerModel(ax, ay);
+        _fun.reset(new ADFun<CGD>(ax, ay));
+
+        // reference values
+        std::vector<AD<double> > axd(_x.begin(), _x.end()), ayd(3);
+        CppAD::Independent(axd);
+        sparseHessianLowerModel(axd, ayd);
+        ADFun<double> fun(axd, ayd);
+        _denseHess = fun.Hessian(_x, _w);
+    }
+
+    void TearDown() override {
+        _fun.reset();
+    }
+
+    void testLower(ModelCSourceGen<double>& modelSourceGen,
+                   const std::string& libName,
+                   const std::vector<unsigned long>& rowPtr,
+                   const std::vector<unsigned long>& cols) {
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateSparseHessianLower(true);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+
+        DynamicModelLibraryProcessor<double> p(libSourceGen, libName);
+        std::unique_ptr<DynamicLib<double> > lib = p.createDynamicLibrary(compiler);
+        std::unique_ptr<GenericModel<double> > model = lib->model(_modelName);
+        ASSERT_TRUE(model != nullptr);
+        ASSERT_TRUE(model->isSparseHessianLowerAvailable());
+
+        auto* functorModel = dynamic_cast<FunctorGenericModel<double>*>(model.get());
+        ASSERT_TRUE(functorModel != nullptr);
+        CsrSparsityView layout = functorModel->HessianLowerSparsityCsr();
+        ASSERT_EQ(std::vector<unsigned long>(layout.rowPtr.begin(), layout.rowPtr.end()), rowPtr);
+        ASSERT_EQ(std::vector<unsigned long>(layout.cols.begin(), layout.cols.end()), cols);
+
+        size_t n = _x.size();
+        std::vector<double> hess(cols.size());
+        model->SparseHessianLower(_x, _w, hess);
+
+        for (size_t i = 0; i < n; i++) {
+            for (size_t e = rowPtr[i]; e < rowPtr[i + 1]; e++) {
+                ASSERT_NEAR(hess[e], _denseHess[i * n + cols[e]], 1e-10);
+            }
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGSparseHessianLowerTest, SparsityLayout) {
+    ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+
+    testLower(modelSourceGen, "cppad_cg_sparse_hessian_lower",
+              {0, 1, 3, 4, 5},
+              {0, 0, 1, 2, 0});
+}
+
+TEST_F(CppADCGSparseHessianLowerTest, CustomLayout) {
+    // contains elements which are not in the sparsity pattern: (2, 1) and (3, 3)
+    std::vector<size_t> rowPtr{0, 1, 3, 5, 7};
+    std::vector<size_t> cols{0, 0, 1, 1, 2, 0, 3};
+
+    ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+    modelSourceGen.setCustomSparseHessianLowerCsr(rowPtr, cols);
+
+    testLower(modelSourceGen, "cppad_cg_sparse_hessian_lower_custom",
+              std::vector<unsigned long>(rowPtr.begin(), rowPtr.end()),
+              std::vector<unsigned long>(cols.begin(), cols.end()));
+}
+
+TEST_F(CppADCGSparseHessianLowerTest, InvalidLayout) {
+    ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+
+    // upper triangle element
+    ASSERT_THROW(modelSourceGen.setCustomSparseHessianLowerCsr({0, 1, 2, 3, 4}, {0, 2, 2, 3}), CGException);
+    // unsorted columns
+    ASSERT_THROW(modelSourceGen.setCustomSparseHessianLowerCsr({0, 1, 3, 4, 5}, {0, 1, 0, 2, 3}), CGException);
+    // wrong number of rows
+    ASSERT_THROW(modelSourceGen.setCustomSparseHessianLowerCsr({0, 1, 2}, {0, 1}), CGException);
+}
@@ -0,0 +1,140 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGModelTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+class CppADCGSparsityViewTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    const std::vector<double> _x;
+    std::unique_ptr<ADFun<CGD> > _fun;
+public:
+
+    explicit CppADCGSparsityViewTest(bool verbose = false,
+                                     bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("sparsity_view"),
+            _x{1.0, 2.0, 0.5, 1.5} {
+    }
+
+    void SetUp() override {
+        std::vector<ADCG> ax(_x.begin(), _x.end());
+        CppAD::Independent(ax);
+
+        std::vector<ADCG> ay(3);
+        ay[0] = ax[3] * ax[2] + sin(ax[0]);
+        ay[1] = exp(ax[1]);
+        ay[2] = ax[3] * ax[0] * ax[1];
+
+        _fun.reset(new ADFun<CGD>());
+        _fun->Dependent(ay);
+    }
+
+    void TearDown() override {
+        _fun.reset();
+    }
+};
+
+TEST_F(CppADCGSparsityViewTest, Views) {
+    ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+    modelSourceGen.setCreateForwardZero(true);
+    modelSourceGen.setCreateSparseJacobian(true);
+    modelSourceGen.setCreateSparseHessian(true);
+    modelSourceGen.setCustomSparseJacobianElements(std::vector<size_t>{2, 0, 1, 0, 2, 0},
+                                                   std::vector<size_t>{3, 3, 1, 0, 0, 2}); // unsorted
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_sparsity_view");
+    std::unique_ptr<DynamicLib<double> > lib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double> > model = lib->model(_modelName);
+    auto* fmodel = dynamic_cast<FunctorGenericModel<double>*>(model.get());
+    ASSERT_TRUE(fmodel != nullptr);
+
+    /**
+     * Jacobian
+     */
+    std::vector<size_t> rows, cols;
+    fmodel->JacobianSparsity(rows, cols);
+
+    CooSparsityView jacCoo = fmodel->JacobianSparsityCoo();
+    ASSERT_EQ(jacCoo.nnz(), rows.size());
+    for (size_t e = 0; e < rows.size(); e++) {
+        ASSERT_EQ(jacCoo.rows[e], rows[e]);
+        ASSERT_EQ(jacCoo.cols[e], cols[e]);
+    }
+
+    CsrSparsityView jacCsr = fmodel->JacobianSparsityCsr();
+    ASSERT_EQ(jacCsr.nRows(), _fun->Range());
+    ASSERT_EQ(jacCsr.nnz(), rows.size());
+    for (size_t i = 0; i < jacCsr.nRows(); i++) {
+        for (size_t e = jacCsr.rowPtr[i]; e < jacCsr.rowPtr[i + 1]; e++) {
+            if (e > jacCsr.rowPtr[i]) {
+                ASSERT_LT(jacCsr.cols[e - 1], jacCsr.cols[e]);
+            }
+            size_t pos = jacCsr.elements[e];
+            ASSERT_EQ(rows[pos], i);
+            ASSERT_EQ(cols[pos], jacCsr.cols[e]);
+        }
+    }
+
+    /**
+     * Hessian
+     */
+    fmodel->HessianSparsity(rows, cols);
+
+    CooSparsityView hessCoo = fmodel->HessianSparsityCoo();
+    ASSERT_EQ(hessCoo.nnz(), rows.size());
+    for (size_t e = 0; e < rows.size(); e++) {
+        ASSERT_EQ(hessCoo.rows[e], rows[e]);
+        ASSERT_EQ(hessCoo.cols[e], cols[e]);
+    }
+
+    CsrSparsityView hessCsr = fmodel->HessianSparsityCsr();
+    ASSERT_EQ(hessCsr.nRows(), _fun->Domain());
+    ASSERT_EQ(hessCsr.nnz(), rows.size());
+    for (size_t i = 0; i < hessCsr.nRows(); i++) {
+        for (size_t e = hessCsr.rowPtr[i]; e < hessCsr.rowPtr[i + 1]; e++) {
+            size_t pos = hessCsr.elements[e];
+            ASSERT_EQ(rows[pos], i);
+            ASSERT_EQ(cols[pos], hessCsr.cols[e]);
+        }
+    }
+
+    /**
+     * variable dependencies in the zero order forward mode
+     */
+    CppAD::vector<bool> vx(_x.size()), vy(_fun->Range());
+    std::vector<double> y(_fun->Range());
+    for (size_t j = 0; j < _x.size(); j++) {
+        for (size_t k = 0; k < vx.size(); k++)
+            vx[k] = (k == j);
+        for (size_t i = 0; i < vy.size(); i++)
+            vy[i] = false;
+
+        model->ForwardZero(vx, vy, ArrayView<const double>(_x), ArrayView<double>(y));
+
+        std::vector<std::set<size_t> > sparsity = model->JacobianSparsitySet();
+        for (size_t i = 0; i < vy.size(); i++) {
+            ASSERT_EQ(vy[i], sparsity[i].find(j) != sparsity[i].end());
+        }
+    }
+}
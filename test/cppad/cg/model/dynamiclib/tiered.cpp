@@ -0,0 +1,139 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGModelTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGTieredTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    std::vector<double> _xTape;
+    std::vector<double> _xRun;
+    std::unique_ptr<ADFun<CGD> > _fun;
+    std::vector<double> _depExpected;
+public:
+
+    explicit CppADCGTieredTest(bool verbose = false,
+                               bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("tiered"),
+            _xTape{1.0, 2.0, 0.5},
+            _xRun{1.5, 0.5, 2.0} {
+    }
+
+    void SetUp() override {
+        std::vector<ADCG> ax(_xTape.size());
+        for (size_t j = 0; j < ax.size(); j++) {
+            ax[j] = _xTape[j];
+        }
+        CppAD::Independent(ax);
+
+        std::vector<ADCG> ay(3);
+        ay[0] = ax[0] * sin(ax[1]) + pow(ax[2], 2.5);
+        ay[1] = CondExpGt(ax[0], ax[1], exp(ax[0]) * ax[2], log(ax[1]));
+        ay[2] = -ax[0] / (1.0 + ax[2] * ax[2]);
+
+        _fun.reset(new ADFun<CGD>());
+        _fun->Dependent(ay);
+
+        // CppAD is not used in the main thread while the library is created
+        std::vector<CGD> x(_xRun.begin(), _xRun.end());
+        std::vector<CGD> y = _fun->Forward(0, x);
+        _depExpected.resize(y.size());
+        for (size_t i = 0; i < y.size(); i++) {
+            _depExpected[i] = y[i].getValue();
+        }
+    }
+
+    void TearDown() override {
+        _fun.reset();
+    }
+
+    std::unique_ptr<GenericModel<double> > createLowerTier() {
+        ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateSparseJacobian(true);
+
+        return std::unique_ptr<GenericModel<double> >(new BytecodeGenericModel<double>(modelSourceGen));
+    }
+
+    std::unique_ptr<ModelLibrary<double> > createUpperTier() {
+        ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateSparseJacobian(true);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+
+        DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_tiered");
+        return p.createDynamicLibrary(compiler);
+    }
+
+    void testResults(GenericModel<double>& model) {
+        std::vector<double> dep(_depExpected.size());
+        model.ForwardZero(_xRun, dep);
+        for (size_t i = 0; i < dep.size(); i++) {
+            ASSERT_TRUE(nearEqual(dep[i], _depExpected[i]));
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGTieredTest, SwitchToUpperTier) {
+    TieredGenericModel<double> model(createLowerTier(),
+                                     [this]() { return createUpperTier(); },
+                                     _xTape);
+
+    ASSERT_EQ(model.getName(), _modelName);
+    ASSERT_EQ(model.Domain(), _fun->Domain());
+    ASSERT_EQ(model.Range(), _fun->Range());
+
+    // evaluations are possible while the library is compiled
+    testResults(model);
+
+    model.waitForUpperTier();
+
+    ASSERT_FALSE(model.isUpperTierFailed()) << model.getUpperTierError();
+    ASSERT_TRUE(model.isUpperTierActive());
+
+    testResults(model);
+    ASSERT_TRUE(model.isSparseJacobianAvailable());
+    ASSERT_FALSE(model.isSparseHessianAvailable());
+}
+
+TEST_F(CppADCGTieredTest, UpperTierFailure) {
+    TieredGenericModel<double> model(createLowerTier(),
+                                     []() -> std::unique_ptr<ModelLibrary<double> > {
+                                         throw CGException("compilation failed");
+                                     },
+                                     _xTape);
+
+    model.waitForUpperTier();
+
+    ASSERT_TRUE(model.isUpperTierFailed());
+    ASSERT_FALSE(model.isUpperTierActive());
+    ASSERT_FALSE(model.getUpperTierError().empty());
+
+    testResults(model);
+}
@@ -0,0 +1,113 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <cppad/cg/cppadcg.hpp>
+#include <cppad/cg/model/llvm/llvm.hpp>
+
+#include "CppADCGModelTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class LlvmIrModelTest : public CppADCGModelTest {
+protected:
+    const std::string _modelName;
+    std::vector<double> _xTape;
+    std::vector<double> _xRun;
+    std::unique_ptr<ADFun<CGD> > _fun;
+    std::unique_ptr<LlvmIrModelLibrary<double> > _lib;
+    std::unique_ptr<GenericModel<double> > _model;
+public:
+
+    explicit LlvmIrModelTest(bool verbose = false,
+                             bool printValues = false) :
+            CppADCGModelTest(verbose, printValues),
+            _modelName("llvm_ir"),
+            _xTape{1.0, 2.0, 0.5},
+            _xRun{1.5, 0.5, 2.0} {
+    }
+
+    void SetUp() override {
+        std::vector<ADCG> ax(_xTape.size());
+        for (size_t j = 0; j < ax.size(); j++) {
+            ax[j] = _xTape[j];
+        }
+        CppAD::Independent(ax);
+
+        std::vector<ADCG> ay(6);
+        ay[0] = ax[0] * sin(ax[1]) + pow(ax[2], 2.5);
+        ay[1] = CondExpGt(ax[0], ax[1], exp(ax[0]) * ax[2], log(ax[1]));
+        ay[2] = ax[1]; // same as an independent variable
+        ay[3] = 3.0; // constant
+        ay[4] = -ax[0] / (1.0 + ax[2] * ax[2]) + sqrt(ax[1]) * ax[0];
+        ay[5] = atan(ax[0]) * tanh(ax[2]) + abs(ax[1] - ax[2]) + CppAD::sign(ax[0]) * cosh(ax[1]);
+
+        _fun.reset(new ADFun<CGD>());
+        _fun->Dependent(ay);
+
+        ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateSparseJacobian(true);
+        modelSourceGen.setCreateSparseHessian(true);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+        _lib.reset(new LlvmIrModelLibrary<double>(libSourceGen));
+        _model = _lib->model(_modelName);
+    }
+
+    void TearDown() override {
+        _model.reset();
+        _lib.reset();
+        _fun.reset();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(LlvmIrModelTest, ForwardZero) {
+    ASSERT_TRUE(_model != nullptr);
+    ASSERT_TRUE(_model->isForwardZeroAvailable());
+    ASSERT_EQ(_model->getName(), _modelName);
+    ASSERT_EQ(_lib->getModelNames().count(_modelName), 1u);
+
+    testForwardZeroResults(*_model, *_fun, nullptr, _xRun);
+    testForwardZeroResults(*_model, *_fun, nullptr, _xTape);
+}
+
+TEST_F(LlvmIrModelTest, SparseJacobian) {
+    ASSERT_TRUE(_model->isSparseJacobianAvailable());
+
+    testSparseJacobianResults(2, *_model, *_fun, nullptr, _xRun, false);
+}
+
+TEST_F(LlvmIrModelTest, SparseHessian) {
+    ASSERT_TRUE(_model->isSparseHessianAvailable());
+
+    testSparseHessianResults(2, *_model, *_fun, nullptr, _xRun, false);
+}
+
+TEST_F(LlvmIrModelTest, NoCSource) {
+    // the functions are created directly in the LLVM module
+    const llvm::Module& module = _lib->getModule();
+    ASSERT_TRUE(module.getFunction(_modelName + "_forward_zero") != nullptr);
+    ASSERT_TRUE(module.getFunction(_modelName + "_sparse_jacobian") != nullptr);
+    ASSERT_TRUE(module.getFunction(_modelName + "_sparse_hessian") != nullptr);
+
+    ASSERT_TRUE(_lib->model("unknown") == nullptr);
+}
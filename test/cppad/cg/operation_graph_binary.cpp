@@ -0,0 +1,202 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGOperationGraphBinaryTest : public CppADCGTest {
+protected:
+    using CGD = CppADCGTest::CGD;
+    using ADCGD = CppADCGTest::ADCGD;
+protected:
+    std::vector<double> _x;
+    std::unique_ptr<ADFun<CGD> > _fun;
+    CodeHandler<double> _handler;
+    std::vector<CGD> _indep;
+    std::vector<CGD> _dep;
+public:
+
+    inline CppADCGOperationGraphBinaryTest(bool verbose = false,
+                                           bool printValues = false) :
+        CppADCGTest(verbose, printValues),
+        _x{1.0, 2.0, 0.5} {
+    }
+
+    void SetUp() override {
+        std::vector<ADCGD> ax(_x.size());
+        for (size_t j = 0; j < ax.size(); j++) {
+            ax[j] = _x[j];
+        }
+        CppAD::Independent(ax);
+
+        std::vector<ADCGD> ay(4);
+        ay[0] = ax[0] * sin(ax[1]) + pow(ax[2], 2.5);
+        ay[1] = CondExpGt(ax[0], ax[1], exp(ax[0]) * ax[2], log(ax[1]));
+        ay[2] = 3.0; // constant
+        ay[3] = -ax[0] / (1.0 + ax[2] * ax[2]);
+
+        _fun.reset(new ADFun<CGD>());
+        _fun->Dependent(ay);
+
+        _indep.resize(_x.size());
+        _handler.makeVariables(_indep);
+        _dep = _fun->Forward(0, _indep);
+    }
+
+    void TearDown() override {
+        _fun.reset();
+    }
+
+    static std::string toString(const OperationGraphBinary<double>& graph) {
+        std::ostringstream out;
+        graph.write(out);
+        return out.str();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGOperationGraphBinaryTest, RoundTrip) {
+    OperationGraphBinary<double> graph(_handler, _dep);
+
+    ASSERT_EQ(graph.getIndependentCount(), _x.size());
+    ASSERT_EQ(graph.getDependentCount(), _dep.size());
+
+    std::string data = toString(graph);
+    std::istringstream in(data);
+    std::unique_ptr<OperationGraphBinary<double> > graph2 = OperationGraphBinary<double>::read(in);
+
+    CodeHandler<double> handler2;
+    std::vector<CGD> indep2;
+    std::vector<CGD> dep2 = graph2->load(handler2, indep2);
+
+    ASSERT_EQ(indep2.size(), _x.size());
+    ASSERT_EQ(dep2.size(), _dep.size());
+    ASSERT_TRUE(dep2[2].isParameter());
+    ASSERT_EQ(dep2[2].getValue(), 3.0);
+
+    // saving the loaded graph must produce the same data
+    OperationGraphBinary<double> graph3(handler2, dep2);
+    ASSERT_EQ(toString(graph3), data);
+}
+
+TEST_F(CppADCGOperationGraphBinaryTest, InvalidStreamSize) {
+    using Header = OperationGraphBinary<double>::Header;
+
+    OperationGraphBinary<double> graph(_handler, _dep);
+    std::string data = toString(graph);
+
+    // truncated data
+    std::istringstream truncated(data.substr(0, data.size() - 8));
+    ASSERT_THROW(OperationGraphBinary<double>::read(truncated), CGException);
+
+    // a size in the header which is much larger than the data (must not be allocated)
+    uint64_t totalSize = uint64_t(1) << 60;
+    std::memcpy(&data[offsetof(Header, totalSize)], &totalSize, sizeof(totalSize));
+    std::istringstream huge(data);
+    ASSERT_THROW(OperationGraphBinary<double>::read(huge), CGException);
+}
+
+TEST_F(CppADCGOperationGraphBinaryTest, ExternalData) {
+    OperationGraphBinary<double> graph(_handler, _dep);
+
+    // the data is used directly (e.g. from a memory mapped file)
+    std::vector<uint64_t> mem(graph.size() / 8);
+    std::memcpy(mem.data(), graph.data(), graph.size());
+
+    OperationGraphBinary<double> view(mem.data(), graph.size());
+    ASSERT_EQ(view.getNodeCount(), graph.getNodeCount());
+    ASSERT_EQ(view.getNodes().data(), reinterpret_cast<const OperationGraphBinary<double>::NodeEntry*>(reinterpret_cast<const char*>(mem.data()) + view.getHeader().nodesOffset));
+
+    // invalid data
+    mem[0] = 0;
+    ASSERT_THROW(OperationGraphBinary<double>(mem.data(), graph.size()), CGException);
+}
+
+TEST_F(CppADCGOperationGraphBinaryTest, CreateADFun) {
+    OperationGraphBinary<double> graph(_handler, _dep);
+
+    std::unique_ptr<ADFun<CGD> > fun2 = graph.createADFun();
+
+    ASSERT_EQ(fun2->Domain(), _fun->Domain());
+    ASSERT_EQ(fun2->Range(), _fun->Range());
+
+    for (const std::vector<double>& xv : {_x, std::vector<double>{2.5, 0.5, 1.5}}) {
+        std::vector<CGD> x(xv.begin(), xv.end());
+        std::vector<CGD> y = _fun->Forward(0, x);
+        std::vector<CGD> y2 = fun2->Forward(0, x);
+
+        ASSERT_TRUE(compareValues(ArrayView<const CGD>(y2), ArrayView<const CGD>(y)));
+    }
+}
+
+TEST_F(CppADCGOperationGraphBinaryTest, CorruptedNodes) {
+    using NodeEntry = OperationGraphBinary<double>::NodeEntry;
+
+    OperationGraphBinary<double> graph(_handler, _dep);
+    const size_t last = graph.getNodeCount() - 1;
+
+    auto load = [&](const std::function<void(NodeEntry&)>& corrupt) {
+        std::vector<uint64_t> mem(graph.size() / 8);
+        std::memcpy(mem.data(), graph.data(), graph.size());
+        auto* nodes = reinterpret_cast<NodeEntry*>(reinterpret_cast<char*>(mem.data()) + graph.getHeader().nodesOffset);
+        corrupt(nodes[last]);
+
+        OperationGraphBinary<double> view(mem.data(), graph.size());
+        CodeHandler<double> handler2;
+        std::vector<CGD> indep2;
+        view.load(handler2, indep2);
+    };
+
+    // the unchanged data is valid
+    ASSERT_NO_THROW(load([](NodeEntry&) {}));
+
+    // independent variable after the other operations
+    ASSERT_THROW(load([](NodeEntry& e) {
+        e.op = uint32_t(CGOpCode::Inv);
+        e.nArguments = 0;
+    }), CGException);
+
+    // operations which are only created during source code generation
+    for (CGOpCode op : {CGOpCode::Pri, CGOpCode::LoopStart, CGOpCode::LoopIndexedIndep, CGOpCode::Index,
+                        CGOpCode::IndexAssign, CGOpCode::TmpDcl, CGOpCode::Tmp}) {
+        ASSERT_THROW(load([op](NodeEntry& e) { e.op = uint32_t(op); }), CGException);
+    }
+
+    // unknown operation
+    ASSERT_THROW(load([](NodeEntry& e) { e.op = uint32_t(CGOpCode::NumberOp); }), CGException);
+
+    // argument range which overflows
+    ASSERT_THROW(load([](NodeEntry& e) {
+        e.argumentsStart = (std::numeric_limits<uint64_t>::max)();
+    }), CGException);
+
+    // information range which overflows
+    ASSERT_THROW(load([](NodeEntry& e) {
+        e.nInfo = 1;
+        e.infoStart = (std::numeric_limits<uint64_t>::max)();
+    }), CGException);
+
+    // atomic function which is not in the atomic function table
+    ASSERT_THROW(load([](NodeEntry& e) {
+        e.op = uint32_t(CGOpCode::AtomicForward);
+        e.nInfo = 0;
+    }), CGException);
+}
@@ -32,6 +32,7 @@ protected:
     bool testZeroOrder_;
     bool testJacobian_;
     bool testHessian_;
+    bool testLoopOpenMP_;
     std::vector<Base> xNorm_;
     std::vector<Base> eqNorm_;
     std::vector<atomic_base<Base>*> atoms_;
@@ -51,6 +52,7 @@ public:
         testZeroOrder_(true),
         testJacobian_(true),
         testHessian_(true),
+        testLoopOpenMP_(false),
         epsilonA_(std::numeric_limits<Base>::epsilon() * 1e2),
         epsilonR_(std::numeric_limits<Base>::epsilon() * 1e2),
         hessianEpsilonA_(std::numeric_limits<Base>::epsilon() * 1e2),
@@ -395,8 +397,12 @@ public:
         compHelpL.setCreateReverseTwo(reverseTwo);
         //compHelpL.setMaxAssignmentsPerFunc(maxAssignPerFunc);
         compHelpL.setRelatedDependents(relatedDepCandidates);
+        // without candidates the related dependents are determined by the source generator
+        compHelpL.setAutomaticRelatedDependents(relatedDepCandidates.empty());
         compHelpL.setTypicalIndependentValues(xTypical);
         compHelpL.setParameterPrecision(std::numeric_limits<Base>::digits10 + 4);
+        compHelpL.setLoopSimd(testLoopOpenMP_);
+        compHelpL.setLoopParallelFor(testLoopOpenMP_);
 
         if (!customJacSparsity_.empty())
             compHelpL.setCustomSparseJacobianElements(customJacSparsity_);
@@ -406,6 +412,11 @@ public:
 
         GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
         prepareTestCompilerFlags(compiler);
+        if (testLoopOpenMP_) {
+            compiler.addCompileFlag("-fopenmp");
+            compiler.addCompileFlag("-pthread");
+            compiler.addCompileLibFlag("-fopenmp");
+        }
         compiler.setSourcesFolder("sources_" + libBaseName);
         compiler.setSaveToDiskFirst(true);
 
@@ -415,7 +426,32 @@ public:
         //SaveFilesModelLibraryProcessor<double>::saveLibrarySourcesTo(compDynHelpL, "sources_" + libBaseName);
 
         DynamicModelLibraryProcessor<double> p(compDynHelpL, libBaseName + "Loops");
+#ifdef CPPAD_CG_SYSTEM_LINUX
+        if (testLoopOpenMP_) {
+            // this is required because the OpenMP implementation in GCC causes a segmentation fault on dlclose
+            p.getOptions()["dlOpenMode"] = std::to_string(RTLD_NOW | RTLD_NODELETE);
+        }
+#endif
         std::unique_ptr<DynamicLib<double> > dynamicLibL = p.createDynamicLibrary(compiler);
+        ASSERT_FALSE(compHelpL.getRelatedDependents().empty());
+
+        if (testLoopOpenMP_) {
+            // loops with temporary variables must be parallelized with a private copy of the temporaries
+            bool parallelFirstPrivate = false;
+            const auto& sources = compHelpL.getSources(compDynHelpL.getMultiThreading(), nullptr);
+            for (const auto& it : sources) {
+                std::istringstream is(it.second);
+                std::string line;
+                while (std::getline(is, line)) {
+                    if (line.find("#pragma omp parallel for") != std::string::npos &&
+                        line.find("firstprivate(") != std::string::npos) {
+                        parallelFirstPrivate = true;
+                    }
+                }
+            }
+            ASSERT_TRUE(parallelFirstPrivate);
+        }
+
         std::unique_ptr<GenericModel<double> > modelL;
         if (loadModels) {
             modelL = dynamicLibL->model(libBaseName + "Loops");
@@ -452,6 +488,12 @@ public:
         SaveFilesModelLibraryProcessor<double>::saveLibrarySourcesTo(compDynHelp, "sources_" + libBaseName);
 
         DynamicModelLibraryProcessor<double> p2(compDynHelp, libBaseName + "NoLoops");
+#ifdef CPPAD_CG_SYSTEM_LINUX
+        if (testLoopOpenMP_) {
+            // also linked with the OpenMP runtime
+            p2.getOptions()["dlOpenMode"] = std::to_string(RTLD_NOW | RTLD_NODELETE);
+        }
+#endif
         std::unique_ptr<DynamicLib<double> > dynamicLib = p2.createDynamicLibrary(compiler);
 
         /**
@@ -579,4 +579,113 @@ TEST_F(CppADCGPatternTest, modelWrongEqs) {
     setModel(modelWrongEqs);
     testPatternDetection(m, n, repeat, loops);
     testLibCreation("modelWrongEqs", m, n, repeat);
-}
\ No newline at end of file
+}
+/**
+ * @test Equations with the same number of operations but with a different
+ *       structure in alternating iterations
+ */
+std::vector<ADCGD> modelSameSize(const std::vector<ADCGD>& x, size_t repeat) {
+    size_t m = 2;
+    size_t n = 2;
+    size_t m2 = repeat * m;
+
+    // dependent variable vector
+    std::vector<ADCGD> y(m2);
+
+    for (size_t i = 0; i < repeat; i++) {
+        if (i % 2 == 0) {
+            y[i * m] = x[i * n] * x[i * n + 1] + sin(x[i * n]);
+        } else {
+            y[i * m] = sin(x[i * n] * x[i * n + 1]) + x[i * n];
+        }
+        y[i * m + 1] = x[i * n + 1] * x[i * n];
+    }
+
+    return y;
+}
+
+/**
+ * A pattern matcher where all the dependents have the same fingerprint
+ * (all of them are fully compared)
+ */
+class CollidingFingerprintMatcher : public DependentPatternMatcher<double> {
+public:
+    CollidingFingerprintMatcher(const std::vector<std::set<size_t> >& relatedDepCandidates,
+                                const std::vector<CGD>& dependents,
+                                const std::vector<CGD>& independents) :
+        DependentPatternMatcher<double>(relatedDepCandidates, dependents, independents) {
+    }
+
+protected:
+    size_t fingerprint(const CGD&) override {
+        return 0;
+    }
+};
+
+/**
+ * Determines the dependents of each equation pattern and of each loop
+ * detected by a pattern matcher
+ */
+template<class Matcher>
+void findPatterns(ADFun<CGD>& fun,
+                  const std::vector<std::set<size_t> >& depCandidates,
+                  std::set<std::set<size_t> >& equations,
+                  std::set<std::set<std::set<size_t> > >& loops) {
+    CodeHandler<double> h;
+    size_t n2 = fun.Domain();
+
+    std::vector<CGD> xx(n2);
+    h.makeVariables(xx);
+    for (size_t j = 0; j < n2; j++) {
+        xx[j].setValue(j);
+    }
+
+    std::vector<CGD> yy = fun.Forward(0, xx);
+
+    Matcher matcher(depCandidates, yy, xx);
+
+    LoopFreeModel<Base>* nonLoopTape;
+    SmartSetPointer<LoopModel<Base> > loopTapes;
+    matcher.generateTapes(nonLoopTape, loopTapes.s);
+    delete nonLoopTape;
+
+    for (auto eq : matcher.getEquationPatterns()) {
+        equations.insert(eq->dependents);
+    }
+
+    for (auto loop : matcher.getLoops()) {
+        std::set<std::set<size_t> > loopEqs;
+        for (auto eq : loop->equations) {
+            loopEqs.insert(eq->dependents);
+        }
+        loops.insert(loopEqs);
+    }
+}
+
+TEST_F(CppADCGPatternTest, FingerprintCollision) {
+    size_t m = 2;
+    size_t n = 2;
+    size_t repeat = 6;
+
+    setModel(modelSameSize);
+
+    std::vector<Base> xb(n * repeat, 0.5);
+    std::unique_ptr<ADFun<CGD> > fun(tapeModel(repeat, xb));
+    std::vector<std::set<size_t> > depCandidates = createRelatedDepCandidates(m, repeat);
+
+    std::set<std::set<size_t> > equations, collidingEquations;
+    std::set<std::set<std::set<size_t> > > loops, collidingLoops;
+    findPatterns<DependentPatternMatcher<double> >(*fun, depCandidates, equations, loops);
+    findPatterns<CollidingFingerprintMatcher>(*fun, depCandidates, collidingEquations, collidingLoops);
+
+    // the structurally different equations are not merged
+    ASSERT_EQ(equations.count(std::set<size_t>{0, 4, 8}), 1u);
+    ASSERT_EQ(equations.count(std::set<size_t>{2, 6, 10}), 1u);
+    ASSERT_EQ(equations.count(std::set<size_t>{1, 3, 5, 7, 9, 11}), 1u);
+
+    // the fingerprints only avoid comparisons
+    ASSERT_EQ(equations, collidingEquations);
+    ASSERT_EQ(loops, collidingLoops);
+
+    testLibCreation("modelSameSize", m, n, repeat);
+}
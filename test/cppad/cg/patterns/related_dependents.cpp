@@ -0,0 +1,117 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGPatternTest.hpp"
+
+using Base = double;
+using CGD = CppAD::cg::CG<Base>;
+using ADCGD = CppAD::AD<CGD>;
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+/**
+ * Two equations per iteration with different independent variables, plus
+ * an equation which does not follow any pattern
+ */
+std::vector<ADCGD> modelRelated(const std::vector<ADCGD>& x, size_t repeat) {
+    size_t m = 2;
+    size_t n = 2;
+
+    std::vector<ADCGD> y(repeat * m + 1);
+
+    for (size_t i = 0; i < repeat; i++) {
+        y[i * m] = cos(x[i * n]) * 2.0;
+        y[i * m + 1] = x[(repeat - i - 1) * n + 1] * x[i * n];
+    }
+    y[repeat * m] = exp(x[0]) + x[1];
+
+    return y;
+}
+
+std::vector<std::set<size_t> > findRelated(ADFun<CGD>& fun) {
+    CodeHandler<double> handler;
+    std::vector<CGD> x(fun.Domain());
+    handler.makeVariables(x);
+
+    std::vector<CGD> y = fun.Forward(0, x);
+
+    RelatedDependentFinder<double> finder;
+    return finder.find(y);
+}
+
+} // END namespace
+
+TEST_F(CppADCGPatternTest, RelatedDependentsFinder) {
+    size_t repeat = 6;
+    setModel(modelRelated);
+
+    std::unique_ptr<ADFun<CGD> > fun(tapeModel(repeat, std::vector<Base>(2 * repeat, 0.5)));
+
+    std::vector<std::set<size_t> > related = findRelated(*fun);
+    std::vector<std::set<size_t> > expected = createRelatedDepCandidates(2, repeat);
+
+    ASSERT_EQ(related, expected);
+}
+
+TEST_F(CppADCGPatternTest, RelatedDependentsFinderLoops) {
+    size_t repeat = 6;
+    setModel(modelRelated);
+
+    std::vector<Base> xb(2 * repeat, 0.5);
+    std::unique_ptr<ADFun<CGD> > fun(tapeModel(repeat, xb));
+
+    std::vector<std::set<size_t> > related = findRelated(*fun);
+
+    // the automatically determined groups are used by the pattern matcher
+    testPatternDetectionResults(*fun, repeat, related, std::vector<std::vector<std::set<size_t> > >(1));
+}
+
+TEST_F(CppADCGPatternTest, RelatedDependentsFinderSharedOperations) {
+    CodeHandler<double> handler;
+    std::vector<CGD> x(4);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y(2);
+    for (size_t i = 0; i < y.size(); i++) {
+        CGD a = x[2 * i] + x[2 * i + 1];
+        y[i] = a * a;
+    }
+
+    RelatedDependentFinder<double> finder;
+    finder.setMinimumOperations(2);
+    ASSERT_EQ(finder.find(y).size(), 1u);
+
+    // the shared sub-expression is only counted once
+    finder.setMinimumOperations(3);
+    ASSERT_TRUE(finder.find(y).empty());
+}
+
+TEST_F(CppADCGPatternTest, AutomaticRelatedDependents) {
+    size_t repeat = 6;
+    setModel(modelRelated);
+
+    std::vector<Base> xb(2 * repeat);
+    for (size_t j = 0; j < xb.size(); j++)
+        xb[j] = 0.5 * (j + 1);
+
+    std::unique_ptr<ADFun<CGD> > fun(tapeModel(repeat, xb));
+
+    // no related dependents: they are determined while generating the source code
+    std::vector<std::set<size_t> > relatedDepCandidates;
+    testSourceCodeGen(*fun, relatedDepCandidates, "modelRelatedAuto", xb, JacobianADMode::Forward, true, true);
+    testSourceCodeGen(*fun, relatedDepCandidates, "modelRelatedAuto", xb, JacobianADMode::Reverse, true, false);
+}
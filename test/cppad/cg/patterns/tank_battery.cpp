@@ -83,4 +83,21 @@ TEST_F(CppADCGPatternTankBatTest, tankBattery) {
      * test
      */
     this->test(6);
-}
\ No newline at end of file
+}
+
+#ifdef CPPAD_CG_TEST_OPENMP
+/**
+ * @test test the usage of loops for the generation of the tank battery model
+ *       with OpenMP directives in loops with independent iterations
+ */
+TEST_F(CppADCGPatternTankBatTest, tankBatteryOpenMP) {
+    modelName += "OpenMP";
+
+    testLoopOpenMP_ = true;
+
+    /**
+     * test
+     */
+    this->test(6);
+}
+#endif